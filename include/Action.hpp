@@ -22,13 +22,20 @@ namespace euchre::action {
         return (1ULL << action.v);
     }
 
+    /**
+     * @brief Whether an action is in a mask. Ids past the mask's width are never in it.
+     */
+    constexpr bool in_mask(ActionId action, ActionMask mask) {
+        return action.v < 64 && (a2m(action) & mask) != 0;
+    }
+
     template <typename... Args>
         requires(std::same_as<Args, ActionId> && ...)
     constexpr ActionMask make_mask(Args... actions) {
         return (a2m(actions) | ...);
     }
 
-    static inline constexpr uint16_t num_actions = 56;
+    static inline constexpr uint16_t num_actions = 62;
     static inline constexpr ActionId PlayCardBase {0}; // 0 - 23
     static inline constexpr ActionId PlayCardEnd {23}; 
 
@@ -40,18 +47,64 @@ namespace euchre::action {
     static inline constexpr ActionId CallTrumpEnd {53};
     static inline constexpr ActionId GoAloneYes {54};
     static inline constexpr ActionId GoAloneNo {55};
-    static inline constexpr ActionId InvalidAction {56};
-    
-    static constexpr ActionId play(Card c) { return ActionId(c.v); };
-    static constexpr ActionId discard(Card c) { return ActionId(c.v + constants::num_cards); };
+    // Rule variants. They follow the standard ids so those keep their values.
+    static inline constexpr ActionId PlayJoker {56};
+    static inline constexpr ActionId DiscardJoker {57};
+    static inline constexpr ActionId DefendAloneYes {58};
+    static inline constexpr ActionId DefendAloneNo {59};
+    static inline constexpr ActionId FarmerSwapYes {60};
+    static inline constexpr ActionId FarmerSwapNo {61};
+    static inline constexpr ActionId InvalidAction {62};
+
+    static constexpr ActionId play(Card c) { return c.is_joker() ? PlayJoker : ActionId(c.v); };
+    static constexpr ActionId discard(Card c) {
+        return c.is_joker() ? DiscardJoker : ActionId(c.v + constants::num_cards);
+    };
     static constexpr ActionId call_trump(Suit s) { return ActionId(static_cast<uint16_t>(CallTrumpBase.v) + static_cast<uint8_t>(s)); }
-    
+
     static constexpr bool is_play(ActionId action) {
-        return action.v >= PlayCardBase && action.v <= PlayCardEnd;
+        return (action.v >= PlayCardBase && action.v <= PlayCardEnd) || action == PlayJoker;
     }
 
     static constexpr bool is_discard(ActionId action) {
-        return action.v >= DiscardCardBase && action.v <= DiscardCardEnd;
+        return (action.v >= DiscardCardBase && action.v <= DiscardCardEnd) || action == DiscardJoker;
+    }
+
+    /**
+     * @brief The card an is_play() action plays.
+     */
+    static constexpr Card played_card(ActionId action) {
+        return action == PlayJoker ? Card{constants::joker} : Card{action.v};
+    }
+
+    /**
+     * @brief The card an is_discard() action discards.
+     */
+    static constexpr Card discarded_card(ActionId action) {
+        return action == DiscardJoker ? Card{constants::joker} : Card{action.v - constants::num_cards};
+    }
+
+    /**
+     * @brief The play actions of a card set: bits 0-23 map straight across, the Joker's is PlayJoker.
+     */
+    static constexpr ActionMask play_mask(uint32_t cards) {
+        return (cards & constants::deck_reset) | (static_cast<ActionMask>(cards >> constants::joker) << PlayJoker.v);
+    }
+
+    /**
+     * @brief The discard actions of a card set.
+     */
+    static constexpr ActionMask discard_mask(uint32_t cards) {
+        return (static_cast<ActionMask>(cards & constants::deck_reset) << DiscardCardBase.v) |
+               (static_cast<ActionMask>(cards >> constants::joker) << DiscardJoker.v);
+    }
+
+    /**
+     * @brief The cards whose play actions are set in a mask; the inverse of play_mask().
+     */
+    static constexpr uint32_t play_cards(ActionMask mask) {
+        return static_cast<uint32_t>(mask & constants::deck_reset) |
+               (static_cast<uint32_t>((mask >> PlayJoker.v) & 1u) << constants::joker);
     }
 
     static constexpr bool is_call_trump(ActionId action) {
@@ -66,6 +119,11 @@ namespace euchre::action {
         Pass,
         GoAloneYes,
         GoAloneNo,
+        // Variant kinds are named apart from their ActionId constants so -Wshadow stays quiet.
+        DefendAlone,
+        DeclineDefendAlone,
+        FarmerSwap,
+        DeclineFarmerSwap,
         InvalidAction,
     };
 
@@ -0,0 +1,131 @@
+#pragma once
+
+#include "Env.hpp"
+#include "WorkerPool.hpp"
+#include "bots/IBot.hpp"
+#include <array>
+#include <chrono>
+#include <functional>
+#include <memory>
+#include <tuple>
+#include <vector>
+
+struct BenchResult {
+    int team0_wins;
+    int team1_wins;
+    int stalled;
+    double seconds;
+};
+
+struct ThreadStats {
+    int games;
+    double busy_seconds;
+};
+
+struct ParallelBenchResult {
+    BenchResult total;
+    std::vector<ThreadStats> threads;
+};
+
+/**
+ * @brief Builds a fresh set of four bots. Called once per worker thread.
+ */
+using Lineup = std::array<std::unique_ptr<IBot>, 4>;
+using LineupFactory = std::function<Lineup()>;
+
+/**
+ * @brief Play games `first .. last - 1` (game g uses seed g) and add their outcomes to result.
+ *
+ * Before each game every seat gets on_new_match(g * 4 + seat), so stateful bots behave the same no
+ * matter which thread or in which order the game is played.
+ */
+void play_games(std::array<IBot*, 4> players, int first, int last, int max_steps, BenchResult& result);
+
+/**
+ * @brief Play seeds 0 .. num_games - 1 on the calling thread.
+ */
+BenchResult run_benchmark(std::array<IBot*, 4> players, int num_games, int max_steps);
+
+/**
+ * @brief Play seeds 0 .. num_games - 1 across the pool, one lineup per worker.
+ *
+ * Win/stall counts are bit-identical to run_benchmark() for any thread count; only timings differ.
+ */
+ParallelBenchResult run_parallel_benchmark(WorkerPool& pool, const LineupFactory& factory, int num_games, int max_steps);
+
+/**
+ * @brief Plays the games of one worker's chunk: (worker, first, last, result).
+ */
+using ChunkPlayer = std::function<void(std::size_t, int, int, BenchResult&)>;
+
+/**
+ * @brief Split seeds 0 .. num_games - 1 across the pool and sum the chunks' outcomes.
+ */
+ParallelBenchResult run_parallel_games(WorkerPool& pool, int num_games, const ChunkPlayer& play);
+
+/**
+ * @brief play_games() on any env type, e.g. a StaticEnv whose decisions bind statically.
+ *
+ * Seeds, on_new_match() calls and step accounting are those of play_games(), so the same bots give
+ * the same outcomes whichever env plays them.
+ */
+template <typename EnvType>
+void play_env_games(const typename EnvType::Players& players, int first, int last, int max_steps, BenchResult& result) {
+    for (int g = first; g < last; g++) {
+        EnvType env{static_cast<unsigned int>(g), players};
+        for (uint8_t seat = 0; seat < euchre::constants::num_players; seat++) {
+            env.bot(seat)->on_new_match(static_cast<uint32_t>(g) * euchre::constants::num_players + seat);
+        }
+
+        int steps = 0;
+        while (env.state.status != GameState::GameStatus::GameOver && steps < max_steps) {
+            env.step_game();
+            steps++;
+        }
+
+        if (env.state.status != GameState::GameStatus::GameOver) {
+            result.stalled++;
+            continue;
+        }
+
+        if (env.state.scores[0] >= EnvType::rules.target_score) {
+            result.team0_wins++;
+        } else {
+            result.team1_wins++;
+        }
+    }
+}
+
+/**
+ * @brief run_benchmark() on any env type.
+ */
+template <typename EnvType>
+BenchResult run_env_benchmark(const typename EnvType::Players& players, int num_games, int max_steps) {
+    BenchResult result{};
+    auto start = std::chrono::high_resolution_clock::now();
+    play_env_games<EnvType>(players, 0, num_games, max_steps, result);
+    auto end = std::chrono::high_resolution_clock::now();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    return result;
+}
+
+/**
+ * @brief run_parallel_benchmark() on a StaticEnv: each worker owns a StaticBot of each type, named P0 .. P3.
+ *
+ * With the default rules, outcomes are identical to run_parallel_benchmark() over the same bot types.
+ */
+template <typename Bot0, typename Bot1, typename Bot2, typename Bot3, euchre::rules::RuleSet Rules = euchre::rules::RuleSet{},
+          euchre::validation::Policy Checks = euchre::validation::Policy{}>
+ParallelBenchResult run_parallel_static_benchmark(WorkerPool& pool, int num_games, int max_steps) {
+    using Bots = std::tuple<StaticBot<Bot0>, StaticBot<Bot1>, StaticBot<Bot2>, StaticBot<Bot3>>;
+    std::vector<std::unique_ptr<Bots>> lineups;
+    lineups.reserve(pool.size());
+    for (std::size_t w = 0; w < pool.size(); w++) {
+        lineups.push_back(std::make_unique<Bots>("P0", "P1", "P2", "P3"));
+    }
+
+    return run_parallel_games(pool, num_games, [&](std::size_t worker, int first, int last, BenchResult& result) {
+        auto& [p0, p1, p2, p3] = *lineups[worker];
+        play_env_games<StaticEnv<Bot0, Bot1, Bot2, Bot3, Rules, Checks>>({&p0, &p1, &p2, &p3}, first, last, max_steps, result);
+    });
+}
@@ -1,10 +1,12 @@
 #pragma once
 
 #include "Defns.hpp"
+#include "Validation.hpp"
 #include <cstdint>
 #include <array>
 #include <ostream>
 #include <cassert>
+#include <stdexcept>
 
 //using Card = uint8_t;
 
@@ -39,7 +41,7 @@ struct Card {
   
     }
     constexpr Card(int32_t c) : v(static_cast<uint8_t>(c)) {
-        assert(c < euchre::constants::num_cards);
+        assert(c < euchre::constants::max_cards);
     }
     constexpr Card(Suit s, Rank r) {
         v = s*6 + r;
@@ -50,21 +52,25 @@ struct Card {
         return v;
     }
 
+    /**
+     * @brief The other suit of s's colour (C <-> S, H <-> D). Suit::None throws, or only asserts
+     * below full validation.
+     */
     constexpr Suit same_color(Suit s) const {
-        switch(s) {
-            case Suit::C:
-                return Suit::S;
-            case Suit::S:
-                return Suit::C;
-            case Suit::H:
-                return Suit::D;
-            case Suit::D:
-                return Suit::H;
-            case Suit::None:
+        if constexpr (euchre::validation::build_level == euchre::validation::Level::Full) {
+            if (s == Suit::None) {
                 throw std::logic_error("Cannot get the same color suit of None");
-        };
+            }
+        }
+        else {
+            EUCHRE_ASSERT(s != Suit::None);
+        }
+        return static_cast<Suit>(s ^ 2u);
     }
 
+    /**
+     * @brief The printed suit; Suit::None for the Joker, which belongs to whatever suit is trump.
+     */
     constexpr Suit get_suit() const {
         return static_cast<Suit>(v / 6);
     }
@@ -80,6 +86,10 @@ struct Card {
     constexpr bool is_right_bower(Suit trump) const {
         return (get_rank() == Rank::RJ && get_suit() == trump);
     }
+
+    constexpr bool is_joker() const {
+        return v == euchre::constants::joker;
+    }
     ~Card() = default;
 
 };
@@ -111,6 +121,24 @@ constexpr Card make_card(const Suit s, const Rank r) {
     return Card{s, r};
 }
 
+/**
+ * @brief The cards a game is played with: the 24 card euchre deck, plus the Joker (Benny) as the
+ * highest trump when joker is set.
+ */
+struct DeckDef {
+    bool joker = false;
+
+    constexpr int num_cards() const {
+        return joker ? euchre::constants::max_cards : euchre::constants::num_cards;
+    }
+
+    constexpr uint32_t cards() const {
+        return (1u << num_cards()) - 1;
+    }
+
+    constexpr bool operator==(const DeckDef&) const = default;
+};
+
 
 #define SHOW_SUIT_SYMBOL 1
 #ifdef SHOW_SUIT_FULL
@@ -143,6 +171,9 @@ inline std::ostream& operator<<(std::ostream& os, const Card& c) {
 }
 #else
 inline std::ostream& operator<<(std::ostream& os, const Card& c) {
+    if (c.is_joker()) {
+        return os << "Jkr";
+    }
     return os << c.get_rank() << c.get_suit();
 }
 #endif
@@ -0,0 +1,195 @@
+#pragma once
+
+#include "Action.hpp"
+#include "FramePool.hpp"
+#include "GameState.hpp"
+#include "Observation.hpp"
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <span>
+#include <utility>
+#include <vector>
+
+using euchre::action::ActionId;
+using euchre::action::ActionMask;
+
+namespace euchre::co {
+
+    /**
+     * @brief A lazily started coroutine that resumes its awaiter when it finishes.
+     *
+     * Frames come from the thread-local FramePool, so creating and finishing phase coroutines
+     * does not touch the global heap once the pool is warm.
+     */
+    class [[nodiscard]] Task {
+        public:
+
+        struct promise_type {
+            std::coroutine_handle<> continuation = std::noop_coroutine();
+            std::exception_ptr exception;
+
+            Task get_return_object() {
+                return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+            }
+
+            std::suspend_always initial_suspend() noexcept { return {}; }
+
+            struct FinalAwaiter {
+                bool await_ready() noexcept { return false; }
+                std::coroutine_handle<> await_suspend(std::coroutine_handle<promise_type> h) noexcept {
+                    return h.promise().continuation;
+                }
+                void await_resume() noexcept {}
+            };
+
+            FinalAwaiter final_suspend() noexcept { return {}; }
+            void return_void() {}
+            void unhandled_exception() { exception = std::current_exception(); }
+
+            static void* operator new(std::size_t n) { return FramePool::local().allocate(n); }
+            static void operator delete(void* p, std::size_t n) { FramePool::local().deallocate(p, n); }
+        };
+
+        Task() = default;
+        Task(Task&& other) noexcept : handle(std::exchange(other.handle, {})) {}
+        Task& operator=(Task&& other) noexcept {
+            if (this != &other) {
+                destroy();
+                handle = std::exchange(other.handle, {});
+            }
+            return *this;
+        }
+        Task(const Task&) = delete;
+        Task& operator=(const Task&) = delete;
+        ~Task() { destroy(); }
+
+        bool await_ready() const noexcept { return false; }
+
+        std::coroutine_handle<> await_suspend(std::coroutine_handle<> caller) noexcept {
+            handle.promise().continuation = caller;
+            return handle;
+        }
+
+        void await_resume() const {
+            if (handle.promise().exception) {
+                std::rethrow_exception(handle.promise().exception);
+            }
+        }
+
+        std::coroutine_handle<promise_type> handle;
+
+        private:
+
+        explicit Task(std::coroutine_handle<promise_type> h) : handle(h) {}
+
+        void destroy() {
+            if (handle) {
+                handle.destroy();
+                handle = {};
+            }
+        }
+    };
+};
+
+/**
+ * @brief A game written as straight-line coroutines that suspend at every decision.
+ *
+ * The phases mirror Env, but instead of calling IBot::select_action they co_await a decision. The game
+ * parks with pending_player/pending_mask set, and resume() feeds the chosen action back in. Nothing
+ * here knows about bots, so a scheduler can interleave any number of suspended games.
+ */
+class CoEnv {
+    public:
+
+    CoEnv(unsigned int seed);
+    CoEnv(const CoEnv&) = delete;
+    CoEnv& operator=(const CoEnv&) = delete;
+
+    bool done() const { return state.status == GameState::GameStatus::GameOver; }
+
+    /**
+     * @brief The observation for the pending decision.
+     */
+    Observation observation() {
+        return state.hand_state.generate_observation(pending_player, state.dealer);
+    }
+
+    /**
+     * @brief Answer the pending decision and run the game until the next one (or the end).
+     *
+     * @throws std::invalid_argument when the action is not in the pending mask.
+     */
+    void resume(ActionId action);
+
+    GameState state;
+    uint8_t pending_player = 0;
+    ActionMask pending_mask = 0;
+
+    private:
+
+    struct DecisionAwaiter {
+        CoEnv& env;
+        bool await_ready() const noexcept { return false; }
+        void await_suspend(std::coroutine_handle<> h) noexcept { env.suspended = h; }
+        ActionId await_resume() const noexcept { return env.answer; }
+    };
+
+    DecisionAwaiter decide(uint8_t player, ActionMask mask) {
+        pending_player = player;
+        pending_mask = mask;
+        return DecisionAwaiter{*this};
+    }
+
+    euchre::co::Task play_game();
+    euchre::co::Task play_hand();
+    euchre::co::Task bid_round_1();
+    euchre::co::Task go_alone_decision();
+    euchre::co::Task dealer_pickup_discard();
+    euchre::co::Task bid_round_2();
+    euchre::co::Task request_tricks();
+
+    void deal();
+    void calc_winner();
+    void hand_over();
+    void run_until_suspended(std::coroutine_handle<> h);
+
+    euchre::co::Task game;
+    std::coroutine_handle<> suspended;
+    ActionId answer;
+};
+
+/**
+ * @brief Single threaded scheduler that answers the pending decisions of many CoEnv games in batches.
+ */
+class CoScheduler {
+    public:
+
+    /**
+     * @brief Batch policy: fill actions[i] for every (observations[i], masks[i]).
+     */
+    using BatchPolicy = std::function<void(std::span<const Observation>, std::span<const ActionMask>, std::span<ActionId>)>;
+
+    /**
+     * @brief Create games seeded `seed .. seed + num_games - 1`.
+     */
+    CoScheduler(std::size_t num_games, unsigned int seed);
+
+    /**
+     * @brief Repeatedly gather every pending decision, answer them with one policy call and resume.
+     *
+     * @return std::size_t The number of policy calls made.
+     */
+    std::size_t run(const BatchPolicy& policy);
+
+    std::vector<std::unique_ptr<CoEnv>> games;
+
+    private:
+
+    std::vector<std::size_t> live;
+    std::vector<Observation> observations;
+    std::vector<ActionMask> masks;
+    std::vector<ActionId> actions;
+};
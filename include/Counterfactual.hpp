@@ -0,0 +1,34 @@
+#pragma once
+
+#include "Action.hpp"
+#include "Env.hpp"
+#include <array>
+
+/**
+ * @brief How far a counterfactual rollout is played.
+ */
+enum class RolloutHorizon : uint8_t {
+    Hand,
+    Game,
+};
+
+struct CounterfactualValues {
+    uint8_t player = 0;
+    ActionMask mask = 0;
+    // Mean (own team points - opponent points) gained from the decision to the horizon, per action.
+    // Only entries set in mask are meaningful.
+    std::array<double, euchre::action::num_actions> value {};
+};
+
+/**
+ * @brief Try every legal action at env's pending decision and roll each branch out with policy.
+ *
+ * env itself is left untouched: each branch is restored from one snapshot into a scratch Env owned by
+ * the calling thread. Before rollout r every seat gets on_new_match(r * 4 + seat), so all actions see
+ * the same bot randomness (common random numbers) and results do not depend on the thread.
+ *
+ * @return The decision's player and mask with a value per legal action, or an empty mask when the
+ * game is over.
+ */
+CounterfactualValues counterfactual_values(const Env& env, std::array<IBot*, 4> policy, int n_rollouts,
+                                           RolloutHorizon horizon = RolloutHorizon::Hand);
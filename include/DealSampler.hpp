@@ -0,0 +1,205 @@
+#pragma once
+
+#include "Defns.hpp"
+#include "Deck.hpp"
+#include "Observation.hpp"
+#include "Rng.hpp"
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+/**
+ * @brief What one seat knows about where the cards it has not seen can be.
+ */
+struct DealConstraints {
+    uint8_t me = 0;
+    // Cards whose location is unknown to `me`; each ends up in some hand or buried.
+    uint32_t unseen = 0;
+    // Cards each seat is known to hold: our own hand, an ordered up card still with the dealer.
+    std::array<uint32_t, 4> fixed {};
+    // How many unseen cards each seat holds.
+    std::array<uint8_t, 4> need {};
+    // Cards each seat may hold, i.e. not in an effective suit it has shown out of.
+    std::array<uint32_t, 4> allowed {};
+    // The face up card, which no seat but the dealer can ever hold, void or not.
+    uint32_t face_up = 0;
+    uint8_t dealer = 0;
+    // Who led the trick in progress and which seats have played to it (bit per seat).
+    uint8_t lead_player = 0;
+    uint8_t trick_seats = 0;
+
+    /**
+     * @brief Constraints from an observation in any decision phase.
+     *
+     * The dealer picks up the face up card after either bidding round. Once play starts an ordered
+     * up card is taken to be in the dealer's hand until it shows up. A card picked up after a round 2
+     * call is in the dealer's hand or buried, and buried once the dealer shows out of its suit.
+     * Before play it is still face up, and no other seat ever holds it.
+     */
+    static DealConstraints from_observation(const Observation& obs);
+
+    /**
+     * @brief Whether an observation shows a standard table, the only one the constraints model.
+     *
+     * A Joker seen anywhere or a lone defender gives a variant table away; farmer's hand never
+     * reaches the phases that build constraints.
+     */
+    static bool standard_table(const Observation& obs);
+
+    /**
+     * @brief The same constraints without the void inferences.
+     *
+     * Only the dealer may still hold the face up card.
+     */
+    DealConstraints without_voids() const;
+};
+
+/**
+ * @brief Draws uniformly from every deal that satisfies a DealConstraints.
+ *
+ * Unseen cards are grouped by which seats may hold them; voids are per suit so there are only a
+ * handful of groups. The constructor counts the completions from each group onwards for each
+ * remaining demand per seat. A sample then walks the groups, picks how many cards of each group
+ * every seat gets in proportion to those counts and which cards uniformly within the group, so it
+ * never rejects and costs the same however tight the constraints are.
+ */
+class DealSampler {
+public:
+    /**
+     * @brief An empty (infeasible) sampler with room for any constraints, so reset() never allocates.
+     */
+    DealSampler();
+    explicit DealSampler(const DealConstraints& constraints);
+
+    /**
+     * @brief Recount for new constraints, reusing this sampler's storage.
+     */
+    void reset(const DealConstraints& constraints);
+
+    /**
+     * @brief Recount for a search bot's observation and store the constraints used in constraints.
+     *
+     * Void inferences assume honest play; if they rule out every deal, the voids are dropped.
+     *
+     * @return Whether any deal is consistent even then.
+     * @throws std::logic_error at a variant table, which the constraints do not model.
+     */
+    bool reset_for(const Observation& obs, DealConstraints& constraints);
+
+    /**
+     * @brief Number of consistent deals; zero when the constraints contradict each other.
+     */
+    uint64_t count() const { return total; }
+    bool feasible() const { return total != 0; }
+
+    /**
+     * @brief The unseen cards a sampled deal left buried.
+     */
+    uint32_t buried(const std::array<uint32_t, 4>& hands) const {
+        return unseen & ~(hands[0] | hands[1] | hands[2] | hands[3]);
+    }
+
+    /**
+     * @brief Draw one deal: every seat's full hand, known cards included.
+     *
+     * Returns just the known cards if the constraints are infeasible.
+     */
+    template <euchre::rng::Engine E>
+    std::array<uint32_t, 4> sample(E& eng) const;
+
+    /**
+     * @brief Fill out with independent samples.
+     */
+    template <euchre::rng::Engine E>
+    void sample_batch(E& eng, std::span<std::array<uint32_t, 4>> out) const {
+        for (auto& hands : out) {
+            hands = sample(eng);
+        }
+    }
+
+private:
+    // At most three seats hold unseen cards, and none more than five.
+    static constexpr std::size_t max_seats = 3;
+    static constexpr std::size_t radix = 6;
+    static constexpr std::size_t num_states = radix * radix * radix;
+
+    using Demand = std::array<uint8_t, max_seats>;
+
+    /**
+     * @brief Cards of one group dealt to each seat, and the number of ways to pick them.
+     */
+    struct Split {
+        Demand take;
+        uint64_t ways;
+    };
+
+    struct Group {
+        uint32_t cards;
+        uint32_t first_split;
+        uint32_t end_split;
+    };
+
+    static std::size_t index(const Demand& r) { return (r[0] * radix + r[1]) * radix + r[2]; }
+
+    static bool fits(const Demand& take, const Demand& r) {
+        return take[0] <= r[0] && take[1] <= r[1] && take[2] <= r[2];
+    }
+
+    static Demand minus(const Demand& r, const Demand& take) {
+        return {static_cast<uint8_t>(r[0] - take[0]), static_cast<uint8_t>(r[1] - take[1]),
+                static_cast<uint8_t>(r[2] - take[2])};
+    }
+
+    uint64_t completions(std::size_t g, const Demand& r);
+
+    uint32_t unseen = 0;
+    std::array<uint32_t, 4> fixed {};
+    std::array<uint8_t, max_seats> seats {};
+    Demand demand {};
+    std::vector<Group> groups;
+    std::vector<Split> splits;
+    // ways[g * num_states + index(r)]: deals of groups g.. that meet demand r; ~0 until computed.
+    std::vector<uint64_t> ways;
+    uint64_t total = 0;
+};
+
+template <euchre::rng::Engine E>
+std::array<uint32_t, 4> DealSampler::sample(E& eng) const {
+    std::array<uint32_t, 4> hands = fixed;
+    if (total == 0) {
+        return hands;
+    }
+
+    Demand r = demand;
+    for (std::size_t g = 0; g < groups.size(); g++) {
+        const Group& grp = groups[g];
+        uint64_t left = ways[g * num_states + index(r)];
+        uint64_t wide = (static_cast<uint64_t>(eng()) << 32) | eng();
+        // The counts stay far below 2^32, so the modulo bias is negligible.
+        uint64_t pick = wide % left;
+
+        const Split* chosen = &splits[grp.end_split - 1];
+        for (uint32_t i = grp.first_split; i < grp.end_split; i++) {
+            const Split& s = splits[i];
+            if (!fits(s.take, r)) {
+                continue;
+            }
+            uint64_t w = s.ways * ways[(g + 1) * num_states + index(minus(r, s.take))];
+            if (pick < w) {
+                chosen = &s;
+                break;
+            }
+            pick -= w;
+        }
+
+        uint32_t cards = grp.cards;
+        for (std::size_t s = 0; s < max_seats; s++) {
+            for (uint8_t j = 0; j < chosen->take[s]; j++) {
+                hands[seats[s]] |= 1u << draw_card(cards, eng);
+            }
+        }
+        r = minus(r, chosen->take);
+    }
+    return hands;
+}
@@ -1,16 +1,20 @@
 #pragma once
+#include <array>
+#include <bit>
+#include <cassert>
+#include <concepts>
 #include <cstdint>
-#include <random>
 #include "Card.hpp"
+#include "Defns.hpp"
+#include "Rng.hpp"
 
-template <std::unsigned_integral T>
-inline T pick_random_bit(T mask, std::mt19937& rng) {
+template <std::unsigned_integral T, euchre::rng::Engine E>
+inline T pick_random_bit(T mask, E& rng) {
     assert(mask != 0);
-    
+
     // Get the number of cards left in the deck.
-    int cards_left = std::popcount(mask);
-    std::uniform_int_distribution<int> dist(0, cards_left - 1);
-    int k = dist(rng);
+    auto cards_left = static_cast<uint32_t>(std::popcount(mask));
+    uint32_t k = euchre::rng::bounded(rng, cards_left);
     T m = mask;
     while(k--) {
         m &= (m - 1);
@@ -19,4 +23,66 @@ inline T pick_random_bit(T mask, std::mt19937& rng) {
     return static_cast<T>(std::countr_zero(m));
 }
 
-Card draw_card(uint32_t& remaining_cards, std::mt19937& rng);
\ No newline at end of file
+template <euchre::rng::Engine E>
+inline Card draw_card(uint32_t& remaining_cards, E& rng) {
+    uint32_t bit = pick_random_bit(remaining_cards, rng);
+    Card c {bit};
+    remaining_cards &= ~(1u << c);
+    return c;
+}
+
+/**
+ * @brief A full deal: five cards per seat, the face up card and the cards left in the kitty (three,
+ * or four in the 25 card deck).
+ */
+struct Deal {
+    std::array<uint32_t, euchre::constants::num_players> hands {};
+    Card face_up = euchre::constants::invalid_card;
+    uint32_t kitty = 0;
+};
+
+/**
+ * @brief The rank of a deal: draw i picks the ranks[i]-th lowest card still in the deck, so
+ * ranks[i] < deck size - i. Seats get draws 0-4, 5-9, 10-14 and 15-19; draw 20 is the face up card.
+ */
+using DealRanks = std::array<uint8_t, 21>;
+
+template <euchre::rng::Engine E>
+inline DealRanks draw_deal_ranks(E& rng, DeckDef deck = {}) {
+    DealRanks ranks;
+    auto size = static_cast<uint32_t>(deck.num_cards());
+    for (uint32_t i = 0; i < ranks.size(); i++) {
+        ranks[i] = static_cast<uint8_t>(euchre::rng::bounded(rng, size - i));
+    }
+    return ranks;
+}
+
+/**
+ * @brief Turn deal ranks into hands, using BMI2 pdep when the CPU has it.
+ *
+ * @param deck The cards being dealt, as a card set (DeckDef::cards()).
+ */
+Deal unrank_deal(const DealRanks& ranks, uint32_t deck = euchre::constants::deck_reset);
+
+/**
+ * @brief Portable unrank; always available and bit-identical to unrank_deal_bmi2.
+ */
+Deal unrank_deal_portable(const DealRanks& ranks, uint32_t deck = euchre::constants::deck_reset);
+
+#if defined(__x86_64__) || defined(__i386__)
+#define EUCHRE_HAS_BMI2_DEAL 1
+/**
+ * @brief pdep based unrank. Only call it when cpu_has_bmi2() is true.
+ */
+Deal unrank_deal_bmi2(const DealRanks& ranks, uint32_t deck = euchre::constants::deck_reset);
+#endif
+
+bool cpu_has_bmi2();
+
+/**
+ * @brief Shuffle and deal in one pass: the same cards, in the same seats, as 21 draw_card calls.
+ */
+template <euchre::rng::Engine E>
+inline Deal deal_cards(E& rng, DeckDef deck = {}) {
+    return unrank_deal(draw_deal_ranks(rng, deck), deck.cards());
+}
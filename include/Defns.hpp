@@ -3,6 +3,9 @@
 
 namespace euchre::constants {
     inline constexpr int num_cards = 24;
+    // Card ids run one past the standard deck: id 24 is the Joker of the 25 card deck.
+    inline constexpr uint8_t joker = 24;
+    inline constexpr int max_cards = 25;
     inline constexpr int deck_reset = (1 << num_cards) - 1;
     inline constexpr uint8_t invalid_card = 0xFF;
     inline constexpr int num_players = 4;
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Card.hpp"
+#include "Defns.hpp"
+#include "HandState.hpp"
+#include "Tables.hpp"
+#include <array>
+#include <cstdint>
+#include <vector>
+
+class Tablebase;
+
+/**
+ * @brief A trick-play position with every hand visible.
+ *
+ * trick_cards is indexed by seat, like HandState; the first num_played seats from lead_player have
+ * played. The sitting out seat of a lone maker is ignored.
+ */
+struct DDPosition {
+    std::array<uint32_t, 4> hands {};
+    std::array<Card, 4> trick_cards {};
+    Suit        trump = Suit::None;
+    uint8_t     lead_player = 0;
+    uint8_t     current_player = 0;
+    uint8_t     num_played = 0;
+    bool        going_alone = false;
+    uint8_t     maker_player = 0;
+    std::array<uint8_t, 2> tricks_won {};
+
+    static DDPosition from_hand_state(const HandState& hs);
+};
+
+/**
+ * @brief Exact trick-play solver: alpha-beta over card plays with a transposition table.
+ *
+ * Cards that are equivalent once the cards between them are gone (see rules::distinct_moves) are
+ * searched once. The table is keyed on the hands, leader and rule context at trick boundaries and is kept between
+ * solves, so solving many positions from related deals gets cheaper over time. Not thread safe; use
+ * one solver per thread.
+ */
+class DoubleDummySolver {
+    public:
+
+    /**
+     * @param tt_bits log2 of the number of transposition table entries (16 bytes each).
+     */
+    explicit DoubleDummySolver(uint32_t tt_bits = 18);
+
+    /**
+     * @brief Tricks each team takes in the whole hand with optimal play from pos.
+     */
+    std::array<uint8_t, 2> solve(const DDPosition& pos);
+
+    /**
+     * @brief Hand total for the current player's team after each legal card, -1 for illegal cards.
+     */
+    std::array<int8_t, euchre::constants::num_cards> solve_moves(const DDPosition& pos);
+
+    void clear();
+
+    /**
+     * @brief Look up endgames in tb instead of searching them; nullptr turns this off.
+     *
+     * The tablebase must outlive the solver or be replaced first.
+     */
+    void set_tablebase(const Tablebase* tb) { tablebase = tb; }
+
+    uint64_t nodes() const { return node_count; }
+
+    private:
+
+    struct Entry {
+        uint64_t k1 = 0;
+        uint64_t k2 = 0;
+    };
+
+    struct Undo {
+        uint8_t lead_player;
+        uint8_t current_player;
+        uint8_t num_played;
+        uint8_t best_player;
+        uint8_t best_power;
+        Suit    led;
+        uint32_t in_trick;
+    };
+
+    const euchre::tables::Tables& t;
+
+    // Search state, mutated by make()/unmake().
+    std::array<uint32_t, 4> hands {};
+    Suit        trump = Suit::None;
+    Suit        led = Suit::None;
+    uint8_t     lead_player = 0;
+    uint8_t     current_player = 0;
+    uint8_t     num_played = 0;
+    uint8_t     best_player = 0;
+    uint8_t     best_power = 0;
+    uint8_t     trick_size = 4;
+    bool        going_alone = false;
+    uint8_t     maker_player = 0;
+    uint64_t    context = 0;
+    // Cards played to the trick under way; they still separate equivalent cards.
+    uint32_t    in_trick = 0;
+
+    const Tablebase* tablebase = nullptr;
+    std::vector<Entry> table;
+    uint64_t    mask = 0;
+    uint64_t    node_count = 0;
+
+    void load(const DDPosition& pos);
+    int search(int alpha, int beta);
+    int remaining_tricks() const;
+    int last_trick() const;
+    uint32_t legal_cards(uint8_t player) const;
+    uint32_t distinct_legal_cards(uint8_t player) const;
+    int order_moves(uint32_t legal, std::array<Card, 6>& moves) const;
+    int make(Card c, Undo& undo);
+    void unmake(Card c, const Undo& undo);
+};
@@ -1,195 +1,391 @@
+#pragma once
+
 #include "Action.hpp"
 #include "Defns.hpp"
+#include "GameSnapshot.hpp"
 #include "GameState.hpp"
+#include <concepts>
+#include <optional>
 #include <random>
+#include <tuple>
+#include <type_traits>
 #include "Deck.hpp"
 #include "Observation.hpp"
 #include "bots/IBot.hpp"
+#include "bots/StaticBot.hpp"
 #include "Phase.hpp"
-
-class Env {
+#include "Rules.hpp"
+#include "Validation.hpp"
+
+/**
+ * @brief A decision the game is waiting on: who acts, what they see and what they may do.
+ */
+struct Decision {
+    uint8_t player;
+    Observation obs;
+    ActionMask mask;
+};
+
+/**
+ * @brief The pointers an env holds to its four seats: an array when every seat is a plain IBot,
+ * otherwise a tuple of the exact seat types.
+ */
+template <typename... Seats>
+using SeatPointers = std::conditional_t<(std::same_as<Seats, IBot> && ...), std::array<IBot*, 4>, std::tuple<Seats*...>>;
+
+/**
+ * @brief A seat is either dispatched virtually (IBot) or a final bot type whose calls bind statically.
+ */
+template <typename Seat>
+concept SeatType = std::same_as<Seat, IBot> || (std::derived_from<Seat, IBot> && std::is_final_v<Seat>);
+
+/**
+ * @brief The game engine, templated on the type of bot in each seat.
+ *
+ * A seat typed IBot asks its bot through the virtual select_action(). Any other seat type must be
+ * final (usually StaticBot<Bot>), so each decision is a direct call the compiler can inline, with no
+ * virtual dispatch per phase. Env is the all-IBot instantiation; both play identical games.
+ *
+ * Rules fixes the optional rules at compile time; the default RuleSet is standard play. Variant
+ * rules (the Joker deck, defending alone, the farmer's hand) add their own phases and actions; with
+ * them off, their branches compile away and the standard game is unchanged.
+ *
+ * Checks sets how the actions bots return are validated: always (the default), by assert, or not
+ * at all for vetted bots, optionally auditing one decision in N.
+ */
+template <SeatType Seat0, SeatType Seat1, SeatType Seat2, SeatType Seat3,
+          euchre::rules::RuleSet Rules = euchre::rules::RuleSet{},
+          euchre::validation::Policy Checks = euchre::validation::Policy{}>
+class BasicEnv {
 
     public:
-    Env(unsigned int seed, std::array<IBot*, 4> players) : state(), players(players) {
+    using Players = SeatPointers<Seat0, Seat1, Seat2, Seat3>;
+    static constexpr euchre::rules::RuleSet rules = Rules;
+    static constexpr euchre::validation::Policy checks = Checks;
+
+    BasicEnv(unsigned int seed, Players players) : state(), players(players) {
         state.eng.seed(seed);
     }
 
     /**
      * @brief Request a legal action from each player.
      *
-     * This function exists because we want a single place where we can validate that the returned action 
+     * This function exists because we want a single place where we can validate that the returned action
      * is a legal action.
-     * 
+     *
      * @param player The player index
      * @param action_mask The legal action mask
      * @return ActionId A action.
-     * @throws std::invalid_argument when the player/bot returns an illegal action.
+     * @throws std::invalid_argument when the player/bot returns an illegal action (see Checks).
      */
     ActionId request_action(uint8_t player, ActionMask action_mask) {
-        Observation obs = state.hand_state.generate_observation(player, state.dealer);
-        ActionId action_id = players[player]->select_action(obs, action_mask);
-        if ((euchre::action::a2m(action_id) & action_mask) == 0) {
-            throw std::invalid_argument("Returned action_id did not match the action mask");
-        }
+        Observation obs = state.hand_state.generate_observation(player, state.dealer, deck_tables());
+        ActionId action_id = select_action(player, obs, action_mask);
+        check_action(action_id, action_mask);
         return action_id;
     }
 
     /**
-     * @brief Deal a hand to each player.
+     * @brief Advance to the next decision point and describe it, without asking any bot.
+     *
+     * Together with apply() this drives the game with inverted control: the caller gathers the
+     * decision, answers it however it likes (e.g. batched inference) and feeds the action back.
+     *
+     * @return std::optional<Decision> The pending decision, or nullopt once the game is over.
      */
-    void deal() {
-        // Deal cards to all players.
-        for (uint8_t i = 0; i < euchre::constants::num_players; i++) {
-            for (uint8_t j = 0; j < 5; j++) {
-                Card c = draw_card(state.hand_state.deck, state.eng);
-                state.hand_state.give_card_to(c, i);
-            }
+    std::optional<Decision> next_decision() {
+        advance_to_decision();
+        if (state.status == GameState::GameStatus::GameOver) {
+            return std::nullopt;
         }
-        // Set the face up card
-        state.hand_state.face_up_card = draw_card(state.hand_state.deck, state.eng);
-        state.hand_state.phase = Phase::BidRound1;
-    }
-
 
-    uint8_t get_next_player(uint8_t current_player) {
+        uint8_t player = state.hand_state.current_player;
+        return Decision{
+            .player = player,
+            .obs = state.hand_state.generate_observation(player, state.dealer, deck_tables()),
+            .mask = legal_actions(),
+        };
+    }
 
-        uint8_t next_player = (current_player + 1) % euchre::constants::num_players;
-        // If going alone, we may need to skip a player. 
-        if (state.hand_state.going_alone && (next_player == (state.hand_state.maker_player + 2) % euchre::constants::num_players)) {
-            next_player = (next_player + 1) % euchre::constants::num_players;
+    /**
+     * @brief Apply the pending decision's action and advance to the next decision point.
+     *
+     * @param action The action chosen for the player returned by next_decision().
+     * @throws std::invalid_argument when the action is not legal for the pending decision (see Checks).
+     */
+    void apply(ActionId action) {
+        advance_to_decision();
+        if (state.status == GameState::GameStatus::GameOver) {
+            throw std::logic_error("Cannot apply an action to a finished game");
+        }
+        if constexpr (Checks.level != euchre::validation::Level::Trusted || Checks.audit_every > 0) {
+            check_action(action, legal_actions());
         }
+        apply_action(action);
+        advance_to_decision();
+    }
 
-        return next_player;
+    /**
+     * @brief Copy the game state into a 64 byte snapshot.
+     */
+    GameSnapshot snapshot() const {
+        return GameSnapshot::from_state(state);
     }
 
     /**
-     * @brief Goes through the first euchre bidding round.
-     * 
-     * Each player has the opportunity to tell the dealer to pick up the card, and go alone. 
+     * @brief Rewind (or jump) this env to a snapshot taken from any env.
      */
-    void bid_round_1() {
-        uint8_t current_player = state.dealer;
-        ActionMask action_mask = static_cast<ActionMask>((1ULL << euchre::action::Pass.v | 1ULL << euchre::action::OrderUp.v));
-        
-        do {
-            current_player = (current_player + 1) % euchre::constants::num_players;
-            ActionId action_id = request_action(current_player, action_mask);
-
-            if (action_id == euchre::action::OrderUp) {
-                state.hand_state.trump = state.hand_state.face_up_card.get_suit();
-                state.hand_state.maker_team = current_player % 2;
-                state.hand_state.maker_player = current_player;
-                state.hand_state.phase = Phase::GoAloneDecision;
-                return;
-            }
+    void restore(const GameSnapshot& snap) {
+        snap.restore(state);
+    }
 
-        } while (current_player != state.dealer);
-        state.hand_state.phase = Phase::BidRound2;
+    /**
+     * @brief An independent copy of this game, played from here on by the given bots.
+     */
+    BasicEnv fork(Players policy) const {
+        BasicEnv branch = *this;
+        branch.players = policy;
+        return branch;
     }
 
+    /**
+     * @brief The legal actions for the player to act in the current phase.
+     */
+    ActionMask legal_actions() {
+        const HandState& hs = state.hand_state;
+        uint8_t player = hs.current_player;
 
-    void dealer_pickup_discard() {
-        state.hand_state.hands[state.dealer].give_card(state.hand_state.face_up_card);
-        ActionMask action_mask = static_cast<ActionMask>(state.hand_state.hands[state.dealer].value()) << euchre::constants::num_cards;
-        ActionId action = request_action(state.dealer, action_mask);
-        Card c {static_cast<uint8_t>(action.v - euchre::constants::num_cards)};
-        state.hand_state.hands[state.dealer].remove_card(c);
-        state.hand_state.phase = Phase::PlayTrick;
+        switch (hs.phase) {
+            case Phase::BidRound1:
+                return euchre::action::make_mask(euchre::action::Pass, euchre::action::OrderUp);
+            case Phase::GoAloneDecision:
+                return euchre::action::make_mask(euchre::action::GoAloneYes, euchre::action::GoAloneNo);
+            case Phase::DefendAloneDecision:
+                return euchre::action::make_mask(euchre::action::DefendAloneYes, euchre::action::DefendAloneNo);
+            case Phase::FarmerSwap:
+                return euchre::action::make_mask(euchre::action::FarmerSwapYes, euchre::action::FarmerSwapNo);
+            case Phase::DealerPickupDiscard:
+            case Phase::FarmerDiscard:
+                return discard_actions(hs.hands[player].value());
+            case Phase::BidRound2: {
+                ActionMask action_mask = euchre::action::make_mask(
+                    euchre::action::Pass,
+                    euchre::action::call_trump(Suit::C),
+                    euchre::action::call_trump(Suit::H),
+                    euchre::action::call_trump(Suit::S),
+                    euchre::action::call_trump(Suit::D)
+                );
+                // A turned up Joker has no suit, so every suit may be named.
+                if (!(joker && hs.face_up_card.is_joker())) {
+                    action_mask &= ~euchre::action::a2m(euchre::action::call_trump(hs.face_up_card.get_suit()));
+                }
+
+                if (player == state.dealer && stick_the_dealer()) {
+                    action_mask &= ~euchre::action::a2m(euchre::action::Pass);
+                }
+                return action_mask;
+            }
+            case Phase::PlayTrick:
+                if (hs.num_played == 0) {
+                    return play_actions(hs.hands[player].value());
+                }
+                return play_actions(hs.hands[player].get_valid_hand(hs.lead_card, hs.trump, deck_tables()));
+            default:
+                return 0;
+        }
     }
 
-    void go_alone_decision() {
-        ActionMask action_mask = euchre::action::make_mask(euchre::action::GoAloneYes, euchre::action::GoAloneNo);
-        ActionId action = request_action(state.hand_state.maker_player, action_mask);
-        if (action == euchre::action::GoAloneYes) {
-            state.hand_state.going_alone = true;
+    /**
+     * @brief Deal a hand to each player.
+     */
+    void deal() {
+        // Deal cards to all players.
+        state.eng.seek(state.hands_dealt++);
+        Deal d = deal_cards(state.eng, Rules.deck);
+        for (uint8_t i = 0; i < euchre::constants::num_players; i++) {
+            state.hand_state.hands[i] = Hand{d.hands[i]};
+        }
+        state.hand_state.deck = d.kitty;
+        // Set the face up card
+        state.hand_state.face_up_card = d.face_up;
+        if constexpr (Rules.farmers_hand) {
+            if (offer_farmers_hand()) {
+                return;
+            }
         }
-        state.hand_state.phase = Phase::DealerPickupDiscard;
+        start_bidding();
     }
 
-    void bid_round_2() {
 
-        ActionMask action_mask = euchre::action::make_mask(
-            euchre::action::Pass, 
-            euchre::action::call_trump(Suit::C),
-            euchre::action::call_trump(Suit::H),
-            euchre::action::call_trump(Suit::S),
-            euchre::action::call_trump(Suit::D)
+    uint8_t get_next_player(uint8_t current_player) {
+        // If going alone, we may need to skip a player (two, when a defender is alone too).
+        if constexpr (Rules.defend_alone) {
+            return euchre::rules::next_player(current_player, sitting_out());
+        }
+        else {
+            return euchre::rules::next_player(current_player, going_alone(), state.hand_state.maker_player);
+        }
+    }
+
+    /**
+     * @brief Apply a single, already validated action for the current player.
+     *
+     * This is the resumable core of every decision phase: it updates the state and moves the turn
+     * cursor, but never runs the automatic phases (Deal, HandOver).
+     */
+    void apply_action(ActionId action) {
+        HandState& hs = state.hand_state;
+        uint8_t current_player = hs.current_player;
 
-        ) & ~euchre::action::a2m(euchre::action::call_trump(state.hand_state.face_up_card.get_suit()));
+        switch (hs.phase) {
+            case Phase::BidRound1:
+                if (action == euchre::action::OrderUp) {
+                    hs.trump = hs.face_up_card.get_suit();
+                    hs.maker_team = current_player % 2;
+                    hs.maker_player = current_player;
+                    trump_made();
+                }
+                else if (current_player == state.dealer) {
+                    hs.phase = Phase::BidRound2;
+                    hs.current_player = get_next_player(current_player);
+                }
+                else {
+                    hs.current_player = get_next_player(current_player);
+                }
+                break;
 
-        uint8_t current_player = state.dealer;
+            case Phase::GoAloneDecision:
+                if (action == euchre::action::GoAloneYes) {
+                    hs.going_alone = true;
+                    if constexpr (Rules.defend_alone) {
+                        // Each defender in turn may take on the lone maker alone.
+                        hs.phase = Phase::DefendAloneDecision;
+                        hs.current_player = static_cast<uint8_t>((hs.maker_player + 1) % euchre::constants::num_players);
+                        break;
+                    }
+                }
+                dealer_picks_up();
+                break;
 
-        do {
-            current_player = (current_player + 1) % euchre::constants::num_players;
-            
-            
-            if (current_player == state.dealer && state.hand_state.stick_the_dealer) {
-                action_mask &= ~euchre::action::a2m(euchre::action::Pass);
+            case Phase::DefendAloneDecision:
+                if (action == euchre::action::DefendAloneYes) {
+                    hs.defending_alone = true;
+                    hs.defender_player = current_player;
+                    dealer_picks_up();
+                }
+                else if (current_player == (hs.maker_player + 1) % euchre::constants::num_players) {
+                    hs.current_player = static_cast<uint8_t>((hs.maker_player + 3) % euchre::constants::num_players);
+                }
+                else {
+                    dealer_picks_up();
+                }
+                break;
+
+            case Phase::FarmerSwap:
+                if (action == euchre::action::FarmerSwapYes) {
+                    // Take the whole kitty, then discard as many cards one at a time.
+                    hs.hands[current_player] = Hand{hs.hands[current_player].value() | hs.deck};
+                    hs.deck = 0;
+                    hs.phase = Phase::FarmerDiscard;
+                }
+                else {
+                    start_bidding();
+                }
+                break;
+
+            case Phase::FarmerDiscard: {
+                Card c = discarded_card(action);
+                hs.hands[current_player].remove_card(c);
+                hs.deck |= 1u << c;
+                if (hs.hands[current_player].num_cards() == 5) {
+                    start_bidding();
+                }
+                break;
             }
 
-            ActionId action = request_action(current_player, action_mask);
-            
+            case Phase::DealerPickupDiscard: {
+                Card c = discarded_card(action);
+                hs.hands[current_player].remove_card(c);
+                hs.phase = Phase::PlayTrick;
+                hs.lead_player = get_next_player(state.dealer);
+                hs.current_player = hs.lead_player;
+                break;
+            }
 
-            if (action != euchre::action::Pass) {
-                state.hand_state.trump = Suit(action.v - euchre::action::CallTrumpBase.v);
-                state.hand_state.maker_player = current_player;
-                state.hand_state.maker_team = current_player % 2;
-                state.hand_state.phase = Phase::GoAloneDecision;
-                return;
+            case Phase::BidRound2:
+                if (action != euchre::action::Pass) {
+                    hs.trump = Suit(action.v - euchre::action::CallTrumpBase.v);
+                    hs.maker_player = current_player;
+                    hs.maker_team = current_player % 2;
+                    trump_made();
+                }
+                else if (current_player == state.dealer) {
+                    // Everyone passed. Redeal, or pass the deal on.
+                    hs.reset();
+                    if constexpr (Rules.all_pass == euchre::rules::AllPass::PassTheDeal) {
+                        state.dealer = static_cast<uint8_t>((state.dealer + 1) % euchre::constants::num_players);
+                    }
+                }
+                else {
+                    hs.current_player = get_next_player(current_player);
+                }
+                break;
+
+            case Phase::PlayTrick: {
+                Card c = joker ? euchre::action::played_card(action) : Card{static_cast<uint8_t>(action.v)};
+                hs.hands[current_player].remove_card(c);
+                hs.record_play(current_player, c);
+                if (hs.num_played == 0) {
+                    // In this case we need to set the lead card.
+                    hs.lead_card = c;
+                }
+                // Set the trick cards, increment the count.
+                hs.trick_cards[current_player] = c;
+                hs.num_played++;
+                hs.current_player = get_next_player(current_player);
+
+                if (hs.current_player == hs.lead_player) {
+                    finish_trick();
+                }
+                break;
             }
-        } while (current_player != state.dealer);
 
-        // Everyone passed. Redeal.
-        state.hand_state.reset();
+            default:
+                throw std::logic_error("Phase has no decision to apply");
+        }
     }
 
-    void request_tricks() {
-         bool first_card = true;
-         uint8_t current_player = state.hand_state.lead_player;
-      
-        do {
-            ActionMask action_mask {};
-            if (first_card) {
-                action_mask = static_cast<ActionMask>(state.hand_state.hands[current_player].value());
-            }
-            else {
-                action_mask = state.hand_state.hands[current_player].get_valid_hand(state.hand_state.lead_card, state.hand_state.trump);
-            }
+    /**
+     * @brief Goes through the first euchre bidding round.
+     *
+     * Each player has the opportunity to tell the dealer to pick up the card, and go alone.
+     */
+    void bid_round_1() {
+        run_decisions();
+    }
 
-            ActionId action = request_action(current_player, action_mask);
-            Card c {static_cast<uint8_t>(action.v)};
-            state.hand_state.hands[current_player].remove_card(c);
-            if (first_card) {
-                // In this case we need to set the lead card.
-                state.hand_state.lead_card = c;
-                first_card = false;
-            }
-            // Set the trick cards, increment the count.
-            state.hand_state.trick_cards[current_player] = c;
-            state.hand_state.num_played++;
-            current_player = get_next_player(current_player);
+    void dealer_pickup_discard() {
+        run_decisions();
+    }
 
-        } while(current_player != state.hand_state.lead_player);
+    void go_alone_decision() {
+        run_decisions();
     }
 
-    void calc_winner() {
-        auto& t = euchre::tables::tables();
-        Suit led_suit = t.eff_suit_tbl[state.hand_state.trump][state.hand_state.lead_card];
-        uint8_t winner = 0;
-        uint8_t best_power = 0;
-        Suit trump = state.hand_state.trump;
-        for (uint8_t i = 0; i < euchre::constants::num_players; i++) {
-            // Skip the entry for the skipped partner.
-            if (state.hand_state.going_alone && i == (state.hand_state.maker_player + 2 ) % euchre::constants::num_players) {
-                continue;
-            }
-            
-            uint8_t power = t.power[trump][led_suit][state.hand_state.trick_cards[i]];
-            if (power > best_power) {
-                best_power = power;
-                winner = i;
-            }
+    void bid_round_2() {
+        run_decisions();
+    }
 
+    void calc_winner() {
+        uint8_t winner;
+        if constexpr (Rules.defend_alone) {
+            winner = euchre::rules::trick_winner(state.hand_state.trick_cards, state.hand_state.trump,
+                                                 state.hand_state.lead_card, sitting_out(), deck_tables());
+        }
+        else {
+            winner = euchre::rules::trick_winner(state.hand_state.trick_cards, state.hand_state.trump,
+                                                 state.hand_state.lead_card, going_alone(),
+                                                 state.hand_state.maker_player);
         }
 
         state.hand_state.tricks_won[winner % 2]++;
@@ -197,40 +393,22 @@ class Env {
     }
 
     void play_trick() {
-
-        if (state.hand_state.tricks_played == 0) {
-            state.hand_state.lead_player = get_next_player(state.dealer);
+        uint8_t tricks_played = state.hand_state.tricks_played;
+        while (state.hand_state.phase == Phase::PlayTrick && state.hand_state.tricks_played == tricks_played) {
+            uint8_t player = state.hand_state.current_player;
+            apply_action(request_action(player, legal_actions()));
         }
-        request_tricks();
-        calc_winner();
-        state.hand_state.tricks_played++;
-        state.hand_state.lead_card = euchre::constants::invalid_card;
-        
-
-        if (state.hand_state.tricks_played == 5) {
-            state.hand_state.phase = Phase::HandOver;
-        }
-
-        state.hand_state.num_played = 0;
-        
     }
 
     void hand_over() {
-        
-        uint8_t maker_team = state.hand_state.maker_team;
+
         uint8_t maker_tricks = state.hand_state.tricks_won[state.hand_state.maker_team];
-        uint8_t defender_team = 1 - state.hand_state.maker_team;
 
         // Score
-        if (maker_tricks == 5) {
-            state.scores[maker_team] += state.hand_state.going_alone ? 4 : 2;
-        }
-        else if (maker_tricks >= 3) {
-            state.scores[maker_team] += 1;
-        }
-        else {
-            state.scores[defender_team] += 2;
-        }
+        auto score = euchre::rules::score_hand(state.hand_state.maker_team, maker_tricks, going_alone(),
+                                               Rules.lone_march_points, defending_alone(),
+                                               Rules.lone_defense_points);
+        state.scores[score.team] += score.points;
 
         // Rotate dealer
         state.dealer = (state.dealer + 1) % euchre::constants::num_players;
@@ -257,6 +435,11 @@ class Env {
             case Phase::BidRound2:
                 bid_round_2();
                 break;
+            case Phase::DefendAloneDecision:
+            case Phase::FarmerSwap:
+            case Phase::FarmerDiscard:
+                run_decisions();
+                break;
             case Phase::PlayTrick:
                 play_trick();
                 break;
@@ -270,12 +453,240 @@ class Env {
 
     void step_game() {
         step_hand();
-        if (state.scores[0] >= 10 || state.scores[1] >= 10) {
-            state.status = GameState::GameStatus::GameOver;
+        update_status();
+    }
+
+    /**
+     * @brief The bot in a seat, for calls off the decision path such as on_new_match().
+     */
+    IBot* bot(uint8_t seat) const {
+        if constexpr (dynamic) {
+            return players[seat];
+        }
+        else {
+            switch (seat) {
+                case 0: return std::get<0>(players);
+                case 1: return std::get<1>(players);
+                case 2: return std::get<2>(players);
+                default: return std::get<3>(players);
+            }
         }
     }
 
     GameState state;
-    std::array<IBot*, 4> players;
+    Players players;
+
+    private:
+
+    static constexpr bool dynamic = std::same_as<Players, std::array<IBot*, 4>>;
+    static constexpr bool joker = Rules.deck.joker;
+
+    // Decisions since the last audit of a trusted env.
+    uint32_t unaudited = 0;
+
+    /**
+     * @brief Validate an action against its mask at the level Checks asks for.
+     */
+    void check_action(ActionId action, ActionMask action_mask) {
+        using euchre::validation::Level;
+        if constexpr (Checks.level == Level::Full) {
+            if (!euchre::action::in_mask(action, action_mask)) {
+                throw std::invalid_argument("Returned action_id did not match the action mask");
+            }
+        }
+        else if constexpr (Checks.level == Level::Debug) {
+            assert(euchre::action::in_mask(action, action_mask));
+        }
+        else if constexpr (Checks.audit_every > 0) {
+            if (++unaudited == Checks.audit_every) {
+                unaudited = 0;
+                if (!euchre::action::in_mask(action, action_mask)) {
+                    throw std::invalid_argument("Audited action_id did not match the action mask");
+                }
+            }
+        }
+    }
+
+    /**
+     * @brief The tables of the deck in play.
+     */
+    static const euchre::tables::Tables& deck_tables() {
+        return euchre::tables::tables<Rules.deck>();
+    }
+
+    /**
+     * @brief Play and discard masks of a card set. Only a deck with a Joker needs the remapping.
+     */
+    static ActionMask play_actions(uint32_t cards) {
+        if constexpr (joker) {
+            return euchre::action::play_mask(cards);
+        }
+        else {
+            return cards;
+        }
+    }
+
+    static ActionMask discard_actions(uint32_t cards) {
+        if constexpr (joker) {
+            return euchre::action::discard_mask(cards);
+        }
+        else {
+            return static_cast<ActionMask>(cards) << euchre::constants::num_cards;
+        }
+    }
+
+    static Card discarded_card(ActionId action) {
+        if constexpr (joker) {
+            return euchre::action::discarded_card(action);
+        }
+        else {
+            return Card{static_cast<uint8_t>(action.v - euchre::constants::num_cards)};
+        }
+    }
+
+    ActionId select_action(uint8_t player, const Observation& obs, ActionMask action_mask) {
+        if constexpr (dynamic) {
+            return players[player]->select_action(obs, action_mask);
+        }
+        else {
+            switch (player) {
+                case 0: return std::get<0>(players)->select_action(obs, action_mask);
+                case 1: return std::get<1>(players)->select_action(obs, action_mask);
+                case 2: return std::get<2>(players)->select_action(obs, action_mask);
+                default: return std::get<3>(players)->select_action(obs, action_mask);
+            }
+        }
+    }
+
+    /**
+     * @brief Ask the bots for decisions until the current phase is left.
+     */
+    void run_decisions() {
+        Phase phase = state.hand_state.phase;
+        while (state.hand_state.phase == phase) {
+            uint8_t player = state.hand_state.current_player;
+            apply_action(request_action(player, legal_actions()));
+        }
+    }
+
+    /**
+     * @brief Whether the maker plays alone; always false when the rules have no loners.
+     */
+    bool going_alone() const {
+        return Rules.going_alone && state.hand_state.going_alone;
+    }
+
+    /**
+     * @brief Whether a defender plays alone; always false when the rules do not allow it.
+     */
+    bool defending_alone() const {
+        return Rules.defend_alone && state.hand_state.defending_alone;
+    }
+
+    uint8_t sitting_out() const {
+        const HandState& hs = state.hand_state;
+        return euchre::rules::sitting_out_mask(going_alone(), hs.maker_player, defending_alone(), hs.defender_player);
+    }
+
+    bool stick_the_dealer() const {
+        if constexpr (Rules.stick_the_dealer == euchre::rules::StickTheDealer::HandFlag) {
+            return state.hand_state.stick_the_dealer;
+        }
+        else {
+            return Rules.stick_the_dealer == euchre::rules::StickTheDealer::On;
+        }
+    }
+
+    /**
+     * @brief Trump was just made: ask about going alone, or go straight to the pickup without loners.
+     */
+    void trump_made() {
+        if constexpr (Rules.going_alone) {
+            state.hand_state.phase = Phase::GoAloneDecision;
+        }
+        else {
+            dealer_picks_up();
+        }
+    }
+
+    /**
+     * @brief Open the bidding left of the dealer. A turned up Joker skips round 1: there is no suit to order up.
+     */
+    void start_bidding() {
+        HandState& hs = state.hand_state;
+        hs.phase = (joker && hs.face_up_card.is_joker()) ? Phase::BidRound2 : Phase::BidRound1;
+        hs.current_player = static_cast<uint8_t>((state.dealer + 1) % euchre::constants::num_players);
+    }
+
+    /**
+     * @brief Give the first farmer's hand left of the dealer the chance to swap with the kitty.
+     *
+     * @return bool True if a seat holds a farmer's hand and the game now waits on its decision.
+     */
+    bool offer_farmers_hand() {
+        HandState& hs = state.hand_state;
+        for (uint8_t i = 1; i <= euchre::constants::num_players; i++) {
+            auto seat = static_cast<uint8_t>((state.dealer + i) % euchre::constants::num_players);
+            if (euchre::rules::is_farmers_hand(hs.hands[seat].value())) {
+                hs.phase = Phase::FarmerSwap;
+                hs.current_player = seat;
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void dealer_picks_up() {
+        HandState& hs = state.hand_state;
+        hs.phase = Phase::DealerPickupDiscard;
+        hs.current_player = state.dealer;
+        hs.hands[state.dealer].give_card(hs.face_up_card);
+    }
+
+    void finish_trick() {
+        calc_winner();
+        state.hand_state.current_player = state.hand_state.lead_player;
+        state.hand_state.tricks_played++;
+        state.hand_state.lead_card = euchre::constants::invalid_card;
+
+        if (state.hand_state.tricks_played == 5) {
+            state.hand_state.phase = Phase::HandOver;
+        }
+
+        state.hand_state.num_played = 0;
+    }
+
+    void update_status() {
+        if (state.scores[0] >= Rules.target_score || state.scores[1] >= Rules.target_score) {
+            state.status = GameState::GameStatus::GameOver;
+        }
+    }
+
+    /**
+     * @brief Run the phases that need no decision (dealing, scoring) until a player must act.
+     */
+    void advance_to_decision() {
+        while (state.status != GameState::GameStatus::GameOver) {
+            if (state.hand_state.phase == Phase::Deal) {
+                deal();
+            }
+            else if (state.hand_state.phase == Phase::HandOver) {
+                hand_over();
+                update_status();
+            }
+            else {
+                break;
+            }
+        }
+    }
+
+};
+
+using Env = BasicEnv<IBot, IBot, IBot, IBot>;
 
-};
\ No newline at end of file
+/**
+ * @brief An env whose seats are the given concrete bots, sealed with StaticBot so decisions bind statically.
+ */
+template <typename Bot0, typename Bot1, typename Bot2, typename Bot3, euchre::rules::RuleSet Rules = euchre::rules::RuleSet{},
+          euchre::validation::Policy Checks = euchre::validation::Policy{}>
+using StaticEnv = BasicEnv<StaticBot<Bot0>, StaticBot<Bot1>, StaticBot<Bot2>, StaticBot<Bot3>, Rules, Checks>;
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "Action.hpp"
+#include "Card.hpp"
+#include "Defns.hpp"
+#include "Hand.hpp"
+#include "Observation.hpp"
+#include "Phase.hpp"
+#include <cstdint>
+#include "Rng.hpp"
+#include <span>
+#include <vector>
+
+using euchre::action::ActionId;
+using euchre::action::ActionMask;
+
+/**
+ * @brief A pool of independent games stored as structure-of-arrays.
+ *
+ * Unlike Env, EnvBatch never calls a bot. Every game in the pool is always parked at a decision point,
+ * and step_batch() applies exactly one action per game, then advances each game to its next decision.
+ * Finished games are restarted in place with a fresh seed, so the pool never runs dry.
+ *
+ * Per-seat arrays are indexed [game * num_players + seat], per-team arrays [game * 2 + team].
+ * Game slot g starts with seed `seed + g`, so with seed 0 the first games played match `Env{g, ...}`.
+ */
+class EnvBatch {
+    public:
+
+    EnvBatch(std::size_t count, uint32_t seed);
+
+    std::size_t size() const { return num_games; }
+
+    /**
+     * @brief Restart every game from the base seed and advance them to their first decision.
+     */
+    void reset();
+
+    /**
+     * @brief Apply one action to every game and advance each game to its next decision.
+     *
+     * After the call, masks/current_player describe the new decisions, rewards hold the points
+     * each team scored during this step and dones flags the games that ended (and were restarted).
+     *
+     * @param actions One action per game.
+     * @throws std::invalid_argument when an action is not in its game's legal mask; no game is stepped.
+     */
+    void step_batch(std::span<const ActionId> actions);
+
+    /**
+     * @brief Build the observation for the player to act in a game.
+     */
+    Observation observation(std::size_t game) const;
+
+    /**
+     * @brief Build the observations for every game in the pool.
+     */
+    void observations(std::span<Observation> out) const;
+
+    bool stick_the_dealer = false;
+
+    // Decision outputs.
+    std::vector<ActionMask> masks;
+    std::vector<uint8_t>    current_player;
+    std::vector<int8_t>     rewards;
+    std::vector<uint8_t>    dones;
+
+    // Per-game state.
+    std::vector<Hand>       hands;
+    std::vector<Card>       trick_cards;
+    std::vector<uint32_t>   played_by;
+    std::vector<uint8_t>    void_suits;
+    std::vector<uint8_t>    tricks_won;
+    std::vector<uint8_t>    scores;
+    std::vector<uint8_t>    dealer;
+    std::vector<Phase>      phase;
+    std::vector<uint32_t>   deck;
+    std::vector<Card>       face_up_card;
+    std::vector<Suit>       trump;
+    std::vector<Card>       lead_card;
+    std::vector<uint8_t>    maker_player;
+    std::vector<uint8_t>    going_alone;
+    std::vector<uint8_t>    lead_player;
+    std::vector<uint8_t>    num_played;
+    std::vector<uint8_t>    tricks_played;
+    std::vector<uint32_t>   game_seed;
+    std::vector<uint32_t>   hands_dealt;
+    std::vector<euchre::rng::Philox4x32> eng;
+
+    private:
+
+    void reset_game(std::size_t game, uint32_t game_seed);
+    void reset_hand(std::size_t game);
+    void deal(std::size_t game);
+    void hand_over(std::size_t game);
+    void apply(std::size_t game, ActionId action);
+    void advance(std::size_t game);
+    ActionMask legal_mask(std::size_t game) const;
+
+    std::size_t num_games;
+    uint32_t base_seed;
+    uint32_t next_seed;
+};
@@ -0,0 +1,119 @@
+#pragma once
+
+#include "Card.hpp"
+#include "Hand.hpp"
+#include "HandIndexer.hpp"
+#include "MappedFile.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+class WorkerPool;
+
+/**
+ * @brief Settings for one EquityTable::generate() run.
+ *
+ * Every process that shares a table must use the same rollouts and seed; shard picks which
+ * chunks this process fills, chunk c belonging to shard c % num_shards.
+ */
+struct EquityConfig {
+    // Deals simulated per key; each deal is played out once per bid.
+    uint32_t rollouts = 256;
+    uint32_t seed = 0;
+    uint32_t shard = 0;
+    uint32_t num_shards = 1;
+};
+
+/**
+ * @brief Simulated value of ordering up, calling and going alone for every bidding position.
+ *
+ * A key is a hand and face up card up to suit isomorphism (HandIndexer, relative to the suit being
+ * made trump) and the bidder's seat relative to the dealer. When the upcard is of the trump suit
+ * the key is a first round order up, otherwise a second round call with the upcard turned down.
+ * Each key holds the mean points (own team minus opponents) the bidder's team nets on the hand
+ * after passing, making trump, or making trump alone.
+ *
+ * The values come from rollouts: the other hands are dealt at random, earlier seats must pass
+ * under HeuristicBot (as they did to reach the decision), and every seat plays the rest of the
+ * hand as HeuristicBot. Each key draws its deals from its own Philox stream, so a value does not
+ * depend on the thread, process or run that computed it.
+ *
+ * The file is a header, one done flag per chunk of keys and a flat float array, so a lookup is one
+ * load from the mapping. generate() fills chunks in place and sets each flag once its values are
+ * written, which makes runs resumable; shards written by separate processes are combined with
+ * merge(). Keys whose chunk has not been generated yet look up as empty.
+ */
+class EquityTable {
+    public:
+
+    enum Bid : uint8_t {
+        Pass,
+        Make,
+        Alone,
+    };
+
+    static constexpr std::size_t num_bids = 3;
+    using Values = std::array<float, num_bids>;
+
+    static constexpr uint32_t num_seats = 4;
+    static constexpr uint32_t num_keys = HandIndexer::num_upcard_hands * num_seats;
+    // Hand indices per chunk; a chunk holds every seat of each.
+    static constexpr uint32_t chunk_hands = 256;
+    static constexpr uint32_t chunk_keys = chunk_hands * num_seats;
+    static constexpr uint32_t num_chunks = (HandIndexer::num_upcard_hands + chunk_hands - 1) / chunk_hands;
+
+    /**
+     * @brief Map a file written by generate() or merge(), complete or not.
+     *
+     * @throws std::runtime_error if the file is missing or not an equity table.
+     */
+    explicit EquityTable(const std::string& path);
+
+    /**
+     * @brief Fill this shard's missing chunks of the table at path, creating the file if needed.
+     *
+     * Each chunk is written and flagged before the next one starts, so an interrupted run picks
+     * up where it stopped. Runs for different shards may target the same file one after another.
+     *
+     * @return The number of chunks computed by this call.
+     * @throws std::invalid_argument for a bad config, or a file made with other rollouts or seed.
+     * @throws std::runtime_error if the file cannot be read or written.
+     */
+    static std::size_t generate(const std::string& path, const EquityConfig& config, WorkerPool* pool = nullptr);
+
+    /**
+     * @brief Combine shard files with the same settings into one table at path.
+     *
+     * @throws std::invalid_argument if the inputs are empty or were made with different settings.
+     * @throws std::runtime_error if an input is not an equity table or the output cannot be written.
+     */
+    static void merge(const std::vector<std::string>& inputs, const std::string& path);
+
+    /**
+     * @brief The key of a bidder holding hand, with upcard face up, considering trump.
+     *
+     * @param seat The bidder's seat relative to the dealer: 0 is the dealer, 1 bids first.
+     */
+    static uint32_t key(Hand hand, Suit trump, Card upcard, uint8_t seat) {
+        return HandIndexer::index(hand, trump, upcard) * num_seats + seat;
+    }
+
+    /**
+     * @brief The values of a key, or nullopt if its chunk has not been generated.
+     */
+    std::optional<Values> lookup(uint32_t key) const;
+
+    uint32_t rollouts() const { return num_rollouts; }
+    std::size_t chunks_done() const;
+    bool complete() const { return chunks_done() == num_chunks; }
+
+    private:
+
+    MappedFile file;
+    uint32_t num_rollouts = 0;
+    const uint8_t* done = nullptr;
+    const uint8_t* values = nullptr;
+};
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <new>
+#include <vector>
+
+/**
+ * @brief A thread-local free-list allocator for coroutine frames.
+ *
+ * Frames are rounded up to a 64 byte size class and recycled through a per-class free list. The
+ * global heap is only touched when a class runs dry and a new chunk is carved, so a warmed-up pool
+ * serves every suspend/resume cycle without allocating. Frames must be freed on the thread that
+ * allocated them.
+ */
+class FramePool {
+    public:
+
+    static constexpr std::size_t block_align = 64;
+    static constexpr std::size_t num_classes = 64;          // Frames up to 4 KiB are pooled.
+    static constexpr std::size_t blocks_per_chunk = 32;
+
+    static FramePool& local() {
+        thread_local FramePool pool;
+        return pool;
+    }
+
+    void* allocate(std::size_t n) {
+        std::size_t cls = size_class(n);
+        if (cls >= num_classes) {
+            return ::operator new(n);
+        }
+
+        FreeBlock* block = free_lists[cls];
+        if (block == nullptr) {
+            refill(cls);
+            block = free_lists[cls];
+        }
+        free_lists[cls] = block->next;
+        live_blocks++;
+        return block;
+    }
+
+    void deallocate(void* p, std::size_t n) noexcept {
+        std::size_t cls = size_class(n);
+        if (cls >= num_classes) {
+            ::operator delete(p);
+            return;
+        }
+
+        FreeBlock* block = static_cast<FreeBlock*>(p);
+        block->next = free_lists[cls];
+        free_lists[cls] = block;
+        live_blocks--;
+    }
+
+    /**
+     * @brief Number of chunks carved from the global heap so far.
+     */
+    std::size_t chunks_allocated() const { return chunks.size(); }
+
+    /**
+     * @brief Number of frames currently handed out.
+     */
+    std::size_t frames_in_use() const { return live_blocks; }
+
+    private:
+
+    struct FreeBlock {
+        FreeBlock* next;
+    };
+
+    struct ChunkDeleter {
+        void operator()(std::byte* p) const noexcept {
+            ::operator delete[](p, std::align_val_t{block_align});
+        }
+    };
+
+    static constexpr std::size_t size_class(std::size_t n) {
+        return (n + block_align - 1) / block_align - 1;
+    }
+
+    void refill(std::size_t cls) {
+        std::size_t block_size = (cls + 1) * block_align;
+        std::byte* chunk = static_cast<std::byte*>(
+            ::operator new[](block_size * blocks_per_chunk, std::align_val_t{block_align}));
+        chunks.emplace_back(chunk);
+
+        for (std::size_t i = 0; i < blocks_per_chunk; i++) {
+            FreeBlock* block = reinterpret_cast<FreeBlock*>(chunk + i * block_size);
+            block->next = free_lists[cls];
+            free_lists[cls] = block;
+        }
+    }
+
+    FreeBlock* free_lists[num_classes] = {};
+    std::vector<std::unique_ptr<std::byte, ChunkDeleter>> chunks;
+    std::size_t live_blocks = 0;
+};
@@ -0,0 +1,179 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <type_traits>
+#include "Defns.hpp"
+#include "GameState.hpp"
+
+/**
+ * @brief A packed copy of a GameState that fits in one cache line.
+ *
+ * Each card is stored as a 5 bit location (a seat's hand, the deck, or the trick and seat it was
+ * played in), which covers the hands, the kitty and the public history at once. Flags share a byte
+ * and the engine is kept as its key only: every deal seeks to (hands_dealt, 0), so the key and
+ * hands_dealt fully determine the rest of the game. Copying one is a single 64 byte memcpy.
+ */
+struct alignas(64) GameSnapshot {
+    // 25 locations of 5 bits, plus a spare byte so set_location() can always touch two bytes.
+    std::array<uint8_t, 17> locations {};
+    std::array<Card, 4> trick_cards {};
+    Card        face_up_card {};
+    Card        lead_card {};
+    Suit        trump = Suit::None;
+    Phase       phase = Phase::Deal;
+    uint8_t     flags = 0;
+    uint8_t     maker_player = 0;
+    uint8_t     lead_player = 0;
+    uint8_t     current_player = 0;
+    uint8_t     num_played = 0;
+    uint8_t     tricks_played = 0;
+    std::array<uint8_t, 2> tricks_won {};
+    uint8_t     dealer = 0;
+    uint8_t     defender_player = 0;
+    std::array<uint8_t, 2> scores {};
+    // Four void suit bits per seat.
+    uint16_t    void_suits = 0;
+    uint32_t    hands_dealt = 0;
+    std::array<uint32_t, 2> key {};
+
+    static constexpr uint8_t maker_team_flag = 1u << 0;
+    static constexpr uint8_t going_alone_flag = 1u << 1;
+    static constexpr uint8_t stick_the_dealer_flag = 1u << 2;
+    static constexpr uint8_t game_over_flag = 1u << 3;
+    static constexpr uint8_t defending_alone_flag = 1u << 4;
+
+    // Card locations: 0-3 a seat's hand, 4 + 4 * trick + seat played, then the deck or nowhere
+    // (discarded, or the face up card before anyone picks it up).
+    static constexpr uint8_t in_deck = 24;
+    static constexpr uint8_t nowhere = 25;
+
+    static GameSnapshot from_state(const GameState& gs) {
+        const HandState& hs = gs.hand_state;
+        GameSnapshot s;
+        for (uint8_t c = 0; c < euchre::constants::max_cards; c++) {
+            uint8_t where = (hs.deck >> c) & 1u ? in_deck : nowhere;
+            for (uint8_t p = 0; p < euchre::constants::num_players; p++) {
+                if (hs.hands[p].hand_has(Card{c})) {
+                    where = p;
+                }
+            }
+            s.set_location(c, where);
+        }
+        for (uint8_t t = 0; t < 5; t++) {
+            for (uint8_t p = 0; p < euchre::constants::num_players; p++) {
+                Card c = hs.trick_history[t][p];
+                if (c.v != euchre::constants::invalid_card) {
+                    s.set_location(c, static_cast<uint8_t>(4 + 4 * t + p));
+                }
+            }
+        }
+        s.trick_cards = hs.trick_cards;
+        s.face_up_card = hs.face_up_card;
+        s.lead_card = hs.lead_card;
+        s.trump = hs.trump;
+        s.phase = hs.phase;
+        s.flags = static_cast<uint8_t>((hs.maker_team ? maker_team_flag : 0) |
+                                       (hs.going_alone ? going_alone_flag : 0) |
+                                       (hs.stick_the_dealer ? stick_the_dealer_flag : 0) |
+                                       (hs.defending_alone ? defending_alone_flag : 0) |
+                                       (gs.status == GameState::GameStatus::GameOver ? game_over_flag : 0));
+        s.maker_player = hs.maker_player;
+        s.defender_player = hs.defender_player;
+        s.lead_player = hs.lead_player;
+        s.current_player = hs.current_player;
+        s.num_played = hs.num_played;
+        s.tricks_played = hs.tricks_played;
+        s.tricks_won = {hs.tricks_won[0], hs.tricks_won[1]};
+        s.dealer = gs.dealer;
+        s.scores = {gs.scores[0], gs.scores[1]};
+        for (uint8_t p = 0; p < euchre::constants::num_players; p++) {
+            s.void_suits = static_cast<uint16_t>(s.void_suits | (hs.void_suits[p] << (4 * p)));
+        }
+        s.hands_dealt = gs.hands_dealt;
+        s.key = gs.eng.get_key();
+        return s;
+    }
+
+    /**
+     * @brief Overwrite gs with this snapshot. The engine is re-keyed; the next deal is unchanged.
+     */
+    void restore(GameState& gs) const {
+        HandState& hs = gs.hand_state;
+        for (auto& h : hs.hands) {
+            h = Hand{};
+        }
+        hs.deck = 0;
+        hs.played = 0;
+        hs.played_by = {};
+        for (auto& trick : hs.trick_history) {
+            trick.fill(Card{});
+        }
+        for (uint8_t c = 0; c < euchre::constants::max_cards; c++) {
+            uint8_t where = location(c);
+            if (where < 4) {
+                hs.hands[where].give_card(Card{c});
+            }
+            else if (where < in_deck) {
+                auto p = static_cast<uint8_t>((where - 4u) % 4u);
+                hs.trick_history[(where - 4u) / 4u][p] = Card{c};
+                hs.played |= 1u << c;
+                hs.played_by[p] |= 1u << c;
+            }
+            else if (where == in_deck) {
+                hs.deck |= 1u << c;
+            }
+        }
+        for (uint8_t p = 0; p < euchre::constants::num_players; p++) {
+            hs.void_suits[p] = static_cast<uint8_t>((void_suits >> (4 * p)) & 0xF);
+        }
+        hs.trick_cards = trick_cards;
+        hs.face_up_card = face_up_card;
+        hs.lead_card = lead_card;
+        hs.trump = trump;
+        hs.phase = phase;
+        hs.maker_team = (flags & maker_team_flag) ? 1 : 0;
+        hs.going_alone = (flags & going_alone_flag) != 0;
+        hs.stick_the_dealer = (flags & stick_the_dealer_flag) != 0;
+        hs.defending_alone = (flags & defending_alone_flag) != 0;
+        hs.defender_player = defender_player;
+        hs.maker_player = maker_player;
+        hs.lead_player = lead_player;
+        hs.current_player = current_player;
+        hs.num_played = num_played;
+        hs.tricks_played = tricks_played;
+        hs.tricks_won[0] = tricks_won[0];
+        hs.tricks_won[1] = tricks_won[1];
+        gs.status = (flags & game_over_flag) ? GameState::GameStatus::GameOver : GameState::GameStatus::InProgress;
+        gs.dealer = dealer;
+        gs.scores[0] = scores[0];
+        gs.scores[1] = scores[1];
+        gs.hands_dealt = hands_dealt;
+        gs.eng.seed(key[0], key[1]);
+    }
+
+    bool operator==(const GameSnapshot&) const = default;
+
+    GameState to_state() const {
+        GameState gs;
+        restore(gs);
+        return gs;
+    }
+
+    uint8_t location(uint8_t card) const {
+        unsigned bit = 5u * card;
+        unsigned word = locations[bit / 8] | (unsigned{locations[bit / 8 + 1]} << 8);
+        return static_cast<uint8_t>((word >> (bit % 8)) & 0x1Fu);
+    }
+
+    private:
+    void set_location(uint8_t card, uint8_t where) {
+        unsigned bit = 5u * card;
+        unsigned word = locations[bit / 8] | (unsigned{locations[bit / 8 + 1]} << 8);
+        word = (word & ~(0x1Fu << (bit % 8))) | (unsigned{where} << (bit % 8));
+        locations[bit / 8] = static_cast<uint8_t>(word);
+        locations[bit / 8 + 1] = static_cast<uint8_t>(word >> 8);
+    }
+};
+
+static_assert(std::is_trivially_copyable_v<GameSnapshot>);
+static_assert(sizeof(GameSnapshot) == 64);
@@ -2,7 +2,7 @@
 
 #include "Card.hpp"
 #include "Defns.hpp"
-#include <random>
+#include "Rng.hpp"
 #include "HandState.hpp"
 
 
@@ -17,6 +17,7 @@ class GameState {
 
     void reset_game(unsigned int seed) {
         eng.seed(seed);
+        hands_dealt = 0;
     }
 
     enum class GameStatus : uint8_t {
@@ -28,6 +29,8 @@ class GameState {
     uint8_t dealer = 0;
     uint8_t scores[2] {};
     HandState hand_state;
-    std::mt19937 eng;
+    // Deal k of hand h is a pure function of (seed, h, k): every deal seeks to (hands_dealt, 0).
+    euchre::rng::Philox4x32 eng;
+    uint32_t hands_dealt = 0;
 
 };
\ No newline at end of file
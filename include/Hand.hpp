@@ -22,13 +22,13 @@ struct Hand {
     }
 
     constexpr void give_card(Card c) {
-        assert(c.v < 24);
+        EUCHRE_ASSERT(c.v < euchre::constants::max_cards);
         h |= (1u << c.v);
     }
 
     constexpr void remove_card(Card c) {
-        assert(c.v < 24);
-        assert(hand_has(c));
+        EUCHRE_ASSERT(c.v < euchre::constants::max_cards);
+        EUCHRE_ASSERT(hand_has(c));
         h &= ~(1u << c.v);
     }
 
@@ -36,8 +36,10 @@ struct Hand {
         give_card({s, r});
     }
 
-    uint32_t get_valid_hand(Card led, Suit trump) const {
-        const auto& tables = euchre::tables::tables();
+    /**
+     * @brief The cards this hand may play to a trick led with `led`; pass the deck's tables when it has a Joker.
+     */
+    uint32_t get_valid_hand(Card led, Suit trump, const euchre::tables::Tables& tables = euchre::tables::tables()) const {
 
         Suit effective_led_suit = tables.eff_suit_tbl[trump][led];
         uint32_t follow = h & tables.suit_mask_tbl[trump][effective_led_suit];
@@ -46,18 +48,18 @@ struct Hand {
         return follow ? follow : h;
     }
 
-    bool hand_has(Card c) {
+    constexpr bool hand_has(Card c) const {
         return ((1u << c.v) & h) > 0;
     }
 
-    inline constexpr void show_hand() {
+    inline void show_hand() {
         uint32_t hand = h;
         while(hand) {
             uint32_t bit = hand & -hand;
             int idx = std::countr_zero<uint32_t>(bit);
             //assert((hand & ~euchre::constants::deck_reset) == 0 && "hand has bits outside 0..23");
 
-            assert(idx < 24);
+            assert(idx < euchre::constants::max_cards);
             Card c(static_cast<uint8_t>(idx));
             std::cout << c << "\t";
             hand &= (hand - 1);
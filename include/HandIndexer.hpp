@@ -0,0 +1,289 @@
+#pragma once
+
+#include "Card.hpp"
+#include "Defns.hpp"
+#include "Hand.hpp"
+#include "Tables.hpp"
+#include <array>
+#include <bit>
+#include <cassert>
+#include <cstdint>
+
+namespace euchre::tables {
+
+    /**
+     * Cards are laid out in a frame relative to trump: bits 0-6 are the trumps from the right
+     * bower down, 7-11 the rest of trump's same colour suit, 12-17 and 18-23 the two other suits.
+     * The two other suits are interchangeable, which is the only symmetry left once trump is fixed.
+     */
+    inline constexpr uint32_t frame_next = 7;
+    inline constexpr uint32_t frame_cross = 12;
+    inline constexpr uint32_t frame_cross_b = 18;
+    inline constexpr std::size_t max_hand_size = 5;
+
+    struct IndexerTables {
+        // [trump][suit][6 bits of that suit] -> the same cards in frame bits.
+        std::array<std::array<std::array<uint32_t, 64>, 4>, 4> to_frame {};
+        // [trump][frame bit] -> card.
+        std::array<std::array<Card, 24>, 4> from_frame {};
+        std::array<std::array<uint32_t, max_hand_size + 2>, 25> binomial {};
+        // Colex rank of every set of up to 12 frame bits among the sets of its size.
+        std::array<uint16_t, 1u << frame_cross> colex_low {};
+        // Unordered pairs of 6 bit suit masks with m cards between them: [mask][mask] -> dense id per m, and back.
+        std::array<std::array<uint16_t, 64>, 64> pair_id {};
+        std::array<std::array<std::array<uint8_t, 2>, 400>, max_hand_size + 1> pair_of_id {};
+        std::array<uint16_t, max_hand_size + 1> pair_count {};
+        // First index of the hands with l cards in the low bits, for 12 low bits and for 11 (one taken by the upcard).
+        std::array<uint32_t, max_hand_size + 2> block12 {};
+        std::array<uint32_t, max_hand_size + 2> block11 {};
+    };
+
+    consteval IndexerTables make_indexer_tables() {
+        IndexerTables ix;
+        Tables t = make_tables();
+
+        for (uint8_t tr = 0; tr < 4; tr++) {
+            Suit trump = Suit(tr);
+            Suit next = Card{}.same_color(trump);
+            std::array<uint32_t, 4> base {};
+            base[trump] = 0;
+            base[next] = frame_next;
+            uint32_t cross = frame_cross;
+            for (uint8_t s = 0; s < 4; s++) {
+                if (s != trump && s != next) {
+                    base[s] = cross;
+                    cross += 6;
+                }
+            }
+
+            std::array<uint8_t, 24> pos {};
+            for (uint8_t c = 0; c < 24; c++) {
+                Suit eff = t.eff_suit_tbl[tr][c];
+                pos[c] = static_cast<uint8_t>(base[eff] + static_cast<uint32_t>(std::popcount(t.higher_tbl[tr][c])));
+                ix.from_frame[tr][pos[c]] = Card{c};
+            }
+            for (uint8_t s = 0; s < 4; s++) {
+                for (uint32_t bits = 0; bits < 64; bits++) {
+                    uint32_t frame = 0;
+                    for (uint8_t r = 0; r < 6; r++) {
+                        if (bits & (1u << r)) {
+                            frame |= 1u << pos[static_cast<std::size_t>(s * 6 + r)];
+                        }
+                    }
+                    ix.to_frame[tr][s][bits] = frame;
+                }
+            }
+        }
+
+        for (std::size_t n = 0; n < ix.binomial.size(); n++) {
+            ix.binomial[n][0] = 1;
+            for (std::size_t k = 1; k < ix.binomial[n].size(); k++) {
+                ix.binomial[n][k] = n == 0 ? 0 : ix.binomial[n - 1][k - 1] + ix.binomial[n - 1][k];
+            }
+        }
+
+        for (uint32_t set = 0; set < ix.colex_low.size(); set++) {
+            if (std::popcount(set) > static_cast<int>(max_hand_size)) {
+                continue;
+            }
+            uint32_t rank = 0;
+            std::size_t i = 1;
+            for (uint32_t rest = set; rest; rest &= rest - 1, i++) {
+                rank += ix.binomial[static_cast<std::size_t>(std::countr_zero(rest))][i];
+            }
+            ix.colex_low[set] = static_cast<uint16_t>(rank);
+        }
+
+        for (std::size_t m = 0; m <= max_hand_size; m++) {
+            uint16_t id = 0;
+            for (uint8_t a = 0; a < 64; a++) {
+                for (uint8_t b = a; b < 64; b++) {
+                    if (std::popcount(a) + std::popcount(b) != static_cast<int>(m)) {
+                        continue;
+                    }
+                    ix.pair_id[a][b] = id;
+                    ix.pair_id[b][a] = id;
+                    ix.pair_of_id[m][id] = {a, b};
+                    id++;
+                }
+            }
+            ix.pair_count[m] = id;
+        }
+
+        for (std::size_t l = 0; l <= max_hand_size; l++) {
+            ix.block12[l + 1] = ix.block12[l] + ix.binomial[12][l] * ix.pair_count[max_hand_size - l];
+            ix.block11[l + 1] = ix.block11[l] + ix.binomial[11][l] * ix.pair_count[max_hand_size - l];
+        }
+        return ix;
+    }
+
+    inline constexpr IndexerTables indexer_tables = make_indexer_tables();
+};
+
+/**
+ * @brief Dense index of five card hands up to suit isomorphism, given trump.
+ *
+ * Hands that differ only by which suit is trump, or by swapping the two suits of the other colour,
+ * share an index. With an upcard the swap only applies while the upcard is trump or in trump's
+ * colour. Everything is constexpr and table driven: a hand is moved into the trump frame with one
+ * lookup per suit and ranked with binomial sums.
+ */
+struct HandIndexer {
+    static constexpr uint32_t num_hands = euchre::tables::indexer_tables.block12[euchre::tables::max_hand_size + 1];
+    static constexpr uint32_t num_hands_without_card = euchre::tables::indexer_tables.block11[euchre::tables::max_hand_size + 1];
+    static constexpr uint32_t num_cross_hands = euchre::tables::indexer_tables.binomial[23][euchre::tables::max_hand_size];
+    // Upcards in the 12 low frame bits, then the 6 bits of the first other suit.
+    static constexpr uint32_t num_upcard_hands = euchre::tables::frame_cross * num_hands_without_card + 6 * num_cross_hands;
+
+    /**
+     * @brief The hand's cards in the trump frame.
+     */
+    static constexpr uint32_t to_frame(Hand hand, Suit trump) {
+        const auto& ix = euchre::tables::indexer_tables;
+        uint32_t h = hand.value();
+        return ix.to_frame[trump][0][h & 63u] | ix.to_frame[trump][1][(h >> 6) & 63u] |
+               ix.to_frame[trump][2][(h >> 12) & 63u] | ix.to_frame[trump][3][(h >> 18) & 63u];
+    }
+
+    static constexpr Hand from_frame(uint32_t frame, Suit trump) {
+        const auto& ix = euchre::tables::indexer_tables;
+        Hand hand;
+        for (uint32_t rest = frame; rest; rest &= rest - 1) {
+            hand.give_card(ix.from_frame[trump][static_cast<std::size_t>(std::countr_zero(rest))]);
+        }
+        return hand;
+    }
+
+    /**
+     * @brief Index in [0, num_hands) of a five card hand.
+     */
+    static constexpr uint32_t index(Hand hand, Suit trump) {
+        assert(std::popcount(hand.value()) == euchre::tables::max_hand_size);
+        return rank_low(to_frame(hand, trump), 12, euchre::tables::indexer_tables.block12);
+    }
+
+    /**
+     * @brief Index in [0, num_upcard_hands) of a five card hand and a face up card not in it.
+     */
+    static constexpr uint32_t index(Hand hand, Suit trump, Card upcard) {
+        assert(std::popcount(hand.value()) == euchre::tables::max_hand_size);
+        assert(!hand.hand_has(upcard));
+        uint32_t frame = to_frame(hand, trump);
+        uint32_t up = to_frame(Hand::from_card(upcard), trump);
+        auto p = static_cast<uint32_t>(std::countr_zero(up));
+
+        if (p < euchre::tables::frame_cross) {
+            uint32_t low = remove_bit(frame & 0xFFFu, p);
+            uint32_t squeezed = low | ((frame >> euchre::tables::frame_cross) << (euchre::tables::frame_cross - 1));
+            return p * num_hands_without_card + rank_low(squeezed, 11, euchre::tables::indexer_tables.block11);
+        }
+
+        // The upcard fixes which other suit is which: put it in the first.
+        if (p >= euchre::tables::frame_cross_b) {
+            frame = swap_cross(frame);
+            p -= 6;
+        }
+        uint32_t slot = p - euchre::tables::frame_cross;
+        return euchre::tables::frame_cross * num_hands_without_card + slot * num_cross_hands +
+               colex(remove_bit(frame, p));
+    }
+
+    /**
+     * @brief A hand with the given index.
+     */
+    static constexpr Hand unrank(uint32_t index, Suit trump) {
+        return from_frame(unrank_low(index, 12, euchre::tables::indexer_tables.block12), trump);
+    }
+
+    struct HandWithUpcard {
+        Hand hand;
+        Card upcard;
+    };
+
+    /**
+     * @brief A hand and upcard with the given index.
+     */
+    static constexpr HandWithUpcard unrank_with_upcard(uint32_t index, Suit trump) {
+        uint32_t low_block = euchre::tables::frame_cross * num_hands_without_card;
+        if (index < low_block) {
+            uint32_t p = index / num_hands_without_card;
+            uint32_t squeezed = unrank_low(index % num_hands_without_card, 11, euchre::tables::indexer_tables.block11);
+            uint32_t low = insert_bit(squeezed & 0x7FFu, p);
+            uint32_t frame = low | ((squeezed >> (euchre::tables::frame_cross - 1)) << euchre::tables::frame_cross);
+            return {from_frame(frame, trump), euchre::tables::indexer_tables.from_frame[trump][p]};
+        }
+        index -= low_block;
+        uint32_t p = euchre::tables::frame_cross + index / num_cross_hands;
+        uint32_t frame = insert_bit(uncolex(index % num_cross_hands, euchre::tables::max_hand_size), p);
+        return {from_frame(frame, trump), euchre::tables::indexer_tables.from_frame[trump][p]};
+    }
+
+    private:
+
+    static constexpr uint32_t remove_bit(uint32_t x, uint32_t p) {
+        return (x & ((1u << p) - 1)) | ((x >> (p + 1)) << p);
+    }
+
+    static constexpr uint32_t insert_bit(uint32_t x, uint32_t p) {
+        return (x & ((1u << p) - 1)) | ((x >> p) << (p + 1));
+    }
+
+    static constexpr uint32_t swap_cross(uint32_t frame) {
+        return (frame & 0xFFFu) | (((frame >> 12) & 63u) << 18) | (((frame >> 18) & 63u) << 12);
+    }
+
+    /**
+     * @brief Rank of a set among all sets of its size, in colex order.
+     */
+    static constexpr uint32_t colex(uint32_t set) {
+        const auto& ix = euchre::tables::indexer_tables;
+        uint32_t rank = 0;
+        std::size_t i = 1;
+        for (uint32_t rest = set; rest; rest &= rest - 1, i++) {
+            rank += ix.binomial[static_cast<std::size_t>(std::countr_zero(rest))][i];
+        }
+        return rank;
+    }
+
+    static constexpr uint32_t uncolex(uint32_t rank, std::size_t size) {
+        const auto& ix = euchre::tables::indexer_tables;
+        uint32_t set = 0;
+        std::size_t q = ix.binomial.size() - 1;
+        for (std::size_t i = size; i > 0; i--) {
+            while (ix.binomial[q][i] > rank) {
+                q--;
+            }
+            rank -= ix.binomial[q][i];
+            set |= 1u << q;
+        }
+        return set;
+    }
+
+    /**
+     * @brief Rank a frame with `width` low bits followed by two interchangeable 6 bit suits.
+     */
+    static constexpr uint32_t rank_low(uint32_t frame, uint32_t width,
+                                       const std::array<uint32_t, euchre::tables::max_hand_size + 2>& block) {
+        const auto& ix = euchre::tables::indexer_tables;
+        uint32_t low = frame & ((1u << width) - 1);
+        auto l = static_cast<std::size_t>(std::popcount(low));
+        uint32_t a = (frame >> width) & 63u;
+        uint32_t b = (frame >> (width + 6)) & 63u;
+        uint32_t pairs = ix.pair_count[euchre::tables::max_hand_size - l];
+        return block[l] + ix.colex_low[low] * pairs + ix.pair_id[a][b];
+    }
+
+    static constexpr uint32_t unrank_low(uint32_t index, uint32_t width,
+                                         const std::array<uint32_t, euchre::tables::max_hand_size + 2>& block) {
+        const auto& ix = euchre::tables::indexer_tables;
+        std::size_t l = 0;
+        while (index >= block[l + 1]) {
+            l++;
+        }
+        index -= block[l];
+        std::size_t m = euchre::tables::max_hand_size - l;
+        uint32_t low = uncolex(index / ix.pair_count[m], l);
+        const auto& pair = ix.pair_of_id[m][index % ix.pair_count[m]];
+        return low | (uint32_t{pair[0]} << width) | (uint32_t{pair[1]} << (width + 6));
+    }
+};
@@ -1,9 +1,9 @@
 #pragma once
 #include <cstdint>
-#include <vector>
 #include "Phase.hpp"
 #include "Card.hpp"
 #include "Observation.hpp"
+#include "Rules.hpp"
 
 struct HandState {
     Phase       phase = Phase::Deal;
@@ -13,15 +13,24 @@ struct HandState {
     uint8_t     maker_team =  0;
     Suit        trump = Suit::None;
     Card        lead_card = euchre::constants::invalid_card;
-    int         num_played = 0;
+    uint8_t     num_played = 0;
     bool        stick_the_dealer = false;
     uint8_t     maker_player = 0;
     bool        going_alone = false;
+    bool        defending_alone = false;
+    uint8_t     defender_player = 0;
     uint8_t     tricks_won[2] = {};
     uint8_t     lead_player = 0;
+    uint8_t     current_player = 0;
     uint8_t     tricks_played = 0;
     std::array<Card, 4> trick_cards;
 
+    // Public history of the hand, kept up to date by record_play().
+    uint32_t    played = 0;
+    std::array<uint32_t, 4> played_by {};
+    std::array<uint8_t, 4> void_suits {};
+    std::array<std::array<Card, 4>, 5> trick_history {};
+
     HandState() = default;
 
     void reset() {
@@ -29,33 +38,48 @@ struct HandState {
     }
 
     void give_card_to(Card c, int player) {
-        assert(player < euchre::constants::num_players);
+        EUCHRE_ASSERT(player < euchre::constants::num_players);
         hands[player].give_card(c);
     }
 
-    std::vector<Card> decode_hand(uint32_t hand) {
-        std::vector<Card> cards(5);
-        while (hand) {
-            uint32_t bit = hand & -hand;
-            int idx = std::countr_zero<uint32_t>(bit);
-            cards.push_back(Card {idx});
+    /**
+     * @brief Record a card play in the public history. Call before lead_card/num_played move on.
+     */
+    void record_play(uint8_t player, Card c) {
+        if (num_played > 0) {
+            void_suits[player] |= euchre::rules::shown_void(c, lead_card, trump);
         }
-        return cards;
+        played |= 1u << c;
+        played_by[player] |= 1u << c;
+        trick_history[tricks_played][player] = c;
     }
 
-    Observation generate_observation(uint8_t current_player, uint8_t dealer_idx) {
-        assert(current_player < euchre::constants::num_players);
+    /**
+     * @brief What `player` sees. Pass the deck's tables when it has a Joker, so voids in trump include it.
+     */
+    Observation generate_observation(uint8_t player, uint8_t dealer_idx,
+                                     const euchre::tables::Tables& t = euchre::tables::tables()) {
+        assert(player < euchre::constants::num_players);
         Observation obs = {
-            .hand = hands[current_player],
+            .hand = hands[player],
             .trump = trump,
             .lead = lead_card,
             .face_up_card = face_up_card,
             .trick_cards = trick_cards,
             .phase = phase,
             .maker_team = maker_team,
-            .player = current_player,
+            .player = player,
             .dealer = dealer_idx,
-            .num_played = static_cast<uint8_t>(num_played),
+            .num_played = num_played,
+            .maker_player = maker_player,
+            .going_alone = going_alone,
+            .defending_alone = defending_alone,
+            .defender_player = defender_player,
+            .tricks_won = {tricks_won[0], tricks_won[1]},
+            .played = played,
+            .played_by = played_by,
+            .voids = {euchre::rules::void_cards(void_suits[0], trump, t), euchre::rules::void_cards(void_suits[1], trump, t),
+                      euchre::rules::void_cards(void_suits[2], trump, t), euchre::rules::void_cards(void_suits[3], trump, t)},
         };
 
         return obs;
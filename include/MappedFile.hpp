@@ -0,0 +1,39 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+/**
+ * @brief A read-only view of a whole file: mmap on POSIX, read into memory elsewhere.
+ */
+class MappedFile {
+    public:
+
+    MappedFile() = default;
+
+    /**
+     * @throws std::runtime_error if the file cannot be opened or mapped.
+     */
+    explicit MappedFile(const std::string& path);
+
+    MappedFile(MappedFile&& other) noexcept;
+    MappedFile& operator=(MappedFile&& other) noexcept;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile();
+
+    const uint8_t* data() const { return bytes; }
+    std::size_t size() const { return length; }
+
+    private:
+
+    void release();
+
+    const uint8_t* bytes = nullptr;
+    std::size_t length = 0;
+    // The mapping, when the file is mapped rather than read.
+    void* mapping = nullptr;
+    std::vector<uint8_t> buffer;
+};
@@ -16,4 +16,15 @@ struct Observation {
     uint8_t player = {};
     uint8_t dealer = {};
     uint8_t num_played = {};
+    uint8_t maker_player = {};
+    bool going_alone = {};
+    // A defender playing alone against a lone maker; defender_player is only meaningful when set.
+    bool defending_alone = {};
+    uint8_t defender_player = {};
+    std::array<uint8_t, 2> tricks_won = {};
+    // Every card played this hand, the cards each seat played, and the cards each seat is known
+    // not to hold because it failed to follow their effective suit.
+    uint32_t played = {};
+    std::array<uint32_t, 4> played_by = {};
+    std::array<uint32_t, 4> voids = {};
 };
\ No newline at end of file
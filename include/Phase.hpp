@@ -10,5 +10,9 @@ enum class Phase : uint8_t {
     BidRound2,
     PlayTrick,
     HandOver,
+    // Rule variants (see euchre::rules::RuleSet).
+    DefendAloneDecision,
+    FarmerSwap,
+    FarmerDiscard,
 
 };
\ No newline at end of file
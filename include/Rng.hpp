@@ -1,16 +1,110 @@
 #pragma once
+#include <array>
+#include <concepts>
+#include <cstdint>
 #include <random>
 
-class Rng {
-    public:
-    
-    Rng(uint32_t seed) : m_eng(seed), m_seed(seed) {}
-    
-    int uniform_int(int low, int high) {
-        std::uniform_int_distribution<int> dist(low, high);
-        return dist(m_eng);
+namespace euchre::rng {
+
+    /**
+     * @brief Any generator producing uniform 32 bit words, e.g. Philox4x32 or std::mt19937.
+     */
+    template <typename E>
+    concept Engine = std::uniform_random_bit_generator<E> && (E::min() == 0) && (E::max() == 0xFFFFFFFFu);
+
+    /**
+     * @brief One Philox4x32-10 block: a keyed bijection of a 128 bit counter.
+     */
+    constexpr std::array<uint32_t, 4> philox4x32(std::array<uint32_t, 4> ctr, std::array<uint32_t, 2> key) {
+        for (int round = 0; round < 10; round++) {
+            uint64_t p0 = uint64_t{0xD2511F53} * ctr[0];
+            uint64_t p1 = uint64_t{0xCD9E8D57} * ctr[2];
+            ctr = {
+                static_cast<uint32_t>(p1 >> 32) ^ ctr[1] ^ key[0],
+                static_cast<uint32_t>(p1),
+                static_cast<uint32_t>(p0 >> 32) ^ ctr[3] ^ key[1],
+                static_cast<uint32_t>(p0),
+            };
+            key[0] += 0x9E3779B9;
+            key[1] += 0xBB67AE85;
+        }
+        return ctr;
     }
 
-    int m_seed;
-    std::mt19937 m_eng;
-};
\ No newline at end of file
+    /**
+     * @brief Counter-based engine: draw k of hand h is philox({k / 4, h, 0, 0}, {seed, stream})[k % 4].
+     *
+     * The whole state is a key and a position, so any draw can be reached with seek() and
+     * independent streams (games, threads) are just different keys. Each hand holds 2^32 draws.
+     */
+    class Philox4x32 {
+        public:
+        using result_type = uint32_t;
+
+        constexpr Philox4x32() = default;
+        constexpr explicit Philox4x32(uint32_t seed, uint32_t stream = 0) : key{seed, stream} {}
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return 0xFFFFFFFFu; }
+
+        /**
+         * @brief Re-key the engine and rewind it to hand 0, draw 0.
+         */
+        constexpr void seed(uint32_t seed, uint32_t stream = 0) {
+            key = {seed, stream};
+            seek(0, 0);
+        }
+
+        /**
+         * @brief Jump to a hand and draw position. O(1).
+         */
+        constexpr void seek(uint32_t hand, uint32_t draw = 0) {
+            m_hand = hand;
+            m_draw = draw;
+            cached = false;
+        }
+
+        constexpr uint32_t hand() const { return m_hand; }
+        constexpr uint32_t draw() const { return m_draw; }
+        constexpr std::array<uint32_t, 2> get_key() const { return key; }
+
+        constexpr result_type operator()() {
+            if (!cached || (m_draw & 3) == 0) {
+                block = philox4x32({m_draw >> 2, m_hand, 0, 0}, key);
+                cached = true;
+            }
+            return block[m_draw++ & 3];
+        }
+
+        /**
+         * @brief The value operator() would return at (hand, draw), without touching any state.
+         */
+        static constexpr result_type at(uint32_t seed, uint32_t stream, uint32_t hand, uint32_t draw) {
+            return philox4x32({draw >> 2, hand, 0, 0}, {seed, stream})[draw & 3];
+        }
+
+        private:
+        std::array<uint32_t, 2> key {};
+        uint32_t m_hand = 0;
+        uint32_t m_draw = 0;
+        std::array<uint32_t, 4> block {};
+        bool cached = false;
+    };
+
+    /**
+     * @brief Unbiased uniform integer in [0, range) using Lemire's multiply-shift with rejection.
+     */
+    template <Engine E>
+    inline uint32_t bounded(E& eng, uint32_t range) {
+        uint64_t m = uint64_t{static_cast<uint32_t>(eng())} * range;
+        auto low = static_cast<uint32_t>(m);
+        if (low < range) {
+            uint32_t threshold = (0u - range) % range;
+            while (low < threshold) {
+                m = uint64_t{static_cast<uint32_t>(eng())} * range;
+                low = static_cast<uint32_t>(m);
+            }
+        }
+        return static_cast<uint32_t>(m >> 32);
+    }
+};
@@ -0,0 +1,232 @@
+#pragma once
+
+#include "Card.hpp"
+#include "Defns.hpp"
+#include "Tables.hpp"
+#include <array>
+#include <bit>
+#include <cstdint>
+
+/**
+ * Rule primitives shared by every engine (Env, EnvBatch, ...). They take plain values rather than a
+ * HandState so engines with a different memory layout can use them without conversions.
+ */
+namespace euchre::rules {
+
+    /**
+     * @brief The seat that sits out when the maker goes alone.
+     */
+    constexpr uint8_t sitting_out_player(uint8_t maker_player) {
+        return static_cast<uint8_t>((maker_player + 2) % euchre::constants::num_players);
+    }
+
+    /**
+     * @brief The next seat to act, skipping the partner of a lone maker.
+     */
+    constexpr uint8_t next_player(uint8_t current_player, bool going_alone, uint8_t maker_player) {
+        uint8_t next = static_cast<uint8_t>((current_player + 1) % euchre::constants::num_players);
+        if (going_alone && next == sitting_out_player(maker_player)) {
+            next = static_cast<uint8_t>((next + 1) % euchre::constants::num_players);
+        }
+        return next;
+    }
+
+    /**
+     * @brief The seats without cards this hand, as a bit per seat: a lone maker's partner and a
+     * lone defender's partner.
+     */
+    constexpr uint8_t sitting_out_mask(bool going_alone, uint8_t maker_player, bool defending_alone,
+                                       uint8_t defender_player) {
+        return static_cast<uint8_t>((going_alone ? 1u << sitting_out_player(maker_player) : 0u) |
+                                    (defending_alone ? 1u << sitting_out_player(defender_player) : 0u));
+    }
+
+    /**
+     * @brief The next seat to act, skipping every seat in sitting_out (a mask from sitting_out_mask()).
+     */
+    constexpr uint8_t next_player(uint8_t current_player, uint8_t sitting_out) {
+        uint8_t next = static_cast<uint8_t>((current_player + 1) % euchre::constants::num_players);
+        while (sitting_out & (1u << next)) {
+            next = static_cast<uint8_t>((next + 1) % euchre::constants::num_players);
+        }
+        return next;
+    }
+
+    /**
+     * @brief The seat that acted before `current_player`, skipping the partner of a lone maker.
+     */
+    constexpr uint8_t previous_player(uint8_t current_player, bool going_alone, uint8_t maker_player) {
+        constexpr uint8_t np = euchre::constants::num_players;
+        uint8_t prev = static_cast<uint8_t>((current_player + np - 1) % np);
+        if (going_alone && prev == sitting_out_player(maker_player)) {
+            prev = static_cast<uint8_t>((prev + np - 1) % np);
+        }
+        return prev;
+    }
+
+    /**
+     * @brief Determine which seat won a completed trick.
+     *
+     * @param trick_cards The card played by each seat, indexed by seat.
+     * @return uint8_t The winning seat. Ties keep the lowest seat, matching the original Env loop.
+     */
+    inline uint8_t trick_winner(const std::array<Card, 4>& trick_cards, Suit trump, Card lead_card,
+                                bool going_alone, uint8_t maker_player) {
+        auto& t = euchre::tables::tables();
+        Suit led_suit = t.eff_suit_tbl[trump][lead_card];
+        uint8_t skipped = going_alone ? sitting_out_player(maker_player) : euchre::constants::num_players;
+        uint8_t winner = 0;
+        uint8_t best_power = 0;
+        for (uint8_t i = 0; i < euchre::constants::num_players; i++) {
+            if (i == skipped) {
+                continue;
+            }
+            uint8_t power = t.power[trump][led_suit][trick_cards[i]];
+            if (power > best_power) {
+                best_power = power;
+                winner = i;
+            }
+        }
+        return winner;
+    }
+
+    /**
+     * @brief trick_winner() with any seats sitting out, from the deck's tables.
+     *
+     * @param sitting_out A mask from sitting_out_mask().
+     */
+    inline uint8_t trick_winner(const std::array<Card, 4>& trick_cards, Suit trump, Card lead_card,
+                                uint8_t sitting_out, const euchre::tables::Tables& t) {
+        Suit led_suit = t.eff_suit_tbl[trump][lead_card];
+        uint8_t winner = 0;
+        uint8_t best_power = 0;
+        for (uint8_t i = 0; i < euchre::constants::num_players; i++) {
+            if (sitting_out & (1u << i)) {
+                continue;
+            }
+            uint8_t power = t.power[trump][led_suit][trick_cards[i]];
+            if (power > best_power) {
+                best_power = power;
+                winner = i;
+            }
+        }
+        return winner;
+    }
+
+    /**
+     * @brief The effective suit a player just showed out of, as a one bit suit mask; 0 if they followed.
+     */
+    inline uint8_t shown_void(Card played, Card lead_card, Suit trump) {
+        auto& t = euchre::tables::tables();
+        Suit led_suit = t.eff_suit_tbl[trump][lead_card];
+        return static_cast<uint8_t>(t.eff_suit_tbl[trump][played] == led_suit ? 0u : 1u << led_suit);
+    }
+
+    /**
+     * @brief Expand per-suit void bits into the cards of those effective suits.
+     */
+    inline uint32_t void_cards(uint8_t void_suits, Suit trump,
+                               const euchre::tables::Tables& t = euchre::tables::tables()) {
+        uint32_t cards = 0;
+        for (uint8_t s = 0; s < 4; s++) {
+            if (void_suits & (1u << s)) {
+                cards |= t.suit_mask_tbl[trump][s];
+            }
+        }
+        return cards;
+    }
+
+    /**
+     * @brief Keep one card from each run of equivalent moves.
+     *
+     * Two cards of the same effective suit are interchangeable for whoever holds them when every
+     * card ranked between them is out of play, e.g. the K and Q once the A is gone. Cards in the
+     * trick under way still count as in play. Keeps the highest card of each run.
+     *
+     * @param moves Legal cards of one player.
+     * @param out_of_play Cards that can no longer be played: finished tricks, buried cards.
+     */
+    inline uint32_t distinct_moves(uint32_t moves, Suit trump, uint32_t out_of_play) {
+        auto& t = euchre::tables::tables();
+        uint32_t keep = moves;
+        for (uint32_t rest = moves; rest; rest &= rest - 1) {
+            auto c = static_cast<uint8_t>(std::countr_zero(rest));
+            uint32_t above = t.higher_tbl[trump][c] & ~out_of_play;
+            for (uint32_t up = above & moves; up; up &= up - 1) {
+                auto m = static_cast<uint8_t>(std::countr_zero(up));
+                // No card still in play ranks between c and m.
+                if ((above & ~t.higher_tbl[trump][m]) == (1u << m)) {
+                    keep &= ~(1u << c);
+                    break;
+                }
+            }
+        }
+        return keep;
+    }
+
+    /**
+     * @brief A farmer's hand: nothing above a ten (the Joker counts as high).
+     */
+    constexpr bool is_farmers_hand(uint32_t hand) {
+        constexpr uint32_t nines_and_tens = 0x3u | 0x3u << 6 | 0x3u << 12 | 0x3u << 18;
+        return (hand & ~nines_and_tens) == 0;
+    }
+
+    /**
+     * @brief Whether the dealer must name trump when everyone passes round 2.
+     */
+    enum class StickTheDealer : uint8_t {
+        Off,
+        On,
+        HandFlag, // Per hand, from HandState::stick_the_dealer (cleared by every reset)
+    };
+
+    /**
+     * @brief What happens after four passes in round 2.
+     */
+    enum class AllPass : uint8_t {
+        Redeal,      // The same dealer deals again
+        PassTheDeal, // The deal moves to the next seat
+    };
+
+    /**
+     * @brief A table's optional rules, fixed at compile time as a template argument of an engine.
+     *
+     * Each field is a constant in the engine, so the branches of rules a configuration does not use
+     * are compiled out. The defaults are the rules every engine has always played.
+     */
+    struct RuleSet {
+        StickTheDealer stick_the_dealer = StickTheDealer::HandFlag;
+        bool going_alone = true;            // Makers may play alone; without it the decision is skipped
+        uint8_t lone_march_points = 4;      // Points for a lone maker taking all five tricks
+        uint8_t target_score = 10;
+        AllPass all_pass = AllPass::Redeal;
+        DeckDef deck {};                    // joker_deck adds the Joker as the highest trump
+        bool defend_alone = false;          // A defender may play alone against a lone maker
+        uint8_t lone_defense_points = 4;    // Points for a lone defender euchring the maker
+        bool farmers_hand = false;          // A hand of only 9s and 10s may swap with the kitty before bidding
+    };
+
+    struct HandScore {
+        uint8_t team;
+        uint8_t points;
+    };
+
+    /**
+     * @brief Score a finished hand.
+     *
+     * @return HandScore The team that scores and how many points it receives.
+     */
+    constexpr HandScore score_hand(uint8_t maker_team, uint8_t maker_tricks, bool going_alone,
+                                   uint8_t lone_march_points = RuleSet{}.lone_march_points,
+                                   bool defending_alone = false,
+                                   uint8_t lone_defense_points = RuleSet{}.lone_defense_points) {
+        if (maker_tricks == 5) {
+            return {maker_team, static_cast<uint8_t>(going_alone ? lone_march_points : 2)};
+        }
+        if (maker_tricks >= 3) {
+            return {maker_team, 1};
+        }
+        return {static_cast<uint8_t>(1 - maker_team), static_cast<uint8_t>(defending_alone ? lone_defense_points : 2)};
+    }
+};
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "Bench.hpp"
+#include "WorkerPool.hpp"
+#include <array>
+#include <cstdint>
+
+/**
+ * @brief The seat policies the bit-sliced engine can play, each one equivalent to a bot.
+ */
+enum class SlicedPolicy : uint8_t {
+    Random, // RandomBot: uniform over the legal actions
+    Min,    // MinBot: never orders up, calls the first legal suit, plays its lowest legal card
+    Max,    // MaxBot: as MinBot, but plays its highest legal card
+};
+
+using SlicedLineup = std::array<SlicedPolicy, 4>;
+
+// Games per independent block in run_sliced_benchmark(); a block is played by one thread.
+inline constexpr int sliced_block_games = 4096;
+
+/**
+ * @brief Play games `first .. last - 1` 64 at a time, bit-sliced, and add their outcomes to result.
+ *
+ * Every game in flight owns one bit lane: hands are stored as one 64 bit word per seat and card, and
+ * follow-suit masks, card choices and trick winners are computed for all 64 games at once with
+ * bitwise logic. A lane whose game ends picks up the next game of the range, so the words stay full.
+ *
+ * Dealing and bidding run per game, with Env's rules, seeds and step accounting; game g is dealt
+ * exactly the hands Env{g, ...} deals. Lineups of Min and Max seats therefore reproduce
+ * play_games() game for game. Random seats draw from streams keyed by `first` rather than by seat,
+ * so they match RandomBot in distribution only.
+ */
+void play_sliced_games(const SlicedLineup& lineup, int first, int last, int max_steps, BenchResult& result);
+
+/**
+ * @brief Play seeds 0 .. num_games - 1 on the calling thread, in blocks of sliced_block_games.
+ */
+BenchResult run_sliced_benchmark(const SlicedLineup& lineup, int num_games, int max_steps);
+
+/**
+ * @brief Play seeds 0 .. num_games - 1 across the pool, one block of sliced_block_games at a time.
+ *
+ * Results are bit-identical to run_sliced_benchmark() for any thread count; only timings differ.
+ */
+ParallelBenchResult run_parallel_sliced_benchmark(WorkerPool& pool, const SlicedLineup& lineup, int num_games,
+                                                  int max_steps);
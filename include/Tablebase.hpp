@@ -0,0 +1,80 @@
+#pragma once
+
+#include "Card.hpp"
+#include "Defns.hpp"
+#include "MappedFile.hpp"
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+class WorkerPool;
+
+/**
+ * @brief Exact double-dummy results for every endgame with two or three cards per hand.
+ *
+ * Positions are stored in an abstract form: seats relative to the leader, trump first, and each
+ * suit reduced to the owners of its cards still in play from highest to lowest. Only relative
+ * rank decides a trick, so the actual cards and the trump suit drop out. The plain suits are
+ * ordered by length, which folds most of their permutations together. Each abstract position has
+ * a dense index (suit lengths, then the rank of its owner sequence among all arrangements), so the
+ * file is a flat array of 2 bit entries and a probe is one load.
+ *
+ * A value is the number of the remaining tricks the leader's team takes. Lone hands are covered
+ * too, one section per seat of the sitting out partner relative to the leader.
+ */
+class Tablebase {
+    public:
+
+    static constexpr uint8_t min_cards = 2;
+    static constexpr uint8_t max_supported_cards = 3;
+
+    /**
+     * @brief Map a file written by generate().
+     *
+     * @throws std::runtime_error if the file is missing or not a tablebase.
+     */
+    explicit Tablebase(const std::string& path);
+
+    Tablebase(Tablebase&& other) noexcept;
+    Tablebase& operator=(Tablebase&& other) noexcept;
+    Tablebase(const Tablebase&) = delete;
+    Tablebase& operator=(const Tablebase&) = delete;
+
+    /**
+     * @brief Solve every position up to max_cards per hand and write the table to path.
+     *
+     * Two cards take well under a second; three cards take tens of seconds on one core.
+     */
+    static void generate(const std::string& path, uint8_t max_cards, WorkerPool* pool = nullptr);
+
+    uint8_t max_cards() const { return cards; }
+
+    /**
+     * @brief Tricks the leader's team takes from a trick boundary with optimal play.
+     *
+     * Every playing seat must hold the same number of cards; the sitting out seat of a lone maker
+     * is ignored. Returns -1 when that number is outside [min_cards, max_cards()].
+     */
+    int probe(const std::array<uint32_t, 4>& hands, Suit trump, uint8_t lead_player, bool going_alone,
+              uint8_t maker_player) const;
+
+    private:
+
+    struct Header {
+        std::array<char, 8> magic;
+        uint32_t version;
+        uint32_t max_cards;
+        uint64_t entries;
+    };
+
+    /**
+     * @brief A view over tables that are still being generated.
+     */
+    Tablebase(const uint8_t* packed, uint8_t max_cards);
+
+    const uint8_t* data = nullptr;
+    uint8_t cards = 0;
+    // Empty for a view.
+    MappedFile file;
+};
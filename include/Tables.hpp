@@ -2,17 +2,41 @@
 #include "Card.hpp"
 #include "Defns.hpp"
 
+/**
+ * Lookup tables built at compile time for one deck definition. Every table is sized for all 25 card
+ * ids; the Joker's suit, power and power order entries are the same in every deck's tables (it is
+ * the top trump), but only a deck holding it puts it in suit masks, higher sets and the deck. A deck
+ * that never deals the Joker therefore never sees it, and code that only looks up cards it holds
+ * gets the same answers from any deck's tables.
+ */
 namespace euchre::tables {
-    using SuitTable = std::array<Suit, euchre::constants::num_cards>;
+    using euchre::constants::max_cards;
+    using SuitTable = std::array<Suit, max_cards>;
     using SuitMaskTable = std::array<std::array<uint32_t, 4>, 4>;
-    using EffSuitTable = std::array<std::array<Suit, 24>, 4>;
-    using PowerTable = std::array<std::array<std::array<uint8_t, 24>, 4>, 4>;
+    using EffSuitTable = std::array<std::array<Suit, max_cards>, 4>;
+    using PowerTable = std::array<std::array<std::array<uint8_t, max_cards>, 4>, 4>;
+    using HigherTable = std::array<std::array<uint32_t, max_cards>, 4>;
+    template <typename T, std::size_t N>
+    using TrumpLedTable = std::array<std::array<std::array<T, N>, 4>, 4>;
     
     struct Tables {
         SuitTable suit_tbl {};
         SuitMaskTable suit_mask_tbl {};
         EffSuitTable eff_suit_tbl {};
         PowerTable power {};
+        // [trump][card]: the cards of the same effective suit that beat it.
+        HigherTable higher_tbl {};
+        // Power order, per (trump, led): bit i of an ordered set is the i-th weakest card, cards of
+        // equal power by card index. Sets are moved into it one suit's 6 bits at a time; the Joker
+        // is always strongest, so it keeps its own bit 24.
+        TrumpLedTable<std::array<uint32_t, 64>, 4> power_order {};
+        // Position -> card, with every position past the last (countr_zero of nothing) invalid.
+        TrumpLedTable<Card, 33> power_order_card {};
+        // [bit_width of an ordered set]: the positions of its strongest card's power and up, so the
+        // lowest of those is the strongest card with the lowest index.
+        TrumpLedTable<uint32_t, max_cards + 1> strongest_tie {};
+        // [power]: how many cards have at most that power, i.e. the first position that beats it.
+        TrumpLedTable<uint8_t, 256> beats_from {};
         uint32_t deck;
     };
 
@@ -21,7 +45,7 @@ namespace euchre::tables {
 
     constexpr SuitTable make_suit_table() {
         SuitTable t{};
-        for (std::size_t i = 0; i < euchre::constants::num_cards; i++) {
+        for (std::size_t i = 0; i < max_cards; i++) {
             t[i] = static_cast<Suit>(i / 6);
         }
         return t;
@@ -31,9 +55,9 @@ namespace euchre::tables {
         EffSuitTable t{};
         for (uint8_t tr = 0; tr < 4; tr++) {
             Suit trump = Suit(tr);
-            for (uint32_t c = 0; c < 24; c++) {
+            for (uint32_t c = 0; c < max_cards; c++) {
                 Card card = static_cast<Card>(c);
-                if (card.is_left_bower(trump)) {
+                if (card.is_left_bower(trump) || card.is_joker()) {
                     t[trump][c] = trump;
                     continue;
                 }
@@ -48,7 +72,10 @@ namespace euchre::tables {
 
     constexpr uint8_t get_trump_power(Card c, Suit trump) {
         uint8_t power = 0;
-        if (c.is_right_bower(trump)) {
+        if (c.is_joker()) {
+            power = 201;
+        }
+        else if (c.is_right_bower(trump)) {
             power = 200;
         }
         else if (c.is_left_bower(trump)) {
@@ -94,7 +121,7 @@ namespace euchre::tables {
             for (uint8_t led = 0; led < 4; led++) {
                 Suit led_suit = Suit(led);
 
-                for(uint8_t i = 0; i < 24; i++) {
+                for(uint8_t i = 0; i < max_cards; i++) {
                     Card c{i};
                     Suit eff_card_suit = t.eff_suit_tbl[trump][c];
                     uint8_t power = 0;
@@ -119,13 +146,13 @@ namespace euchre::tables {
         }
     }
 
-    static constexpr auto build_suit_mask(const EffSuitTable effective_suit_tbl) {
+    static constexpr auto build_suit_mask(const EffSuitTable effective_suit_tbl, DeckDef deck) {
         std::array<std::array<uint32_t, 4>, 4> suit_mask{}; // [trump][suit]
 
         for (uint8_t t = 0; t < 4; ++t) {
             for (uint8_t s = 0; s < 4; ++s) {
                 uint32_t m = 0;
-                for (uint8_t c = 0; c < 24; ++c) {
+                for (uint8_t c = 0; c < deck.num_cards(); ++c) {
                     if (effective_suit_tbl[t][c] == Suit{s}) {
                         m |= (uint32_t{1} << c);
                     }
@@ -136,20 +163,112 @@ namespace euchre::tables {
         return suit_mask;
     }
 
-    consteval Tables make_tables() {
+    constexpr void make_higher_table(Tables& t, DeckDef deck) {
+        for (uint8_t tr = 0; tr < 4; tr++) {
+            for (uint8_t c = 0; c < deck.num_cards(); c++) {
+                Suit suit = t.eff_suit_tbl[tr][c];
+                uint32_t m = 0;
+                for (uint8_t x = 0; x < deck.num_cards(); x++) {
+                    if (t.eff_suit_tbl[tr][x] == suit && t.power[tr][suit][x] > t.power[tr][suit][c]) {
+                        m |= uint32_t{1} << x;
+                    }
+                }
+                t.higher_tbl[tr][c] = m;
+            }
+        }
+    }
+
+    constexpr void make_power_order_tables(Tables& t) {
+        for (uint8_t tr = 0; tr < 4; tr++) {
+            for (uint8_t led = 0; led < 4; led++) {
+                const auto& power = t.power[tr][led];
+                t.power_order_card[tr][led].fill(Card{});
+                std::array<uint8_t, max_cards> pos {};
+                for (uint8_t c = 0; c < max_cards; c++) {
+                    for (uint8_t x = 0; x < max_cards; x++) {
+                        if (power[x] < power[c] || (power[x] == power[c] && x < c)) {
+                            pos[c]++;
+                        }
+                    }
+                    t.power_order_card[tr][led][pos[c]] = Card{c};
+                }
+
+                for (uint8_t s = 0; s < 4; s++) {
+                    for (uint32_t bits = 0; bits < 64; bits++) {
+                        uint32_t ordered = 0;
+                        for (uint8_t r = 0; r < 6; r++) {
+                            if (bits & (1u << r)) {
+                                ordered |= 1u << pos[static_cast<std::size_t>(s * 6 + r)];
+                            }
+                        }
+                        t.power_order[tr][led][s][bits] = ordered;
+                    }
+                }
+
+                for (uint8_t w = 1; w <= max_cards; w++) {
+                    uint8_t top_power = power[t.power_order_card[tr][led][w - 1]];
+                    uint32_t m = 0;
+                    for (uint8_t p = 0; p < max_cards; p++) {
+                        if (power[t.power_order_card[tr][led][p]] >= top_power) {
+                            m |= 1u << p;
+                        }
+                    }
+                    t.strongest_tie[tr][led][w] = m;
+                }
+
+                for (std::size_t p = 0; p < 256; p++) {
+                    uint8_t n = 0;
+                    for (uint8_t c = 0; c < max_cards; c++) {
+                        if (power[c] <= p) {
+                            n++;
+                        }
+                    }
+                    t.beats_from[tr][led][p] = n;
+                }
+            }
+        }
+    }
+
+    consteval Tables make_tables(DeckDef deck = {}) {
         Tables t;
         t.suit_tbl = make_suit_table();
         t.eff_suit_tbl = make_eff_suit_table();
-        t.deck = (1 << euchre::constants::num_cards) - 1;
-        t.suit_mask_tbl = build_suit_mask(t.eff_suit_tbl);
+        t.deck = deck.cards();
+        t.suit_mask_tbl = build_suit_mask(t.eff_suit_tbl, deck);
         make_power_table(t);
+        make_higher_table(t, deck);
+        make_power_order_tables(t);
 
         return t;
     }
 
+    inline constexpr DeckDef standard_deck {};
+    inline constexpr DeckDef joker_deck {.joker = true};
+
+    /**
+     * @brief The tables of one deck, built once at compile time.
+     */
+    template <DeckDef Deck>
+    const Tables& tables() {
+        static constexpr Tables t = make_tables(Deck);
+        return t;
+    }
+
+    /**
+     * @brief The standard 24 card deck's tables.
+     */
     inline const Tables& tables() {
         static const Tables t = make_tables();
         return t;
     }
+
+    /**
+     * @brief A card set in power order for this trump and led suit: four lookups, no loop.
+     */
+    inline uint32_t to_power_order(const Tables& t, uint32_t cards, Suit trump, Suit led) {
+        const auto& order = t.power_order[trump][led];
+        return order[0][cards & 63u] | order[1][(cards >> 6) & 63u] | order[2][(cards >> 12) & 63u] |
+               order[3][(cards >> 18) & 63u] | (cards & (1u << euchre::constants::joker));
+    }
 };
 
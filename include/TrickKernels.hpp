@@ -0,0 +1,76 @@
+#pragma once
+
+#include "Card.hpp"
+#include "Defns.hpp"
+#include <array>
+#include <cstdint>
+#include <span>
+
+/**
+ * @brief Trick winners and follow-suit masks for many games in one call.
+ *
+ * Inputs are structure-of-arrays in EnvBatch's layout: four trick cards per game at
+ * [game * 4 + seat], and one trump, lead card, sitting out seat or hand per game. The AVX2 kernels
+ * handle eight games per instruction sequence with gathers over widened copies of the power,
+ * effective suit and suit mask tables; the portable kernels run the same table lookups one game at
+ * a time. The dispatching entry points pick AVX2 when the CPU has it, and every variant gives
+ * bit-identical results to euchre::rules::trick_winner and Hand::get_valid_hand.
+ */
+namespace euchre::kernels {
+
+    /**
+     * @brief The winning seat of each finished trick.
+     *
+     * @param sitting_out The seat without a card (a lone maker's partner), or num_players.
+     * @throws std::invalid_argument if the spans do not all describe winners.size() games.
+     */
+    void trick_winners(std::span<const Card> trick_cards, std::span<const Suit> trump,
+                       std::span<const Card> lead_card, std::span<const uint8_t> sitting_out,
+                       std::span<uint8_t> winners);
+
+    /**
+     * @brief The cards each hand may play to its trick: the led suit if it has any, else everything.
+     *
+     * An invalid lead card means the hand is leading, which allows the whole hand.
+     *
+     * @throws std::invalid_argument if the spans do not all describe masks.size() games.
+     */
+    void follow_masks(std::span<const uint32_t> hands, std::span<const Suit> trump,
+                      std::span<const Card> lead_card, std::span<uint32_t> masks);
+
+    /**
+     * @brief Many Philox blocks at once: out[j][i] = philox4x32({ctr0[i], ctr1[i], 0, 0}, {key0[i], key1})[j].
+     *
+     * The draws of a Philox4x32 engine are these blocks, so batched engines (one game per lane)
+     * can compute their next draws together.
+     *
+     * @throws std::invalid_argument if the spans differ in size.
+     */
+    void philox_blocks(std::span<const uint32_t> ctr0, std::span<const uint32_t> ctr1, std::span<const uint32_t> key0,
+                       uint32_t key1, const std::array<std::span<uint32_t>, 4>& out);
+
+    void trick_winners_portable(std::span<const Card> trick_cards, std::span<const Suit> trump,
+                                std::span<const Card> lead_card, std::span<const uint8_t> sitting_out,
+                                std::span<uint8_t> winners);
+    void follow_masks_portable(std::span<const uint32_t> hands, std::span<const Suit> trump,
+                               std::span<const Card> lead_card, std::span<uint32_t> masks);
+    void philox_blocks_portable(std::span<const uint32_t> ctr0, std::span<const uint32_t> ctr1,
+                                std::span<const uint32_t> key0, uint32_t key1,
+                                const std::array<std::span<uint32_t>, 4>& out);
+
+#if defined(__x86_64__) || defined(__i386__)
+#define EUCHRE_HAS_AVX2_KERNELS 1
+    /**
+     * @brief AVX2 kernels. Only call them when cpu_has_avx2() is true.
+     */
+    void trick_winners_avx2(std::span<const Card> trick_cards, std::span<const Suit> trump,
+                            std::span<const Card> lead_card, std::span<const uint8_t> sitting_out,
+                            std::span<uint8_t> winners);
+    void follow_masks_avx2(std::span<const uint32_t> hands, std::span<const Suit> trump,
+                           std::span<const Card> lead_card, std::span<uint32_t> masks);
+    void philox_blocks_avx2(std::span<const uint32_t> ctr0, std::span<const uint32_t> ctr1,
+                            std::span<const uint32_t> key0, uint32_t key1, const std::array<std::span<uint32_t>, 4>& out);
+#endif
+
+    bool cpu_has_avx2();
+}
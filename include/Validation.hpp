@@ -0,0 +1,53 @@
+#pragma once
+
+#include <cassert>
+#include <cstdint>
+
+/**
+ * @brief How much checking the engine does on inputs it is handed: actions from bots and cards
+ * passed to hands.
+ *
+ * The build level (EUCHRE_VALIDATION: 0 full, 1 debug, 2 trusted) covers the card and hand
+ * primitives; an env takes a Policy template argument for its per-decision action checks, so one
+ * binary can run envs at different levels.
+ */
+namespace euchre::validation {
+
+    enum class Level : uint8_t {
+        Full,    // Every check runs and throws on failure
+        Debug,   // Checks are asserts: debug builds only
+        Trusted, // No checks; bots and callers are vetted
+    };
+
+#ifndef EUCHRE_VALIDATION
+#define EUCHRE_VALIDATION 0
+#endif
+
+    inline constexpr Level build_level = static_cast<Level>(EUCHRE_VALIDATION);
+
+    /**
+     * @brief An env's action checking.
+     *
+     * A trusted env may still audit: with audit_every = N it checks (and throws on) one decision in
+     * N, so a bad bot is caught in a long run at a fraction of the cost.
+     */
+    struct Policy {
+        Level level = Level::Full;
+        uint32_t audit_every = 0;
+    };
+
+    inline constexpr Policy full {Level::Full};
+    inline constexpr Policy debug {Level::Debug};
+    inline constexpr Policy trusted {Level::Trusted};
+
+    constexpr Policy audited(uint32_t every) {
+        return {Level::Trusted, every};
+    }
+}
+
+// assert(), compiled out in a trusted build even without NDEBUG.
+#if EUCHRE_VALIDATION >= 2
+#define EUCHRE_ASSERT(cond) ((void)0)
+#else
+#define EUCHRE_ASSERT(cond) assert(cond)
+#endif
@@ -0,0 +1,103 @@
+#pragma once
+
+#include <atomic>
+#include <concepts>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <exception>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+/**
+ * @brief A fixed set of worker threads that split index ranges and steal from each other.
+ *
+ * parallel_for() hands every worker a contiguous slice of [0, n). A worker consumes its own slice in
+ * `grain` sized pieces from the front; once it runs dry it steals the back half of the fullest
+ * remaining slice. Callers that need reproducible results should make each index's work independent
+ * of which worker runs it and reduce with order-independent operations.
+ */
+class WorkerPool {
+    public:
+
+    /**
+     * @brief Body of a parallel loop: process [begin, end) on worker `worker`.
+     *
+     * A non-owning reference to any callable, so handing a capturing lambda to parallel_for() never
+     * allocates. parallel_for() blocks until the loop is done, so a temporary lambda outlives it.
+     */
+    class RangeFn {
+        public:
+
+        template <typename F>
+            requires(!std::same_as<std::remove_cvref_t<F>, RangeFn> &&
+                     std::is_invocable_v<F&, std::size_t, std::size_t, std::size_t>)
+        RangeFn(F&& fn) : target(const_cast<void*>(static_cast<const void*>(std::addressof(fn)))),
+                          invoke([](void* f, std::size_t worker, std::size_t begin, std::size_t end) {
+                              (*static_cast<std::remove_reference_t<F>*>(f))(worker, begin, end);
+                          }) {}
+
+        void operator()(std::size_t worker, std::size_t begin, std::size_t end) const {
+            invoke(target, worker, begin, end);
+        }
+
+        private:
+        void* target;
+        void (*invoke)(void*, std::size_t, std::size_t, std::size_t);
+    };
+
+    explicit WorkerPool(std::size_t num_threads);
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+    ~WorkerPool();
+
+    std::size_t size() const { return threads.size(); }
+
+    /**
+     * @brief Run fn over [0, n) and block until every index has been processed.
+     *
+     * The pool runs one loop at a time: calls from several threads are serialized, each waiting for
+     * the ones before it. fn must not call back into the same pool.
+     *
+     * @throws std::logic_error when called from one of this pool's own workers.
+     * @throws The first exception thrown by fn, after all workers have stopped.
+     */
+    void parallel_for(std::size_t n, std::size_t grain, const RangeFn& fn);
+
+    private:
+
+    // [begin, end) packed into one word so owners and thieves can update it with a single CAS.
+    struct alignas(64) Slice {
+        std::atomic<uint64_t> range {0};
+    };
+
+    static constexpr uint64_t pack(uint32_t begin, uint32_t end) {
+        return (static_cast<uint64_t>(begin) << 32) | end;
+    }
+    static constexpr uint32_t begin_of(uint64_t r) { return static_cast<uint32_t>(r >> 32); }
+    static constexpr uint32_t end_of(uint64_t r) { return static_cast<uint32_t>(r); }
+
+    void worker_loop(std::size_t worker);
+    void run_job(std::size_t worker);
+    bool take(std::size_t worker, uint32_t& begin, uint32_t& end);
+    bool steal(std::size_t worker);
+
+    std::vector<std::thread> threads;
+    std::unique_ptr<Slice[]> slices;
+
+    // Held by the one parallel_for() in progress, from writing the slices until the job is done.
+    std::mutex caller_mutex;
+    std::mutex mutex;
+    std::condition_variable start_cv;
+    std::condition_variable done_cv;
+    uint64_t generation = 0;
+    std::size_t active = 0;
+    bool stopping = false;
+
+    const RangeFn* job = nullptr;
+    std::size_t job_grain = 1;
+    std::exception_ptr job_error;
+};
@@ -17,7 +17,8 @@ struct HandStrength {
 };
 
 inline HandStrength evaluate_hand(Hand hand, Suit trump) {
-    auto& t = euchre::tables::tables();
+    // Counts a Joker as trump; standard hands score the same as with the standard tables.
+    auto& t = euchre::tables::tables<euchre::tables::joker_deck>();
     uint32_t h = hand.value();
 
     uint32_t trump_cards = h & t.suit_mask_tbl[trump][trump];
@@ -42,69 +43,31 @@ inline HandStrength evaluate_hand(Hand hand, Suit trump) {
     return {trump_count, has_right, has_left, off_aces, score};
 }
 
+// Lowest, highest and cheapest winning cards work on the set in power order (see
+// Tables::power_order): no loop, no branch. Among cards of equal power the lowest card index is
+// picked, and an empty result is an invalid Card.
+
 // Get the lowest-power card from a bitmask of cards
 inline Card lowest_card(uint32_t cards, Suit trump, Suit led_suit) {
     auto& t = euchre::tables::tables();
-    Card best{};
-    uint8_t best_power = 255;
-
-    uint32_t remaining = cards;
-    while (remaining) {
-        uint32_t bit = remaining & static_cast<uint32_t>(-static_cast<int32_t>(remaining));
-        int idx = std::countr_zero(bit);
-        Card c{static_cast<uint8_t>(idx)};
-        uint8_t power = t.power[trump][led_suit][c];
-        if (power < best_power) {
-            best_power = power;
-            best = c;
-        }
-        remaining &= remaining - 1;
-    }
-    return best;
+    uint32_t ordered = euchre::tables::to_power_order(t, cards, trump, led_suit);
+    return t.power_order_card[trump][led_suit][static_cast<std::size_t>(std::countr_zero(ordered))];
 }
 
 // Get the highest-power card from a bitmask of cards
 inline Card highest_card(uint32_t cards, Suit trump, Suit led_suit) {
     auto& t = euchre::tables::tables();
-    Card best{};
-    uint8_t best_power = 0;
-    bool found = false;
-
-    uint32_t remaining = cards;
-    while (remaining) {
-        uint32_t bit = remaining & static_cast<uint32_t>(-static_cast<int32_t>(remaining));
-        int idx = std::countr_zero(bit);
-        Card c{static_cast<uint8_t>(idx)};
-        uint8_t power = t.power[trump][led_suit][c];
-        if (!found || power > best_power) {
-            best_power = power;
-            best = c;
-            found = true;
-        }
-        remaining &= remaining - 1;
-    }
-    return best;
+    uint32_t ordered = euchre::tables::to_power_order(t, cards, trump, led_suit);
+    uint32_t strongest = ordered & t.strongest_tie[trump][led_suit][static_cast<std::size_t>(std::bit_width(ordered))];
+    return t.power_order_card[trump][led_suit][static_cast<std::size_t>(std::countr_zero(strongest))];
 }
 
 // Get cheapest card that beats a given power level, or invalid if none can
 inline Card cheapest_winner(uint32_t cards, Suit trump, Suit led_suit, uint8_t beat_power) {
     auto& t = euchre::tables::tables();
-    Card best{};
-    uint8_t best_power = 255;
-
-    uint32_t remaining = cards;
-    while (remaining) {
-        uint32_t bit = remaining & static_cast<uint32_t>(-static_cast<int32_t>(remaining));
-        int idx = std::countr_zero(bit);
-        Card c{static_cast<uint8_t>(idx)};
-        uint8_t power = t.power[trump][led_suit][c];
-        if (power > beat_power && power < best_power) {
-            best_power = power;
-            best = c;
-        }
-        remaining &= remaining - 1;
-    }
-    return best;
+    uint32_t ordered = euchre::tables::to_power_order(t, cards, trump, led_suit);
+    uint32_t winners = ordered & (~0u << t.beats_from[trump][led_suit][beat_power]);
+    return t.power_order_card[trump][led_suit][static_cast<std::size_t>(std::countr_zero(winners))];
 }
 
 // Get effective led suit from an observation
@@ -0,0 +1,29 @@
+#pragma once
+
+#include "HeuristicBot.hpp"
+#include "EquityTable.hpp"
+
+/**
+ * @brief Bids by looking up simulated bidding equities instead of a hand strength threshold.
+ *
+ * Orders up, calls and goes alone whenever the EquityTable says that beats the alternative for
+ * this hand, upcard and seat. A key the table does not cover yet falls back to HeuristicBot, as
+ * do the discard and card play.
+ */
+class EquityBidBot : public HeuristicBot {
+public:
+    /**
+     * @param equities Bidding equities; must outlive the bot.
+     */
+    EquityBidBot(std::string name, const EquityTable& equities) : HeuristicBot(std::move(name)), table(equities) {}
+
+protected:
+    ActionId bid_phase_1_action(const Observation& obs, ActionMask action_mask) override;
+    ActionId bid_phase_2_action(const Observation& obs, ActionMask action_mask) override;
+    ActionId go_alone_action(const Observation& obs, ActionMask action_mask) override;
+
+private:
+    std::optional<EquityTable::Values> lookup(const Observation& obs, Suit trump) const;
+
+    const EquityTable& table;
+};
@@ -23,5 +23,11 @@ class IBot {
     virtual ActionId dealer_pickup_discard_action(const Observation& obs, [[maybe_unused]] ActionMask action_mask) = 0;
     virtual ActionId play_trick(const Observation& obs, [[maybe_unused]] ActionMask action_mask) = 0;
 
+    // Rule variant decisions. The defaults decline, and discard the first legal card, so bots that
+    // only know standard rules can still sit at a variant table.
+    virtual ActionId defend_alone_action(const Observation& obs, ActionMask action_mask);
+    virtual ActionId farmer_swap_action(const Observation& obs, ActionMask action_mask);
+    virtual ActionId farmer_discard_action(const Observation& obs, ActionMask action_mask);
+
     std::string m_name {};
 };
\ No newline at end of file
@@ -0,0 +1,106 @@
+#pragma once
+
+#include "IBot.hpp"
+#include "DealSampler.hpp"
+#include "Env.hpp"
+#include "Rng.hpp"
+#include "WorkerPool.hpp"
+#include "bots/HeuristicBot.hpp"
+#include <array>
+#include <chrono>
+#include <vector>
+
+/**
+ * @brief Single-observer information set MCTS over the rest of the hand.
+ *
+ * Every iteration deals the unseen cards afresh, walks the shared tree using only the actions legal
+ * in that deal (subset-armed UCB with availability counts), expands one node and finishes the hand
+ * with HeuristicBot rollouts. Rewards are the hand's point margin for the acting team.
+ *
+ * Root parallelism: num_trees independent trees, each with its own rng stream and node arena, are
+ * searched (on the pool if one is given) and their root visit counts summed. With an iteration
+ * budget the chosen action depends only on the match seed, never on the pool size.
+ *
+ * Only the standard deck and rules are modelled; a search at a variant table throws std::logic_error.
+ */
+class IsmctsBot : public IBot {
+public:
+    /**
+     * @param iterations Iterations per tree.
+     * @param trees Independent trees per decision, merged at the root.
+     * @param budget Stop each tree after this long; zero means always run every iteration.
+     * @param worker_pool Optional pool to search trees on; the bot must not be used from inside it.
+     */
+    IsmctsBot(std::string name, int iterations = 1000, int trees = 1, std::chrono::microseconds budget = {},
+              WorkerPool* worker_pool = nullptr);
+
+    void on_new_match(uint32_t seed) override;
+
+    using Visits = std::array<uint32_t, euchre::action::num_actions>;
+
+    /**
+     * @brief Root visit counts of the last search, summed over its trees.
+     */
+    const Visits& root_visits() const { return last_visits; }
+
+protected:
+    ActionId bid_phase_1_action(const Observation& obs, ActionMask action_mask) override;
+    ActionId bid_phase_2_action(const Observation& obs, ActionMask action_mask) override;
+    ActionId go_alone_action(const Observation& obs, ActionMask action_mask) override;
+    ActionId dealer_pickup_discard_action(const Observation& obs, ActionMask action_mask) override;
+    ActionId play_trick(const Observation& obs, ActionMask action_mask) override;
+
+private:
+    struct Node {
+        uint32_t first_child;
+        uint32_t next_sibling;
+        ActionId action;
+        uint8_t  player;
+        uint32_t visits;
+        uint32_t available;
+        // Sum of rewards for team 0, in [-1, 1] per visit.
+        float    total;
+    };
+
+    /**
+     * @brief Nodes of one tree, reused from search to search; index 0 is the root.
+     */
+    struct Arena {
+        std::vector<Node> nodes;
+
+        void reset();
+        uint32_t add(uint32_t parent, ActionId action, uint8_t player);
+    };
+
+    /**
+     * @brief Everything a worker needs to grow one tree without touching shared state.
+     */
+    struct Worker {
+        Arena arena;
+        Env env {0, {}};
+        HeuristicBot rollout {"rollout"};
+    };
+
+    /**
+     * @brief A full game state that agrees with obs, with the unseen cards dealt at random.
+     */
+    GameState determinize(const Observation& obs, ActionMask action_mask, const DealConstraints& constraints,
+                          const DealSampler& sampler, euchre::rng::Philox4x32& eng) const;
+
+    void grow_tree(const Observation& obs, ActionMask action_mask, const DealConstraints& constraints,
+                   const DealSampler& sampler, euchre::rng::Philox4x32& eng, Worker& worker, Visits& visits);
+
+    ActionId search(const Observation& obs, ActionMask action_mask);
+
+    int num_iterations;
+    int num_trees;
+    std::chrono::microseconds time_budget;
+    WorkerPool* pool;
+    uint32_t seed = 0;
+    uint32_t decisions = 0;
+    std::vector<Worker> workers;
+    // Per-decision scratch, kept so a search does not allocate: root visit counts per tree.
+    DealSampler deal_sampler;
+    std::vector<Visits> per_tree;
+    Visits last_visits {};
+};
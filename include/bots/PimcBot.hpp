@@ -0,0 +1,72 @@
+#pragma once
+
+#include "HeuristicBot.hpp"
+#include "DealSampler.hpp"
+#include "DoubleDummy.hpp"
+#include "Rng.hpp"
+#include "WorkerPool.hpp"
+#include <array>
+#include <chrono>
+#include <vector>
+
+/**
+ * @brief Perfect-information Monte Carlo bot.
+ *
+ * For the discard and every card play it samples deals of the unseen cards that agree with its
+ * Observation, solves each one double dummy and plays the action with the most tricks summed over
+ * the samples. Bidding and going alone are left to HeuristicBot.
+ *
+ * Sample i of the k-th decision in a match always draws the same deal, so with a sample budget
+ * the bot is deterministic regardless of the pool size. A time budget stops sampling early and
+ * trades that for latency.
+ *
+ * Only the standard deck and rules are modelled; a search at a variant table throws std::logic_error.
+ */
+class PimcBot : public HeuristicBot {
+public:
+    /**
+     * @param samples Deals sampled per decision.
+     * @param budget Stop sampling after this long; zero means always take every sample.
+     * @param workers Optional pool to solve samples on; the bot must not be used from inside it.
+     * @param tablebase Optional endgame table the solvers stop at; must outlive the bot.
+     */
+    PimcBot(std::string name, int samples = 24, std::chrono::microseconds budget = {},
+            WorkerPool* workers = nullptr, const Tablebase* tablebase = nullptr);
+
+    void on_new_match(uint32_t seed) override;
+
+protected:
+    ActionId dealer_pickup_discard_action(const Observation& obs, ActionMask action_mask) override;
+    ActionId play_trick(const Observation& obs, ActionMask action_mask) override;
+
+private:
+    using Scores = std::array<int, euchre::constants::num_cards>;
+
+    /**
+     * @brief Deal the unseen cards to the other seats and fill in the trick so far.
+     */
+    void sample_position(const Observation& obs, const DealConstraints& constraints, const DealSampler& sampler,
+                         euchre::rng::Philox4x32& eng, DDPosition& pos) const;
+
+    /**
+     * @brief Add one sample's tricks for every candidate card to scores.
+     */
+    void score_sample(const Observation& obs, const DealConstraints& constraints, const DealSampler& sampler,
+                      uint32_t candidates, uint32_t decision, uint32_t sample, DoubleDummySolver& solver,
+                      Scores& scores) const;
+
+    /**
+     * @brief Sample and score until the sample or time budget runs out, then pick the best card.
+     */
+    Card search(const Observation& obs, uint32_t candidates);
+
+    int num_samples;
+    std::chrono::microseconds time_budget;
+    WorkerPool* pool;
+    uint32_t seed = 0;
+    uint32_t decisions = 0;
+    std::vector<DoubleDummySolver> solvers;
+    // Per-decision scratch, kept so a search does not allocate: one score tally per solver.
+    DealSampler deal_sampler;
+    std::vector<Scores> partial;
+};
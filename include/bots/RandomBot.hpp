@@ -1,5 +1,7 @@
+#pragma once
+
 #include "IBot.hpp"
-#include <random>
+#include "Rng.hpp"
 class RandomBot : public IBot {
 
     public:
@@ -16,6 +18,6 @@ class RandomBot : public IBot {
     virtual ActionId dealer_pickup_discard_action(const Observation& obs, [[maybe_unused]] ActionMask action_mask) override;
     virtual ActionId play_trick(const Observation& obs, [[maybe_unused]] ActionMask action_mask) override;
     
-    std::mt19937 rng;
+    euchre::rng::Philox4x32 rng;
 };
 
@@ -0,0 +1,47 @@
+#pragma once
+
+#include <concepts>
+#include <stdexcept>
+#include "IBot.hpp"
+
+/**
+ * @brief A bot sealed at its concrete type, so every call on it binds statically.
+ *
+ * The class is final, so a call through StaticBot<Bot>* goes straight to this select_action(), which
+ * reaches Bot's phase methods with qualified calls instead of IBot::select_action()'s virtual
+ * dispatch. A bot that overrides select_action() itself keeps its own. Construct it like Bot.
+ */
+template <std::derived_from<IBot> Bot>
+class StaticBot final : public Bot {
+    public:
+
+    using Bot::Bot;
+
+    ActionId select_action(const Observation& obs, ActionMask action_mask) override {
+        if constexpr (!std::same_as<decltype(&Bot::select_action), ActionId (IBot::*)(const Observation&, ActionMask)>) {
+            return Bot::select_action(obs, action_mask);
+        }
+        else {
+            switch (obs.phase) {
+                case Phase::BidRound1:
+                    return Bot::bid_phase_1_action(obs, action_mask);
+                case Phase::BidRound2:
+                    return Bot::bid_phase_2_action(obs, action_mask);
+                case Phase::GoAloneDecision:
+                    return Bot::go_alone_action(obs, action_mask);
+                case Phase::DealerPickupDiscard:
+                    return Bot::dealer_pickup_discard_action(obs, action_mask);
+                case Phase::PlayTrick:
+                    return Bot::play_trick(obs, action_mask);
+                case Phase::DefendAloneDecision:
+                    return Bot::defend_alone_action(obs, action_mask);
+                case Phase::FarmerSwap:
+                    return Bot::farmer_swap_action(obs, action_mask);
+                case Phase::FarmerDiscard:
+                    return Bot::farmer_discard_action(obs, action_mask);
+                default:
+                    throw std::logic_error("Error: Invalid phase.");
+            }
+        }
+    }
+};
@@ -12,7 +12,7 @@ DecodedAction decode_action(ActionId action) {
         uint16_t a = action.v;
 
         if (is_play(action)) {
-            auto c = Card(action);
+            auto c = played_card(action);
             return {
                 .kind = ActionKind::PlayCard,
                 .card = c,
@@ -20,7 +20,7 @@ DecodedAction decode_action(ActionId action) {
             };
         }
         else if (is_discard(action)) {
-            auto c = Card(action - euchre::constants::num_cards);
+            auto c = discarded_card(action);
 
             return {
                 .kind = ActionKind::DiscardCard,
@@ -63,6 +63,34 @@ DecodedAction decode_action(ActionId action) {
                 .suit = {}
             };
         }
+        else if (action == DefendAloneYes) {
+            return {
+                .kind = ActionKind::DefendAlone,
+                .card = {},
+                .suit = {},
+            };
+        }
+        else if (action == DefendAloneNo) {
+            return {
+                .kind = ActionKind::DeclineDefendAlone,
+                .card = {},
+                .suit = {},
+            };
+        }
+        else if (action == FarmerSwapYes) {
+            return {
+                .kind = ActionKind::FarmerSwap,
+                .card = {},
+                .suit = {},
+            };
+        }
+        else if (action == FarmerSwapNo) {
+            return {
+                .kind = ActionKind::DeclineFarmerSwap,
+                .card = {},
+                .suit = {},
+            };
+        }
         return {
             .kind = ActionKind::InvalidAction,
             .card = {},
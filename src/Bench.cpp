@@ -0,0 +1,49 @@
+#include "Bench.hpp"
+#include "Env.hpp"
+#include <chrono>
+
+void play_games(std::array<IBot*, 4> players, int first, int last, int max_steps, BenchResult& result) {
+    play_env_games<Env>(players, first, last, max_steps, result);
+}
+
+BenchResult run_benchmark(std::array<IBot*, 4> players, int num_games, int max_steps) {
+    return run_env_benchmark<Env>(players, num_games, max_steps);
+}
+
+ParallelBenchResult run_parallel_benchmark(WorkerPool& pool, const LineupFactory& factory, int num_games, int max_steps) {
+    std::vector<Lineup> lineups;
+    lineups.reserve(pool.size());
+    for (std::size_t w = 0; w < pool.size(); w++) {
+        lineups.push_back(factory());
+    }
+
+    return run_parallel_games(pool, num_games, [&](std::size_t worker, int first, int last, BenchResult& result) {
+        auto& lineup = lineups[worker];
+        play_games({lineup[0].get(), lineup[1].get(), lineup[2].get(), lineup[3].get()}, first, last, max_steps, result);
+    });
+}
+
+ParallelBenchResult run_parallel_games(WorkerPool& pool, int num_games, const ChunkPlayer& play) {
+    std::vector<BenchResult> partial(pool.size(), BenchResult{});
+    std::vector<ThreadStats> stats(pool.size(), ThreadStats{});
+
+    auto start = std::chrono::high_resolution_clock::now();
+    pool.parallel_for(static_cast<std::size_t>(num_games), 64, [&](std::size_t worker, std::size_t begin, std::size_t end) {
+        auto chunk_start = std::chrono::high_resolution_clock::now();
+        play(worker, static_cast<int>(begin), static_cast<int>(end), partial[worker]);
+        auto chunk_end = std::chrono::high_resolution_clock::now();
+
+        stats[worker].games += static_cast<int>(end - begin);
+        stats[worker].busy_seconds += std::chrono::duration<double>(chunk_end - chunk_start).count();
+    });
+    auto end = std::chrono::high_resolution_clock::now();
+
+    ParallelBenchResult result{BenchResult{}, std::move(stats)};
+    for (const auto& p : partial) {
+        result.total.team0_wins += p.team0_wins;
+        result.total.team1_wins += p.team1_wins;
+        result.total.stalled += p.stalled;
+    }
+    result.total.seconds = std::chrono::duration<double>(end - start).count();
+    return result;
+}
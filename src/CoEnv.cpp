@@ -0,0 +1,233 @@
+#include "CoEnv.hpp"
+#include "Deck.hpp"
+#include "Rules.hpp"
+#include <stdexcept>
+
+using euchre::co::Task;
+
+namespace {
+    // CoEnv plays the standard rules only.
+    constexpr euchre::rules::RuleSet rules {};
+}
+
+CoEnv::CoEnv(unsigned int seed) {
+    state.eng.seed(seed);
+    game = play_game();
+    run_until_suspended(game.handle);
+}
+
+void CoEnv::resume(ActionId action) {
+    if (done() || !suspended) {
+        throw std::logic_error("No pending decision to resume");
+    }
+    if (!euchre::action::in_mask(action, pending_mask)) {
+        throw std::invalid_argument("Returned action_id did not match the action mask");
+    }
+    answer = action;
+    std::coroutine_handle<> h = suspended;
+    suspended = {};
+    run_until_suspended(h);
+}
+
+void CoEnv::run_until_suspended(std::coroutine_handle<> h) {
+    h.resume();
+    if (game.handle.done() && game.handle.promise().exception) {
+        std::rethrow_exception(game.handle.promise().exception);
+    }
+}
+
+Task CoEnv::play_game() {
+    while (!done()) {
+        co_await play_hand();
+        if (state.scores[0] >= rules.target_score || state.scores[1] >= rules.target_score) {
+            state.status = GameState::GameStatus::GameOver;
+        }
+    }
+}
+
+Task CoEnv::play_hand() {
+    HandState& hs = state.hand_state;
+
+    deal();
+    co_await bid_round_1();
+    if (hs.phase == Phase::BidRound2) {
+        co_await bid_round_2();
+        if (hs.phase == Phase::Deal) {
+            // Everyone passed. Redeal with the same dealer.
+            co_return;
+        }
+    }
+    co_await go_alone_decision();
+    co_await dealer_pickup_discard();
+
+    hs.lead_player = euchre::rules::next_player(state.dealer, hs.going_alone, hs.maker_player);
+    for (int trick = 0; trick < 5; trick++) {
+        co_await request_tricks();
+        calc_winner();
+        hs.tricks_played++;
+        hs.lead_card = euchre::constants::invalid_card;
+        hs.num_played = 0;
+    }
+
+    hs.phase = Phase::HandOver;
+    hand_over();
+}
+
+void CoEnv::deal() {
+    state.eng.seek(state.hands_dealt++);
+    Deal d = deal_cards(state.eng);
+    for (uint8_t i = 0; i < euchre::constants::num_players; i++) {
+        state.hand_state.hands[i] = Hand{d.hands[i]};
+    }
+    state.hand_state.deck = d.kitty;
+    state.hand_state.face_up_card = d.face_up;
+    state.hand_state.phase = Phase::BidRound1;
+}
+
+Task CoEnv::bid_round_1() {
+    HandState& hs = state.hand_state;
+    ActionMask action_mask = euchre::action::make_mask(euchre::action::Pass, euchre::action::OrderUp);
+    uint8_t current_player = state.dealer;
+
+    do {
+        current_player = static_cast<uint8_t>((current_player + 1) % euchre::constants::num_players);
+        ActionId action = co_await decide(current_player, action_mask);
+
+        if (action == euchre::action::OrderUp) {
+            hs.trump = hs.face_up_card.get_suit();
+            hs.maker_team = current_player % 2;
+            hs.maker_player = current_player;
+            hs.phase = Phase::GoAloneDecision;
+            co_return;
+        }
+    } while (current_player != state.dealer);
+    hs.phase = Phase::BidRound2;
+}
+
+Task CoEnv::go_alone_decision() {
+    HandState& hs = state.hand_state;
+    ActionMask action_mask = euchre::action::make_mask(euchre::action::GoAloneYes, euchre::action::GoAloneNo);
+    ActionId action = co_await decide(hs.maker_player, action_mask);
+    if (action == euchre::action::GoAloneYes) {
+        hs.going_alone = true;
+    }
+    hs.phase = Phase::DealerPickupDiscard;
+}
+
+Task CoEnv::dealer_pickup_discard() {
+    HandState& hs = state.hand_state;
+    hs.hands[state.dealer].give_card(hs.face_up_card);
+    ActionMask action_mask = static_cast<ActionMask>(hs.hands[state.dealer].value()) << euchre::constants::num_cards;
+    ActionId action = co_await decide(state.dealer, action_mask);
+    hs.hands[state.dealer].remove_card(Card{static_cast<uint8_t>(action.v - euchre::constants::num_cards)});
+    hs.phase = Phase::PlayTrick;
+}
+
+Task CoEnv::bid_round_2() {
+    HandState& hs = state.hand_state;
+    ActionMask action_mask = euchre::action::make_mask(
+        euchre::action::Pass,
+        euchre::action::call_trump(Suit::C),
+        euchre::action::call_trump(Suit::H),
+        euchre::action::call_trump(Suit::S),
+        euchre::action::call_trump(Suit::D)
+    ) & ~euchre::action::a2m(euchre::action::call_trump(hs.face_up_card.get_suit()));
+
+    uint8_t current_player = state.dealer;
+    do {
+        current_player = static_cast<uint8_t>((current_player + 1) % euchre::constants::num_players);
+        if (current_player == state.dealer && hs.stick_the_dealer) {
+            action_mask &= ~euchre::action::a2m(euchre::action::Pass);
+        }
+
+        ActionId action = co_await decide(current_player, action_mask);
+        if (action != euchre::action::Pass) {
+            hs.trump = Suit(action.v - euchre::action::CallTrumpBase.v);
+            hs.maker_player = current_player;
+            hs.maker_team = current_player % 2;
+            hs.phase = Phase::GoAloneDecision;
+            co_return;
+        }
+    } while (current_player != state.dealer);
+
+    // Everyone passed. Redeal.
+    hs.reset();
+}
+
+Task CoEnv::request_tricks() {
+    HandState& hs = state.hand_state;
+    uint8_t current_player = hs.lead_player;
+
+    do {
+        ActionMask action_mask = hs.num_played == 0
+            ? static_cast<ActionMask>(hs.hands[current_player].value())
+            : static_cast<ActionMask>(hs.hands[current_player].get_valid_hand(hs.lead_card, hs.trump));
+
+        ActionId action = co_await decide(current_player, action_mask);
+        Card c {static_cast<uint8_t>(action.v)};
+        hs.hands[current_player].remove_card(c);
+        hs.record_play(current_player, c);
+        if (hs.num_played == 0) {
+            hs.lead_card = c;
+        }
+        hs.trick_cards[current_player] = c;
+        hs.num_played++;
+        current_player = euchre::rules::next_player(current_player, hs.going_alone, hs.maker_player);
+    } while (current_player != hs.lead_player);
+}
+
+void CoEnv::calc_winner() {
+    HandState& hs = state.hand_state;
+    uint8_t winner = euchre::rules::trick_winner(hs.trick_cards, hs.trump, hs.lead_card, hs.going_alone, hs.maker_player);
+    hs.tricks_won[winner % 2]++;
+    hs.lead_player = winner;
+}
+
+void CoEnv::hand_over() {
+    HandState& hs = state.hand_state;
+    auto score = euchre::rules::score_hand(hs.maker_team, hs.tricks_won[hs.maker_team], hs.going_alone,
+                                           rules.lone_march_points);
+    state.scores[score.team] = static_cast<uint8_t>(state.scores[score.team] + score.points);
+    state.dealer = static_cast<uint8_t>((state.dealer + 1) % euchre::constants::num_players);
+    hs.reset();
+}
+
+CoScheduler::CoScheduler(std::size_t num_games, unsigned int seed) {
+    games.reserve(num_games);
+    for (std::size_t g = 0; g < num_games; g++) {
+        games.push_back(std::make_unique<CoEnv>(static_cast<unsigned int>(seed + g)));
+    }
+    live.reserve(num_games);
+    observations.reserve(num_games);
+    masks.reserve(num_games);
+    actions.reserve(num_games);
+}
+
+std::size_t CoScheduler::run(const BatchPolicy& policy) {
+    std::size_t calls = 0;
+
+    for (;;) {
+        live.clear();
+        observations.clear();
+        masks.clear();
+        for (std::size_t g = 0; g < games.size(); g++) {
+            if (games[g]->done()) {
+                continue;
+            }
+            live.push_back(g);
+            observations.push_back(games[g]->observation());
+            masks.push_back(games[g]->pending_mask);
+        }
+        if (live.empty()) {
+            return calls;
+        }
+
+        actions.resize(live.size());
+        policy(observations, masks, actions);
+        calls++;
+
+        for (std::size_t i = 0; i < live.size(); i++) {
+            games[live[i]]->resume(actions[i]);
+        }
+    }
+}
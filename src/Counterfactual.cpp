@@ -0,0 +1,60 @@
+#include "Counterfactual.hpp"
+#include <bit>
+
+namespace {
+
+Env& scratch_env() {
+    thread_local Env scratch{0, {}};
+    return scratch;
+}
+
+/**
+ * @brief Play until hand `hand` is scored (or the game ends, for RolloutHorizon::Game).
+ */
+void roll_out(Env& env, uint32_t hand, RolloutHorizon horizon) {
+    while (horizon == RolloutHorizon::Game || env.state.hands_dealt == hand) {
+        auto decision = env.next_decision();
+        if (!decision) {
+            break;
+        }
+        env.apply(env.players[decision->player]->select_action(decision->obs, decision->mask));
+    }
+}
+
+}
+
+CounterfactualValues counterfactual_values(const Env& env, std::array<IBot*, 4> policy, int n_rollouts,
+                                           RolloutHorizon horizon) {
+    Env& scratch = scratch_env();
+    scratch.players = policy;
+    scratch.restore(env.snapshot());
+
+    CounterfactualValues result;
+    auto decision = scratch.next_decision();
+    if (!decision || n_rollouts <= 0) {
+        return result;
+    }
+    result.player = decision->player;
+    result.mask = decision->mask;
+
+    // Start from the advanced state so every branch skips the dealing/scoring that led here.
+    GameSnapshot root = scratch.snapshot();
+    uint8_t team = result.player % 2;
+    uint8_t other = team ^ 1;
+
+    for (ActionMask rest = result.mask; rest; rest &= rest - 1) {
+        ActionId action{static_cast<uint16_t>(std::countr_zero(rest))};
+        int total = 0;
+        for (int r = 0; r < n_rollouts; r++) {
+            for (uint8_t seat = 0; seat < euchre::constants::num_players; seat++) {
+                policy[seat]->on_new_match(static_cast<uint32_t>(r) * euchre::constants::num_players + seat);
+            }
+            scratch.restore(root);
+            scratch.apply(action);
+            roll_out(scratch, root.hands_dealt, horizon);
+            total += (scratch.state.scores[team] - root.scores[team]) - (scratch.state.scores[other] - root.scores[other]);
+        }
+        result.value[action] = static_cast<double>(total) / n_rollouts;
+    }
+    return result;
+}
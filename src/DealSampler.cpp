@@ -0,0 +1,208 @@
+#include "DealSampler.hpp"
+#include "Rules.hpp"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::size_t np = euchre::constants::num_players;
+
+constexpr auto binomials = [] {
+    std::array<std::array<uint64_t, 25>, 25> c {};
+    for (std::size_t n = 0; n < c.size(); n++) {
+        c[n][0] = 1;
+        for (std::size_t k = 1; k <= n; k++) {
+            c[n][k] = c[n - 1][k - 1] + c[n - 1][k];
+        }
+    }
+    return c;
+}();
+
+}
+
+DealConstraints DealConstraints::from_observation(const Observation& obs) {
+    DealConstraints c;
+    uint8_t me = obs.player;
+    uint32_t mine = obs.hand.value();
+    bool playing = obs.phase == Phase::PlayTrick;
+    uint8_t sitting_out = obs.going_alone ? euchre::rules::sitting_out_player(obs.maker_player)
+                                          : euchre::constants::num_players;
+
+    c.me = me;
+    c.dealer = obs.dealer;
+    c.lead_player = me;
+    c.fixed[me] = mine;
+
+    // Walk back from our seat to find who has played to this trick.
+    uint32_t seen = mine | obs.played;
+    if (playing) {
+        for (uint8_t i = 0; i < obs.num_played; i++) {
+            c.lead_player = euchre::rules::previous_player(c.lead_player, obs.going_alone, obs.maker_player);
+            c.trick_seats = static_cast<uint8_t>(c.trick_seats | 1u << c.lead_player);
+            seen |= 1u << obs.trick_cards[c.lead_player];
+        }
+    }
+
+    // The dealer picks up the face up card in either round. An ordered up card is taken to be kept;
+    // after a round 2 call it may have been kept or buried. Either way a dealer that has shown out
+    // of its suit must have buried it.
+    uint32_t face_up = 1u << obs.face_up_card;
+    c.face_up = face_up;
+    bool dealer_may_hold = playing && obs.dealer != me && obs.dealer != sitting_out && (seen & face_up) == 0 &&
+                           (obs.voids[obs.dealer] & face_up) == 0;
+    bool ordered_up = obs.face_up_card.get_suit() == obs.trump;
+    bool dealer_has_face_up = dealer_may_hold && ordered_up;
+    bool dealer_may_keep = dealer_may_hold && !ordered_up;
+    c.unseen = euchre::constants::deck_reset & ~seen & ~face_up;
+    if (dealer_may_keep) {
+        c.unseen |= face_up;
+    }
+
+    auto my_count = static_cast<uint8_t>(std::popcount(mine));
+    for (uint8_t seat = 0; seat < np; seat++) {
+        c.allowed[seat] = euchre::constants::deck_reset & ~obs.voids[seat];
+        if (seat != obs.dealer) {
+            c.allowed[seat] &= ~face_up;
+        }
+        if (seat == me || seat == sitting_out) {
+            continue;
+        }
+        bool in_trick = (c.trick_seats & (1u << seat)) != 0;
+        uint8_t need = playing ? static_cast<uint8_t>(my_count - (in_trick ? 1 : 0)) : 5;
+        if (seat == obs.dealer && dealer_has_face_up) {
+            c.fixed[seat] = face_up;
+            need--;
+        }
+        c.need[seat] = need;
+    }
+    return c;
+}
+
+bool DealConstraints::standard_table(const Observation& obs) {
+    constexpr uint32_t joker = 1u << euchre::constants::joker;
+    bool joker_seen = ((obs.hand.value() | obs.played) & joker) != 0 || obs.face_up_card.is_joker() ||
+                      std::ranges::any_of(obs.trick_cards, [](Card c) { return c.is_joker(); });
+    return !joker_seen && !obs.defending_alone;
+}
+
+DealConstraints DealConstraints::without_voids() const {
+    DealConstraints c = *this;
+    for (uint8_t seat = 0; seat < np; seat++) {
+        c.allowed[seat] = euchre::constants::deck_reset & ~(seat != dealer ? face_up : 0u);
+    }
+    return c;
+}
+
+DealSampler::DealSampler() {
+    // Worst case: a group per seat pattern, each with every take of up to five cards per seat.
+    std::size_t max_groups = std::size_t{1} << max_seats;
+    groups.reserve(max_groups);
+    splits.reserve(max_groups * num_states);
+    ways.reserve((max_groups + 1) * num_states);
+}
+
+DealSampler::DealSampler(const DealConstraints& constraints) : DealSampler() {
+    reset(constraints);
+}
+
+bool DealSampler::reset_for(const Observation& obs, DealConstraints& constraints) {
+    if (!DealConstraints::standard_table(obs)) {
+        throw std::logic_error("Search bots only play the standard deck and rules");
+    }
+    constraints = DealConstraints::from_observation(obs);
+    reset(constraints);
+    if (!feasible()) {
+        constraints = constraints.without_voids();
+        reset(constraints);
+    }
+    return feasible();
+}
+
+void DealSampler::reset(const DealConstraints& constraints) {
+    unseen = constraints.unseen;
+    fixed = constraints.fixed;
+    seats = {};
+    demand = {};
+    groups.clear();
+    splits.clear();
+    ways.clear();
+    total = 0;
+
+    std::size_t num_seats = 0;
+    for (uint8_t seat = 0; seat < np; seat++) {
+        if (seat == constraints.me || constraints.need[seat] == 0) {
+            continue;
+        }
+        if (num_seats == max_seats || constraints.need[seat] >= radix) {
+            return;
+        }
+        seats[num_seats] = seat;
+        demand[num_seats] = constraints.need[seat];
+        num_seats++;
+    }
+
+    // Group the unseen cards by the seats allowed to hold them.
+    std::array<uint32_t, 1u << max_seats> by_pattern {};
+    for (uint32_t rest = unseen; rest; rest &= rest - 1) {
+        auto c = static_cast<uint8_t>(std::countr_zero(rest));
+        unsigned pattern = 0;
+        for (std::size_t s = 0; s < num_seats; s++) {
+            if (constraints.allowed[seats[s]] & (1u << c)) {
+                pattern |= 1u << s;
+            }
+        }
+        by_pattern[pattern] |= 1u << c;
+    }
+
+    for (unsigned pattern = 0; pattern < by_pattern.size(); pattern++) {
+        uint32_t cards = by_pattern[pattern];
+        if (cards == 0) {
+            continue;
+        }
+        auto size = static_cast<uint8_t>(std::popcount(cards));
+        auto limit = [&](std::size_t s, uint8_t left) -> uint8_t {
+            return (pattern >> s) & 1u ? std::min<uint8_t>(left, radix - 1) : 0;
+        };
+
+        Group grp {cards, static_cast<uint32_t>(splits.size()), 0};
+        Demand take {};
+        for (take[0] = 0; take[0] <= limit(0, size); take[0]++) {
+            auto left0 = static_cast<uint8_t>(size - take[0]);
+            for (take[1] = 0; take[1] <= limit(1, left0); take[1]++) {
+                auto left1 = static_cast<uint8_t>(left0 - take[1]);
+                for (take[2] = 0; take[2] <= limit(2, left1); take[2]++) {
+                    // Whatever the seats do not take is buried.
+                    splits.push_back({take, binomials[size][take[0]] * binomials[left0][take[1]] *
+                                            binomials[left1][take[2]]});
+                }
+            }
+        }
+        grp.end_split = static_cast<uint32_t>(splits.size());
+        groups.push_back(grp);
+    }
+
+    ways.assign((groups.size() + 1) * num_states, ~uint64_t{0});
+    total = completions(0, demand);
+}
+
+uint64_t DealSampler::completions(std::size_t g, const Demand& r) {
+    uint64_t& memo = ways[g * num_states + index(r)];
+    if (memo != ~uint64_t{0}) {
+        return memo;
+    }
+    if (g == groups.size()) {
+        memo = r == Demand{} ? 1 : 0;
+        return memo;
+    }
+
+    uint64_t sum = 0;
+    for (uint32_t i = groups[g].first_split; i < groups[g].end_split; i++) {
+        const Split& s = splits[i];
+        if (fits(s.take, r)) {
+            sum += s.ways * completions(g + 1, minus(r, s.take));
+        }
+    }
+    memo = sum;
+    return sum;
+}
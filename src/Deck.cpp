@@ -1,11 +1,101 @@
 #include "Deck.hpp"
-#include "Card.hpp"
-#include <bit>
 
-Card draw_card(uint32_t& remaining_cards, std::mt19937& rng) {
+#if defined(EUCHRE_HAS_BMI2_DEAL)
+#include <immintrin.h>
+#endif
 
-    uint32_t bit = pick_random_bit(remaining_cards, rng);
-    Card c {bit};
-    remaining_cards &= ~(1u << c);
-    return c;
-}
\ No newline at end of file
+namespace {
+
+/**
+ * @brief The k-th lowest set bit of mask, as a one bit mask. Narrows to a byte before clearing bits.
+ */
+inline uint32_t select_bit(uint32_t mask, uint32_t k) {
+    uint32_t base = 0;
+    uint32_t low = static_cast<uint32_t>(std::popcount(mask & 0xFFFFu));
+    if (k >= low) {
+        k -= low;
+        base = 16;
+    }
+    uint32_t m = (mask >> base) & 0xFFFFu;
+    low = static_cast<uint32_t>(std::popcount(m & 0xFFu));
+    if (k >= low) {
+        k -= low;
+        base += 8;
+        m >>= 8;
+    }
+    while (k--) {
+        m &= m - 1;
+    }
+    return (m & -m) << base;
+}
+
+}
+
+Deal unrank_deal_portable(const DealRanks& ranks, uint32_t deck) {
+    Deal deal;
+    std::size_t i = 0;
+    for (auto& hand : deal.hands) {
+        for (int j = 0; j < 5; j++) {
+            uint32_t bit = select_bit(deck, ranks[i++]);
+            hand |= bit;
+            deck ^= bit;
+        }
+    }
+    uint32_t bit = select_bit(deck, ranks[i]);
+    deal.face_up = Card{static_cast<uint8_t>(std::countr_zero(bit))};
+    deal.kitty = deck ^ bit;
+    return deal;
+}
+
+#if defined(EUCHRE_HAS_BMI2_DEAL)
+
+// Same loop as the portable unrank; pdep deposits 1 << k onto the k-th set bit of the deck directly.
+__attribute__((target("bmi2")))
+Deal unrank_deal_bmi2(const DealRanks& ranks, uint32_t deck) {
+    Deal deal;
+    std::size_t i = 0;
+    for (auto& hand : deal.hands) {
+        for (int j = 0; j < 5; j++) {
+            uint32_t bit = _pdep_u32(1u << ranks[i++], deck);
+            hand |= bit;
+            deck ^= bit;
+        }
+    }
+    uint32_t bit = _pdep_u32(1u << ranks[i], deck);
+    deal.face_up = Card{static_cast<uint8_t>(std::countr_zero(bit))};
+    deal.kitty = deck ^ bit;
+    return deal;
+}
+
+bool cpu_has_bmi2() {
+    return __builtin_cpu_supports("bmi2");
+}
+
+#else
+
+bool cpu_has_bmi2() {
+    return false;
+}
+
+#endif
+
+namespace {
+
+using UnrankFn = Deal (*)(const DealRanks&, uint32_t);
+
+UnrankFn pick_unrank() {
+#if defined(EUCHRE_HAS_BMI2_DEAL)
+    if (cpu_has_bmi2()) {
+        return unrank_deal_bmi2;
+    }
+#endif
+    return unrank_deal_portable;
+}
+
+const UnrankFn unrank_impl = pick_unrank();
+
+}
+
+Deal unrank_deal(const DealRanks& ranks, uint32_t deck) {
+    return unrank_impl(ranks, deck);
+}
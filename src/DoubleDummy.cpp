@@ -0,0 +1,331 @@
+#include "DoubleDummy.hpp"
+#include "Rules.hpp"
+#include "Tablebase.hpp"
+#include "Tables.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace {
+
+// Bounds live in the top bits of k2, above the two 24 bit hands.
+constexpr int lower_shift = 48;
+constexpr int upper_shift = 52;
+constexpr uint64_t key2_mask = (uint64_t{1} << lower_shift) - 1;
+
+inline uint64_t mix(uint64_t x) {
+    x ^= x >> 31;
+    x *= 0x7FB5D329728EA185ull;
+    x ^= x >> 27;
+    x *= 0x81DADEF4BC2DD44Dull;
+    x ^= x >> 33;
+    return x;
+}
+
+}
+
+DDPosition DDPosition::from_hand_state(const HandState& hs) {
+    DDPosition pos;
+    for (int p = 0; p < euchre::constants::num_players; p++) {
+        pos.hands[static_cast<std::size_t>(p)] = hs.hands[p].value();
+    }
+    pos.trick_cards = hs.trick_cards;
+    pos.trump = hs.trump;
+    pos.lead_player = hs.lead_player;
+    pos.current_player = hs.current_player;
+    pos.num_played = hs.num_played;
+    pos.going_alone = hs.going_alone;
+    pos.maker_player = hs.maker_player;
+    pos.tricks_won = {hs.tricks_won[0], hs.tricks_won[1]};
+    return pos;
+}
+
+DoubleDummySolver::DoubleDummySolver(uint32_t tt_bits) : t(euchre::tables::tables()), table(std::size_t{1} << tt_bits), mask((uint64_t{1} << tt_bits) - 1) {}
+
+void DoubleDummySolver::clear() {
+    std::fill(table.begin(), table.end(), Entry{});
+}
+
+void DoubleDummySolver::load(const DDPosition& pos) {
+    hands = pos.hands;
+    trump = pos.trump;
+    going_alone = pos.going_alone;
+    maker_player = pos.maker_player;
+    trick_size = going_alone ? 3 : 4;
+    if (going_alone) {
+        hands[euchre::rules::sitting_out_player(maker_player)] = 0;
+    }
+    // Bit 0 marks a used entry, so an empty slot never matches.
+    context = 1u | (uint64_t{trump} << 1) | (uint64_t{going_alone} << 3) | (uint64_t{maker_player} << 4);
+
+    lead_player = pos.lead_player;
+    current_player = pos.lead_player;
+    num_played = 0;
+    best_player = pos.lead_player;
+    best_power = 0;
+    led = Suit::None;
+    in_trick = 0;
+
+    // Replay the trick in progress to rebuild the running winner.
+    for (uint8_t i = 0; i < pos.num_played; i++) {
+        Card c = pos.trick_cards[current_player];
+        if (i == 0) {
+            led = t.eff_suit_tbl[trump][c];
+        }
+        uint8_t power = t.power[trump][led][c];
+        if (power > best_power) {
+            best_power = power;
+            best_player = current_player;
+        }
+        in_trick |= 1u << c;
+        num_played++;
+        current_player = euchre::rules::next_player(current_player, going_alone, maker_player);
+    }
+}
+
+int DoubleDummySolver::remaining_tricks() const {
+    // The leader has already given up a card if a trick is under way.
+    return std::popcount(hands[lead_player]) + (num_played > 0 ? 1 : 0);
+}
+
+uint32_t DoubleDummySolver::legal_cards(uint8_t player) const {
+    uint32_t h = hands[player];
+    if (num_played == 0) {
+        return h;
+    }
+    uint32_t follow = h & t.suit_mask_tbl[trump][led];
+    return follow ? follow : h;
+}
+
+uint32_t DoubleDummySolver::distinct_legal_cards(uint8_t player) const {
+    uint32_t in_play = hands[0] | hands[1] | hands[2] | hands[3] | in_trick;
+    return euchre::rules::distinct_moves(legal_cards(player), trump, euchre::constants::deck_reset & ~in_play);
+}
+
+int DoubleDummySolver::order_moves(uint32_t legal, std::array<Card, 6>& moves) const {
+    std::array<int, 6> keys {};
+    int n = 0;
+    bool partner_winning = num_played > 0 && (best_player % 2) == (current_player % 2);
+
+    for (uint32_t rest = legal; rest; rest &= rest - 1) {
+        Card c {static_cast<uint8_t>(std::countr_zero(rest))};
+        int key = 0;
+        if (num_played == 0) {
+            // Lead strong cards first.
+            key = -t.power[trump][t.eff_suit_tbl[trump][c]][c];
+        }
+        else {
+            uint8_t power = t.power[trump][led][c];
+            // Cheapest winner first, then throw away from the bottom.
+            key = (power > best_power && !partner_winning) ? power : 256 + power;
+        }
+
+        int i = n++;
+        while (i > 0 && keys[static_cast<std::size_t>(i - 1)] > key) {
+            keys[static_cast<std::size_t>(i)] = keys[static_cast<std::size_t>(i - 1)];
+            moves[static_cast<std::size_t>(i)] = moves[static_cast<std::size_t>(i - 1)];
+            i--;
+        }
+        keys[static_cast<std::size_t>(i)] = key;
+        moves[static_cast<std::size_t>(i)] = c;
+    }
+    return n;
+}
+
+int DoubleDummySolver::make(Card c, Undo& undo) {
+    undo = {lead_player, current_player, num_played, best_player, best_power, led, in_trick};
+
+    hands[current_player] ^= 1u << c;
+    in_trick |= 1u << c;
+    if (num_played == 0) {
+        led = t.eff_suit_tbl[trump][c];
+    }
+    uint8_t power = t.power[trump][led][c];
+    if (power > best_power) {
+        best_power = power;
+        best_player = current_player;
+    }
+
+    if (++num_played < trick_size) {
+        current_player = euchre::rules::next_player(current_player, going_alone, maker_player);
+        return -1;
+    }
+
+    // Trick complete: the winner leads the next one.
+    uint8_t winner = best_player;
+    lead_player = winner;
+    current_player = winner;
+    num_played = 0;
+    best_power = 0;
+    led = Suit::None;
+    in_trick = 0;
+    return winner % 2 == 0 ? 1 : 0;
+}
+
+void DoubleDummySolver::unmake(Card c, const Undo& undo) {
+    lead_player = undo.lead_player;
+    current_player = undo.current_player;
+    num_played = undo.num_played;
+    best_player = undo.best_player;
+    best_power = undo.best_power;
+    led = undo.led;
+    in_trick = undo.in_trick;
+    hands[current_player] ^= 1u << c;
+}
+
+int DoubleDummySolver::last_trick() const {
+    // Every seat holds one card, so the trick plays itself.
+    uint8_t p = lead_player;
+    Suit last_led = t.eff_suit_tbl[trump][Card{static_cast<uint8_t>(std::countr_zero(hands[p]))}];
+    uint8_t winner = p;
+    uint8_t power = 0;
+    for (uint8_t i = 0; i < trick_size; i++) {
+        uint8_t pw = t.power[trump][last_led][Card{static_cast<uint8_t>(std::countr_zero(hands[p]))}];
+        if (pw > power) {
+            power = pw;
+            winner = p;
+        }
+        p = euchre::rules::next_player(p, going_alone, maker_player);
+    }
+    return winner % 2 == 0 ? 1 : 0;
+}
+
+int DoubleDummySolver::search(int alpha, int beta) {
+    node_count++;
+
+    Entry* entry = nullptr;
+    uint64_t k1 = 0;
+    uint64_t k2 = 0;
+    int alpha_orig = alpha;
+    int beta_orig = beta;
+
+    if (num_played == 0) {
+        int remaining = std::popcount(hands[lead_player]);
+        if (remaining == 0 || beta <= 0) {
+            return 0;
+        }
+        if (alpha >= remaining) {
+            return remaining;
+        }
+        if (remaining == 1) {
+            return last_trick();
+        }
+        if (tablebase && remaining <= tablebase->max_cards()) {
+            int leader_team = tablebase->probe(hands, trump, lead_player, going_alone, maker_player);
+            return lead_player % 2 == 0 ? leader_team : remaining - leader_team;
+        }
+
+        k1 = hands[0] | (uint64_t{hands[1]} << 24) | (uint64_t{lead_player} << 48) | (context << 50);
+        k2 = hands[2] | (uint64_t{hands[3]} << 24);
+        entry = &table[mix(k1 ^ (k2 * 0x9E3779B97F4A7C15ull)) & mask];
+        if (entry->k1 == k1 && (entry->k2 & key2_mask) == k2) {
+            int lower = static_cast<int>((entry->k2 >> lower_shift) & 0xF);
+            int upper = static_cast<int>((entry->k2 >> upper_shift) & 0xF);
+            if (lower == upper || lower >= beta) {
+                return lower;
+            }
+            if (upper <= alpha) {
+                return upper;
+            }
+            alpha = std::max(alpha, lower);
+            beta = std::min(beta, upper);
+        }
+    }
+
+    std::array<Card, 6> moves;
+    int n = order_moves(distinct_legal_cards(current_player), moves);
+    bool maximizing = current_player % 2 == 0;
+    int best = maximizing ? -1 : 99;
+
+    for (int i = 0; i < n; i++) {
+        Card c = moves[static_cast<std::size_t>(i)];
+        Undo undo;
+        int won = make(c, undo);
+        int value = 0;
+        if (won < 0) {
+            value = search(alpha, beta);
+        }
+        else {
+            value = won + search(alpha - won, beta - won);
+        }
+        unmake(c, undo);
+
+        if (maximizing) {
+            best = std::max(best, value);
+            alpha = std::max(alpha, value);
+        }
+        else {
+            best = std::min(best, value);
+            beta = std::min(beta, value);
+        }
+        if (alpha >= beta) {
+            break;
+        }
+    }
+
+    if (entry) {
+        uint64_t lower = 0;
+        uint64_t upper = static_cast<uint64_t>(std::popcount(hands[lead_player]));
+        if (entry->k1 == k1 && (entry->k2 & key2_mask) == k2) {
+            lower = (entry->k2 >> lower_shift) & 0xF;
+            upper = (entry->k2 >> upper_shift) & 0xF;
+        }
+        auto v = static_cast<uint64_t>(best);
+        if (best <= alpha_orig) {
+            upper = std::min(upper, v);
+        }
+        else if (best >= beta_orig) {
+            lower = std::max(lower, v);
+        }
+        else {
+            lower = upper = v;
+        }
+        entry->k1 = k1;
+        entry->k2 = k2 | (lower << lower_shift) | (upper << upper_shift);
+    }
+    return best;
+}
+
+std::array<uint8_t, 2> DoubleDummySolver::solve(const DDPosition& pos) {
+    load(pos);
+    int remaining = remaining_tricks();
+    int team0 = search(0, remaining);
+    return {static_cast<uint8_t>(pos.tricks_won[0] + team0), static_cast<uint8_t>(pos.tricks_won[1] + remaining - team0)};
+}
+
+std::array<int8_t, euchre::constants::num_cards> DoubleDummySolver::solve_moves(const DDPosition& pos) {
+    std::array<int8_t, euchre::constants::num_cards> values;
+    values.fill(-1);
+
+    load(pos);
+    int remaining = remaining_tricks();
+    uint8_t team = current_player % 2;
+    uint32_t legal = legal_cards(current_player);
+    uint32_t distinct = distinct_legal_cards(current_player);
+    for (uint32_t rest = distinct; rest; rest &= rest - 1) {
+        Card c {static_cast<uint8_t>(std::countr_zero(rest))};
+        Undo undo;
+        int won = make(c, undo);
+        int team0 = std::max(won, 0) + search(0, remaining);
+        unmake(c, undo);
+        int own = team == 0 ? team0 : remaining - team0;
+        values[c] = static_cast<int8_t>(pos.tricks_won[team] + own);
+    }
+
+    // Every other card is worth the same as the nearest distinct card above it, the top of its run.
+    for (uint32_t rest = legal & ~distinct; rest; rest &= rest - 1) {
+        Card c {static_cast<uint8_t>(std::countr_zero(rest))};
+        uint32_t above = distinct & t.higher_tbl[trump][c];
+        Card top = c;
+        int closest = -1;
+        for (; above; above &= above - 1) {
+            Card m {static_cast<uint8_t>(std::countr_zero(above))};
+            int higher = std::popcount(t.higher_tbl[trump][m]);
+            if (higher > closest) {
+                closest = higher;
+                top = m;
+            }
+        }
+        values[c] = values[top];
+    }
+    return values;
+}
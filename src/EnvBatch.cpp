@@ -0,0 +1,296 @@
+#include "EnvBatch.hpp"
+#include "Deck.hpp"
+#include "Rules.hpp"
+#include <stdexcept>
+
+namespace {
+    constexpr std::size_t np = euchre::constants::num_players;
+    // The pool plays the standard rules only.
+    constexpr euchre::rules::RuleSet rules {};
+}
+
+EnvBatch::EnvBatch(std::size_t count, uint32_t seed) :
+    masks(count),
+    current_player(count),
+    rewards(count * 2),
+    dones(count),
+    hands(count * np),
+    trick_cards(count * np),
+    played_by(count * np),
+    void_suits(count * np),
+    tricks_won(count * 2),
+    scores(count * 2),
+    dealer(count),
+    phase(count),
+    deck(count),
+    face_up_card(count),
+    trump(count),
+    lead_card(count),
+    maker_player(count),
+    going_alone(count),
+    lead_player(count),
+    num_played(count),
+    tricks_played(count),
+    game_seed(count),
+    hands_dealt(count),
+    eng(count),
+    num_games(count),
+    base_seed(seed),
+    next_seed(seed) {
+    reset();
+}
+
+void EnvBatch::reset() {
+    next_seed = base_seed;
+    for (std::size_t g = 0; g < num_games; g++) {
+        reset_game(g, next_seed++);
+        advance(g);
+        rewards[g * 2] = 0;
+        rewards[g * 2 + 1] = 0;
+        dones[g] = 0;
+    }
+}
+
+void EnvBatch::step_batch(std::span<const ActionId> actions) {
+    if (actions.size() != num_games) {
+        throw std::invalid_argument("step_batch needs exactly one action per game");
+    }
+    // Check every action before touching any game, so a rejected batch leaves the pool as it was.
+    for (std::size_t g = 0; g < num_games; g++) {
+        if (!euchre::action::in_mask(actions[g], masks[g])) {
+            throw std::invalid_argument("Returned action_id did not match the action mask");
+        }
+    }
+
+    for (std::size_t g = 0; g < num_games; g++) {
+        rewards[g * 2] = 0;
+        rewards[g * 2 + 1] = 0;
+        dones[g] = 0;
+        apply(g, actions[g]);
+        advance(g);
+    }
+}
+
+Observation EnvBatch::observation(std::size_t game) const {
+    uint8_t player = current_player[game];
+    return {
+        .hand = hands[game * np + player],
+        .trump = trump[game],
+        .lead = lead_card[game],
+        .face_up_card = face_up_card[game],
+        .trick_cards = {trick_cards[game * np], trick_cards[game * np + 1],
+                        trick_cards[game * np + 2], trick_cards[game * np + 3]},
+        .phase = phase[game],
+        .maker_team = static_cast<uint8_t>(maker_player[game] % 2),
+        .player = player,
+        .dealer = dealer[game],
+        .num_played = num_played[game],
+        .maker_player = maker_player[game],
+        .going_alone = going_alone[game] != 0,
+        .tricks_won = {tricks_won[game * 2], tricks_won[game * 2 + 1]},
+        .played = played_by[game * np] | played_by[game * np + 1] | played_by[game * np + 2] | played_by[game * np + 3],
+        .played_by = {played_by[game * np], played_by[game * np + 1], played_by[game * np + 2], played_by[game * np + 3]},
+        .voids = {euchre::rules::void_cards(void_suits[game * np], trump[game]),
+                  euchre::rules::void_cards(void_suits[game * np + 1], trump[game]),
+                  euchre::rules::void_cards(void_suits[game * np + 2], trump[game]),
+                  euchre::rules::void_cards(void_suits[game * np + 3], trump[game])},
+    };
+}
+
+void EnvBatch::observations(std::span<Observation> out) const {
+    for (std::size_t g = 0; g < out.size() && g < num_games; g++) {
+        out[g] = observation(g);
+    }
+}
+
+void EnvBatch::reset_game(std::size_t game, uint32_t seed) {
+    game_seed[game] = seed;
+    eng[game].seed(seed);
+    hands_dealt[game] = 0;
+    scores[game * 2] = 0;
+    scores[game * 2 + 1] = 0;
+    dealer[game] = 0;
+    reset_hand(game);
+}
+
+void EnvBatch::reset_hand(std::size_t game) {
+    for (std::size_t p = 0; p < np; p++) {
+        hands[game * np + p] = Hand{};
+        trick_cards[game * np + p] = Card{};
+        played_by[game * np + p] = 0;
+        void_suits[game * np + p] = 0;
+    }
+    tricks_won[game * 2] = 0;
+    tricks_won[game * 2 + 1] = 0;
+    phase[game] = Phase::Deal;
+    deck[game] = euchre::constants::deck_reset;
+    face_up_card[game] = Card{};
+    trump[game] = Suit::None;
+    lead_card[game] = Card{};
+    maker_player[game] = 0;
+    going_alone[game] = 0;
+    lead_player[game] = 0;
+    num_played[game] = 0;
+    tricks_played[game] = 0;
+}
+
+void EnvBatch::deal(std::size_t game) {
+    // Same draw order as Env::deal so a slot reproduces the matching Env game.
+    eng[game].seek(hands_dealt[game]++);
+    Deal d = deal_cards(eng[game]);
+    for (std::size_t p = 0; p < np; p++) {
+        hands[game * np + p] = Hand{d.hands[p]};
+    }
+    deck[game] = d.kitty;
+    face_up_card[game] = d.face_up;
+    phase[game] = Phase::BidRound1;
+    current_player[game] = static_cast<uint8_t>((dealer[game] + 1) % np);
+}
+
+void EnvBatch::hand_over(std::size_t game) {
+    uint8_t maker_team = maker_player[game] % 2;
+    auto score = euchre::rules::score_hand(maker_team, tricks_won[game * 2 + maker_team], going_alone[game],
+                                           rules.lone_march_points);
+    scores[game * 2 + score.team] = static_cast<uint8_t>(scores[game * 2 + score.team] + score.points);
+    rewards[game * 2 + score.team] = static_cast<int8_t>(rewards[game * 2 + score.team] + score.points);
+
+    dealer[game] = static_cast<uint8_t>((dealer[game] + 1) % np);
+    reset_hand(game);
+
+    if (scores[game * 2] >= rules.target_score || scores[game * 2 + 1] >= rules.target_score) {
+        dones[game] = 1;
+        reset_game(game, next_seed++);
+    }
+}
+
+void EnvBatch::apply(std::size_t game, ActionId action) {
+    uint8_t player = current_player[game];
+    switch (phase[game]) {
+        case Phase::BidRound1:
+            if (action == euchre::action::OrderUp) {
+                trump[game] = face_up_card[game].get_suit();
+                maker_player[game] = player;
+                phase[game] = Phase::GoAloneDecision;
+            }
+            else if (player == dealer[game]) {
+                phase[game] = Phase::BidRound2;
+                current_player[game] = static_cast<uint8_t>((player + 1) % np);
+            }
+            else {
+                current_player[game] = static_cast<uint8_t>((player + 1) % np);
+            }
+            break;
+        case Phase::BidRound2:
+            if (action != euchre::action::Pass) {
+                trump[game] = Suit(action.v - euchre::action::CallTrumpBase.v);
+                maker_player[game] = player;
+                phase[game] = Phase::GoAloneDecision;
+            }
+            else if (player == dealer[game]) {
+                // Everyone passed. Redeal with the same dealer.
+                reset_hand(game);
+            }
+            else {
+                current_player[game] = static_cast<uint8_t>((player + 1) % np);
+            }
+            break;
+        case Phase::GoAloneDecision:
+            going_alone[game] = action == euchre::action::GoAloneYes;
+            phase[game] = Phase::DealerPickupDiscard;
+            current_player[game] = dealer[game];
+            hands[game * np + dealer[game]].give_card(face_up_card[game]);
+            break;
+        case Phase::DealerPickupDiscard:
+            hands[game * np + player].remove_card(Card{static_cast<uint8_t>(action.v - euchre::constants::num_cards)});
+            phase[game] = Phase::PlayTrick;
+            lead_player[game] = euchre::rules::next_player(dealer[game], going_alone[game], maker_player[game]);
+            current_player[game] = lead_player[game];
+            break;
+        case Phase::PlayTrick: {
+            Card c {static_cast<uint8_t>(action.v)};
+            hands[game * np + player].remove_card(c);
+            if (num_played[game] > 0) {
+                void_suits[game * np + player] |= euchre::rules::shown_void(c, lead_card[game], trump[game]);
+            }
+            played_by[game * np + player] |= 1u << c;
+            if (num_played[game] == 0) {
+                lead_card[game] = c;
+            }
+            trick_cards[game * np + player] = c;
+            num_played[game]++;
+
+            uint8_t next = euchre::rules::next_player(player, going_alone[game], maker_player[game]);
+            if (next != lead_player[game]) {
+                current_player[game] = next;
+                break;
+            }
+
+            std::array<Card, 4> trick = {trick_cards[game * np], trick_cards[game * np + 1],
+                                         trick_cards[game * np + 2], trick_cards[game * np + 3]};
+            uint8_t winner = euchre::rules::trick_winner(trick, trump[game], lead_card[game],
+                                                         going_alone[game], maker_player[game]);
+            tricks_won[game * 2 + winner % 2]++;
+            lead_player[game] = winner;
+            current_player[game] = winner;
+            tricks_played[game]++;
+            lead_card[game] = Card{};
+            num_played[game] = 0;
+            if (tricks_played[game] == 5) {
+                phase[game] = Phase::HandOver;
+            }
+            break;
+        }
+        default:
+            throw std::logic_error("Game is not at a decision point");
+    }
+}
+
+void EnvBatch::advance(std::size_t game) {
+    // Run the phases that need no decision until the game is parked at one.
+    for (;;) {
+        if (phase[game] == Phase::Deal) {
+            deal(game);
+        }
+        else if (phase[game] == Phase::HandOver) {
+            hand_over(game);
+        }
+        else {
+            break;
+        }
+    }
+    masks[game] = legal_mask(game);
+}
+
+ActionMask EnvBatch::legal_mask(std::size_t game) const {
+    uint8_t player = current_player[game];
+    const Hand& hand = hands[game * np + player];
+
+    switch (phase[game]) {
+        case Phase::BidRound1:
+            return euchre::action::make_mask(euchre::action::Pass, euchre::action::OrderUp);
+        case Phase::BidRound2: {
+            ActionMask mask = euchre::action::make_mask(
+                euchre::action::Pass,
+                euchre::action::call_trump(Suit::C),
+                euchre::action::call_trump(Suit::H),
+                euchre::action::call_trump(Suit::S),
+                euchre::action::call_trump(Suit::D)
+            ) & ~euchre::action::a2m(euchre::action::call_trump(face_up_card[game].get_suit()));
+            if (player == dealer[game] && stick_the_dealer) {
+                mask &= ~euchre::action::a2m(euchre::action::Pass);
+            }
+            return mask;
+        }
+        case Phase::GoAloneDecision:
+            return euchre::action::make_mask(euchre::action::GoAloneYes, euchre::action::GoAloneNo);
+        case Phase::DealerPickupDiscard:
+            return static_cast<ActionMask>(hand.value()) << euchre::constants::num_cards;
+        case Phase::PlayTrick:
+            if (num_played[game] == 0) {
+                return static_cast<ActionMask>(hand.value());
+            }
+            return static_cast<ActionMask>(hand.get_valid_hand(lead_card[game], trump[game]));
+        default:
+            return 0;
+    }
+}
@@ -0,0 +1,288 @@
+#include "EquityTable.hpp"
+#include "Deck.hpp"
+#include "Env.hpp"
+#include "GameSnapshot.hpp"
+#include "WorkerPool.hpp"
+#include "bots/HeuristicBot.hpp"
+#include <algorithm>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <stdexcept>
+
+namespace {
+
+constexpr std::array<char, 8> file_magic = {'E', 'U', 'C', 'H', 'R', 'E', 'E', 'Q'};
+constexpr uint32_t file_version = 1;
+
+struct FileHeader {
+    std::array<char, 8> magic;
+    uint32_t version;
+    uint32_t rollouts;
+    uint32_t seed;
+    uint32_t chunk_hands;
+    uint32_t num_keys;
+    uint32_t num_chunks;
+};
+
+// Header, one done byte per chunk padded to 8 bytes, then num_bids floats per key.
+constexpr std::size_t done_offset = sizeof(FileHeader);
+constexpr std::size_t values_offset = done_offset + (EquityTable::num_chunks + 7) / 8 * 8;
+constexpr std::size_t file_size = values_offset + std::size_t{EquityTable::num_keys} * sizeof(EquityTable::Values);
+
+// Keys are simulated with this suit as trump; any other would give the same values.
+constexpr Suit canonical_trump = Suit::H;
+
+// Redeals allowed per rollout to make the seats before the bidder pass; past that they are made to.
+constexpr int max_redeals = 64;
+
+bool matches_layout(const FileHeader& h) {
+    return h.magic == file_magic && h.version == file_version && h.chunk_hands == EquityTable::chunk_hands &&
+           h.num_keys == EquityTable::num_keys && h.num_chunks == EquityTable::num_chunks;
+}
+
+/**
+ * @brief Plays out bidding positions with HeuristicBot in every seat.
+ */
+class Simulator {
+    public:
+
+    Simulator() : policy("equity rollout"), env(0, {&policy, &policy, &policy, &policy}) {}
+    Simulator(const Simulator&) = delete;
+    Simulator& operator=(const Simulator&) = delete;
+
+    EquityTable::Values estimate(uint32_t key, const EquityConfig& config) {
+        auto me = static_cast<uint8_t>(key % EquityTable::num_seats);
+        auto [hand, upcard] = HandIndexer::unrank_with_upcard(key / EquityTable::num_seats, canonical_trump);
+        bool first_round = upcard.get_suit() == canonical_trump;
+        Phase phase = first_round ? Phase::BidRound1 : Phase::BidRound2;
+        ActionId make = first_round ? euchre::action::OrderUp : euchre::action::call_trump(canonical_trump);
+        uint8_t team = me % 2;
+
+        euchre::rng::Philox4x32 eng(config.seed, key);
+        std::array<long, EquityTable::num_bids> totals {};
+        for (uint32_t r = 0; r < config.rollouts; r++) {
+            eng.seek(r);
+            GameSnapshot root = deal_to_decision(hand, upcard, me, phase, eng);
+            for (std::size_t bid = 0; bid < EquityTable::num_bids; bid++) {
+                env.restore(root);
+                if (bid == EquityTable::Pass) {
+                    env.apply(euchre::action::Pass);
+                }
+                else {
+                    env.apply(make);
+                    env.apply(bid == EquityTable::Alone ? euchre::action::GoAloneYes : euchre::action::GoAloneNo);
+                }
+                play_out(root.hands_dealt);
+                totals[bid] += env.state.scores[team] - env.state.scores[team ^ 1];
+            }
+        }
+
+        EquityTable::Values values {};
+        for (std::size_t bid = 0; bid < EquityTable::num_bids; bid++) {
+            values[bid] = static_cast<float>(static_cast<double>(totals[bid]) / config.rollouts);
+        }
+        return values;
+    }
+
+    private:
+
+    /**
+     * @brief Deal the other hands and run the bidding up to the bidder's turn in phase.
+     *
+     * Deals on which an earlier seat would not have passed are redrawn, so the sample matches
+     * what the bidder knows. The bidder itself passes the first round on the way to the second.
+     */
+    GameSnapshot deal_to_decision(Hand hand, Card upcard, uint8_t me, Phase phase, euchre::rng::Philox4x32& eng) {
+        for (int attempt = 0;; attempt++) {
+            GameState& gs = env.state;
+            HandState& hs = gs.hand_state;
+            hs.reset();
+            uint32_t remaining = euchre::constants::deck_reset & ~hand.value() & ~(1u << upcard);
+            for (uint8_t p = 0; p < euchre::constants::num_players; p++) {
+                uint32_t h = 0;
+                if (p != me) {
+                    for (int i = 0; i < 5; i++) {
+                        h |= 1u << draw_card(remaining, eng);
+                    }
+                }
+                hs.hands[p] = p == me ? hand : Hand{h};
+            }
+            hs.deck = remaining;
+            hs.face_up_card = upcard;
+            hs.phase = Phase::BidRound1;
+            hs.current_player = 1;
+            gs.dealer = 0;
+            gs.scores[0] = gs.scores[1] = 0;
+            gs.status = GameState::GameStatus::InProgress;
+            gs.hands_dealt = 0;
+
+            bool rejected = false;
+            for (auto decision = env.next_decision(); decision; decision = env.next_decision()) {
+                if (decision->player == me && decision->obs.phase == phase) {
+                    return env.snapshot();
+                }
+                bool must_pass = decision->player == me || attempt >= max_redeals;
+                if (!must_pass && policy.select_action(decision->obs, decision->mask) != euchre::action::Pass) {
+                    rejected = true;
+                    break;
+                }
+                env.apply(euchre::action::Pass);
+            }
+            if (!rejected) {
+                throw std::logic_error("Bidding ended before the bidder's turn");
+            }
+        }
+    }
+
+    void play_out(uint32_t hand) {
+        while (env.state.hands_dealt == hand) {
+            auto decision = env.next_decision();
+            if (!decision) {
+                break;
+            }
+            env.apply(policy.select_action(decision->obs, decision->mask));
+        }
+    }
+
+    HeuristicBot policy;
+    Env env;
+};
+
+}
+
+EquityTable::EquityTable(const std::string& path) : file(path) {
+    FileHeader h {};
+    if (file.size() >= sizeof(FileHeader)) {
+        std::memcpy(&h, file.data(), sizeof(FileHeader));
+    }
+    if (file.size() != file_size || !matches_layout(h)) {
+        throw std::runtime_error("Not an equity table: " + path);
+    }
+    num_rollouts = h.rollouts;
+    done = file.data() + done_offset;
+    values = file.data() + values_offset;
+}
+
+std::optional<EquityTable::Values> EquityTable::lookup(uint32_t key) const {
+    if (key >= num_keys || done[key / chunk_keys] == 0) {
+        return std::nullopt;
+    }
+    Values v;
+    std::memcpy(v.data(), values + std::size_t{key} * sizeof(Values), sizeof(Values));
+    return v;
+}
+
+std::size_t EquityTable::chunks_done() const {
+    return static_cast<std::size_t>(std::count_if(done, done + num_chunks, [](uint8_t d) { return d != 0; }));
+}
+
+std::size_t EquityTable::generate(const std::string& path, const EquityConfig& config, WorkerPool* pool) {
+    if (config.rollouts == 0 || config.num_shards == 0 || config.shard >= config.num_shards) {
+        throw std::invalid_argument("Equity tables need at least one rollout and a shard below num_shards");
+    }
+
+    if (!std::filesystem::exists(path)) {
+        FileHeader h {file_magic, file_version, config.rollouts, config.seed, chunk_hands, num_keys, num_chunks};
+        std::ofstream out(path, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(&h), sizeof(h));
+        out.close();
+        if (!out) {
+            throw std::runtime_error("Cannot write equity table " + path);
+        }
+        // Zero filled: no chunk is done yet.
+        std::filesystem::resize_file(path, file_size);
+    }
+
+    std::fstream io(path, std::ios::binary | std::ios::in | std::ios::out);
+    FileHeader h {};
+    io.read(reinterpret_cast<char*>(&h), sizeof(h));
+    if (!io || std::filesystem::file_size(path) != file_size || !matches_layout(h)) {
+        throw std::runtime_error("Not an equity table: " + path);
+    }
+    if (h.rollouts != config.rollouts || h.seed != config.seed) {
+        throw std::invalid_argument("Equity table " + path + " was generated with other rollouts or seed");
+    }
+    std::vector<uint8_t> flags(num_chunks);
+    io.read(reinterpret_cast<char*>(flags.data()), static_cast<std::streamsize>(flags.size()));
+
+    std::size_t threads = pool ? pool->size() : 1;
+    std::vector<std::unique_ptr<Simulator>> simulators;
+    for (std::size_t w = 0; w < threads; w++) {
+        simulators.push_back(std::make_unique<Simulator>());
+    }
+
+    std::vector<Values> chunk(chunk_keys);
+    std::size_t computed = 0;
+    for (uint32_t c = config.shard; c < num_chunks; c += config.num_shards) {
+        if (flags[c]) {
+            continue;
+        }
+        uint32_t first = c * chunk_keys;
+        uint32_t count = std::min(chunk_keys, num_keys - first);
+        auto simulate = [&](std::size_t worker, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                chunk[i] = simulators[worker]->estimate(first + static_cast<uint32_t>(i), config);
+            }
+        };
+        if (pool) {
+            pool->parallel_for(count, 8, simulate);
+        }
+        else {
+            simulate(0, 0, count);
+        }
+
+        // Values first, so a flag is never set over a partly written chunk.
+        io.seekp(static_cast<std::streamoff>(values_offset + std::size_t{first} * sizeof(Values)));
+        io.write(reinterpret_cast<const char*>(chunk.data()), static_cast<std::streamsize>(count * sizeof(Values)));
+        io.flush();
+        const char flag = 1;
+        io.seekp(static_cast<std::streamoff>(done_offset + c));
+        io.write(&flag, 1);
+        io.flush();
+        if (!io) {
+            throw std::runtime_error("Cannot write equity table " + path);
+        }
+        computed++;
+    }
+    return computed;
+}
+
+void EquityTable::merge(const std::vector<std::string>& inputs, const std::string& path) {
+    if (inputs.empty()) {
+        throw std::invalid_argument("No equity tables to merge");
+    }
+
+    std::vector<uint8_t> merged;
+    {
+        std::vector<EquityTable> tables;
+        tables.reserve(inputs.size());
+        for (const auto& input : inputs) {
+            tables.emplace_back(input);
+        }
+        const uint8_t* first = tables[0].file.data();
+        merged.assign(first, first + file_size);
+        for (std::size_t t = 1; t < tables.size(); t++) {
+            if (std::memcmp(tables[t].file.data(), first, sizeof(FileHeader)) != 0) {
+                throw std::invalid_argument("Equity table " + inputs[t] + " was generated with other rollouts or seed");
+            }
+            for (uint32_t c = 0; c < num_chunks; c++) {
+                if (merged[done_offset + c] || !tables[t].done[c]) {
+                    continue;
+                }
+                std::size_t begin = std::size_t{c} * chunk_keys * sizeof(Values);
+                std::size_t end = std::min(begin + chunk_keys * sizeof(Values), file_size - values_offset);
+                std::memcpy(merged.data() + values_offset + begin, tables[t].values + begin, end - begin);
+                merged[done_offset + c] = 1;
+            }
+        }
+    }
+
+    // The inputs are unmapped by now, so path may be one of them.
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(merged.data()), static_cast<std::streamsize>(merged.size()));
+    if (!out) {
+        throw std::runtime_error("Cannot write equity table " + path);
+    }
+}
@@ -0,0 +1,80 @@
+#include "MappedFile.hpp"
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+#include <utility>
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define EUCHRE_MMAP 1
+#endif
+
+MappedFile::MappedFile(const std::string& path) {
+#if defined(EUCHRE_MMAP)
+    int fd = ::open(path.c_str(), O_RDONLY);
+    if (fd < 0) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    struct stat st {};
+    if (::fstat(fd, &st) != 0) {
+        ::close(fd);
+        throw std::runtime_error("Cannot open " + path);
+    }
+    length = static_cast<std::size_t>(st.st_size);
+    if (length == 0) {
+        // mmap refuses empty files; an empty view is what the caller sees either way.
+        ::close(fd);
+        return;
+    }
+    mapping = ::mmap(nullptr, length, PROT_READ, MAP_PRIVATE, fd, 0);
+    ::close(fd);
+    if (mapping == MAP_FAILED) {
+        mapping = nullptr;
+        length = 0;
+        throw std::runtime_error("Cannot map " + path);
+    }
+    bytes = static_cast<const uint8_t*>(mapping);
+#else
+    std::ifstream in(path, std::ios::binary);
+    if (!in) {
+        throw std::runtime_error("Cannot open " + path);
+    }
+    buffer.assign(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+    bytes = buffer.data();
+    length = buffer.size();
+#endif
+}
+
+MappedFile::MappedFile(MappedFile&& other) noexcept
+    : bytes(std::exchange(other.bytes, nullptr)), length(std::exchange(other.length, 0)),
+      mapping(std::exchange(other.mapping, nullptr)), buffer(std::move(other.buffer)) {}
+
+MappedFile& MappedFile::operator=(MappedFile&& other) noexcept {
+    if (this != &other) {
+        release();
+        bytes = std::exchange(other.bytes, nullptr);
+        length = std::exchange(other.length, 0);
+        mapping = std::exchange(other.mapping, nullptr);
+        buffer = std::move(other.buffer);
+    }
+    return *this;
+}
+
+MappedFile::~MappedFile() {
+    release();
+}
+
+void MappedFile::release() {
+#if defined(EUCHRE_MMAP)
+    if (mapping) {
+        ::munmap(mapping, length);
+    }
+#endif
+    mapping = nullptr;
+    buffer.clear();
+    bytes = nullptr;
+    length = 0;
+}
@@ -0,0 +1,662 @@
+#include "SlicedPlayout.hpp"
+#include "Deck.hpp"
+#include "Rng.hpp"
+#include "Rules.hpp"
+#include "TrickKernels.hpp"
+#include "bots/BotUtils.hpp"
+#include <algorithm>
+#include <bit>
+#include <chrono>
+
+namespace {
+
+using euchre::constants::num_cards;
+using euchre::constants::num_players;
+
+// Bit l of a word belongs to the game in lane l.
+using Word = uint64_t;
+constexpr std::size_t num_lanes = 64;
+// [card]: the lanes where the card is in some set.
+using CardWords = std::array<Word, num_cards>;
+// [seat] or [suit]: one-hot per lane.
+using SeatWords = std::array<Word, num_players>;
+
+// Philox stream ids (the key's second half) for the Random policy's draws; deals use stream 0 like Env.
+constexpr uint32_t bid_stream = 1;
+constexpr uint32_t play_stream = 2;
+
+// The sliced engine plays the standard rules only.
+constexpr euchre::rules::RuleSet rules {};
+
+// Hands play five tricks, then score: six steps after bidding in Env::step_game terms.
+constexpr int play_steps = 6;
+
+constexpr std::size_t card_of(std::size_t suit, std::size_t rank) {
+    return suit * 6 + rank;
+}
+
+// C <-> S, H <-> D.
+constexpr std::size_t same_color(std::size_t suit) {
+    return suit ^ 2u;
+}
+
+/**
+ * @brief The lanes where card c's effective suit is one of `suits` under `trump`.
+ *
+ * Only a jack can change suit: it belongs to the trump suit where its same color suit is trump.
+ */
+inline Word in_suits(std::size_t c, const SeatWords& suits, const SeatWords& trump) {
+    std::size_t s = c / 6;
+    if (c % 6 != Rank::RJ) {
+        return suits[s];
+    }
+    std::size_t other = same_color(s);
+    return (suits[s] & ~trump[other]) | (suits[other] & trump[other]);
+}
+
+/**
+ * @brief Per lane, the lowest (or highest) power card of `cards`, ties to the lowest card index.
+ *
+ * Walks the power levels from weakest to strongest (or back) and takes the first card found in each
+ * lane. Off suit cards rank by face value alone, so an off level holds one rank of every suit; led
+ * suit and trump levels hold at most one card per lane. Within a level cards go by index, which is
+ * the power table's tie break (lowest_card and highest_card both keep the lowest index).
+ *
+ * @param is_trump [card]: lanes where the card is trump.
+ * @param is_led [card]: lanes where the card is of the led suit. Pass is_trump when leading, as the
+ *        bots order a lead by trump alone.
+ */
+template <bool Highest>
+void pick_extreme(const CardWords& cards, const SeatWords& trump, const CardWords& is_trump,
+                  const CardWords& is_led, CardWords& chosen) {
+    // Only `found` carries from level to level; everything else in a level is independent of it.
+    Word found = 0;
+    auto level = [&](std::size_t rank, auto allowed) {
+        Word within = 0;
+        for (std::size_t s = 0; s < 4; s++) {
+            std::size_t c = card_of(s, rank);
+            Word x = cards[c] & allowed(s, c);
+            chosen[c] |= x & ~(found | within);
+            within |= x;
+        }
+        found |= within;
+    };
+    auto off = [&](std::size_t, std::size_t c) { return ~(is_trump[c] | is_led[c]); };
+    auto led = [&](std::size_t, std::size_t c) { return is_led[c] & ~is_trump[c]; };
+    auto own_trump = [&](std::size_t s, std::size_t) { return trump[s]; };
+    auto left_bower = [&](std::size_t s, std::size_t) { return trump[same_color(s)]; };
+    constexpr std::array<std::size_t, 5> trump_ranks {Rank::R9, Rank::RT, Rank::RQ, Rank::RK, Rank::RA};
+
+    if constexpr (Highest) {
+        level(Rank::RJ, own_trump);
+        level(Rank::RJ, left_bower);
+        for (std::size_t i = trump_ranks.size(); i-- > 0;) {
+            level(trump_ranks[i], own_trump);
+        }
+        for (std::size_t r = Rank::RA + 1; r-- > 0;) {
+            level(r, led);
+        }
+        for (std::size_t r = Rank::RA + 1; r-- > 0;) {
+            level(r, off);
+        }
+    }
+    else {
+        for (std::size_t r = 0; r <= Rank::RA; r++) {
+            level(r, off);
+        }
+        for (std::size_t r = 0; r <= Rank::RA; r++) {
+            level(r, led);
+        }
+        for (std::size_t r : trump_ranks) {
+            level(r, own_trump);
+        }
+        level(Rank::RJ, left_bower);
+        level(Rank::RJ, own_trump);
+    }
+}
+
+/**
+ * @brief Add a one bit word to a bit-sliced counter, dropping the carry out of the top bit.
+ */
+template <std::size_t N>
+inline void increment(std::array<Word, N>& counter, Word x) {
+    for (std::size_t b = 0; b < N && x; b++) {
+        Word carry = counter[b] & x;
+        counter[b] ^= x;
+        x = carry;
+    }
+}
+
+using LaneWords = std::array<uint32_t, num_lanes>;
+
+/**
+ * @brief Random words for the Random policy's card choices, 64 Philox blocks at a time.
+ */
+class RandomWords {
+    public:
+
+    explicit RandomWords(uint32_t seed) {
+        key0.fill(seed);
+    }
+
+    Word next() {
+        if (pos == words.size()) {
+            refill();
+        }
+        return words[pos++];
+    }
+
+    private:
+
+    void refill() {
+        LaneWords ctr0, ctr1 {};
+        for (uint32_t i = 0; i < num_lanes; i++) {
+            ctr0[i] = blocks + i;
+        }
+        blocks += num_lanes;
+        std::array<LaneWords, 4> out;
+        euchre::kernels::philox_blocks(ctr0, ctr1, key0, play_stream, {out[0], out[1], out[2], out[3]});
+        for (std::size_t i = 0; i < num_lanes; i++) {
+            words[2 * i] = out[0][i] | Word{out[1][i]} << 32;
+            words[2 * i + 1] = out[2][i] | Word{out[3][i]} << 32;
+        }
+        pos = 0;
+    }
+
+    LaneWords key0;
+    uint32_t blocks = 0;
+    std::array<Word, 2 * num_lanes> words {};
+    std::size_t pos = 2 * num_lanes;
+};
+
+/**
+ * @brief Per lane, a uniformly random card of `cards` (at most seven per lane).
+ *
+ * Draws an index in [0, n) for every lane at once with Lemire's multiply-shift on 8 random bits,
+ * redrawing the rare lanes that land in the biased low range, then takes that card in index order.
+ */
+void pick_random(const CardWords& cards, RandomWords& rng, CardWords& chosen) {
+    std::array<Word, 3> n {};
+    for (Word c : cards) {
+        increment(n, c);
+    }
+
+    // 256 % n is 1 for n = 3 and 5 and 4 for n = 6 and 7; other sizes divide 256.
+    Word odd = n[0] & (n[1] ^ n[2]);
+    Word six_up = n[1] & n[2];
+
+    std::array<Word, 3> index {};
+    Word pending = n[0] | n[1] | n[2];
+    while (pending) {
+        std::array<Word, 8> u;
+        for (Word& w : u) {
+            w = rng.next();
+        }
+        // m = u * n, 11 bits; the top three are the index.
+        std::array<Word, 11> m {};
+        for (std::size_t j = 0; j < 3; j++) {
+            Word carry = 0;
+            for (std::size_t k = j; k < m.size(); k++) {
+                Word x = k - j < u.size() ? u[k - j] & n[j] : 0;
+                Word sum = m[k] ^ x ^ carry;
+                carry = (m[k] & x) | (carry & (m[k] ^ x));
+                m[k] = sum;
+            }
+        }
+        Word low_zero = ~(m[2] | m[3] | m[4] | m[5] | m[6] | m[7]);
+        Word reject = (odd & low_zero & ~(m[0] | m[1])) | (six_up & low_zero);
+        Word accept = pending & ~reject;
+        for (std::size_t b = 0; b < 3; b++) {
+            index[b] |= m[8 + b] & accept;
+        }
+        pending &= reject;
+    }
+
+    std::array<Word, 3> seen {};
+    for (std::size_t c = 0; c < num_cards; c++) {
+        Word at_index = ~((seen[0] ^ index[0]) | (seen[1] ^ index[1]) | (seen[2] ^ index[2]));
+        chosen[c] |= cards[c] & at_index;
+        increment(seen, cards[c]);
+    }
+}
+
+/**
+ * @brief Which lanes each policy acts for when `actor` (one-hot per lane) is to play.
+ */
+struct PolicyLanes {
+    Word random = 0;
+    Word min = 0;
+    Word max = 0;
+};
+
+PolicyLanes policy_lanes(const SlicedLineup& lineup, const SeatWords& actor) {
+    PolicyLanes lanes;
+    for (std::size_t p = 0; p < num_players; p++) {
+        switch (lineup[p]) {
+            case SlicedPolicy::Random:
+                lanes.random |= actor[p];
+                break;
+            case SlicedPolicy::Min:
+                lanes.min |= actor[p];
+                break;
+            case SlicedPolicy::Max:
+                lanes.max |= actor[p];
+                break;
+        }
+    }
+    return lanes;
+}
+
+/**
+ * @brief One hand in each lane, from the opening lead to the last trick.
+ *
+ * A lone maker's partner holds no cards, so it "plays" nothing and never wins a trick; lanes with
+ * no hand in play are all zero and stay that way.
+ */
+struct SlicedHand {
+    std::array<CardWords, num_players> hands {};
+    SeatWords trump {};
+    SeatWords leader {};
+    // Lanes whose makers are team 1 (seats 1 and 3).
+    Word maker_team_1 = 0;
+    std::array<Word, 3> maker_tricks {};
+};
+
+void play_trick(SlicedHand& h, const SlicedLineup& lineup, const CardWords& is_trump, RandomWords& rng) {
+    const std::array<CardWords, num_players> before = h.hands;
+    SeatWords actor = h.leader;
+    SeatWords led {};
+    CardWords is_led = is_trump;
+    CardWords trick {};
+
+    for (std::size_t pos = 0; pos < num_players; pos++) {
+        CardWords legal;
+        Word follows = 0;
+        for (std::size_t c = 0; c < num_cards; c++) {
+            legal[c] = (actor[0] & h.hands[0][c]) | (actor[1] & h.hands[1][c]) | (actor[2] & h.hands[2][c]) |
+                       (actor[3] & h.hands[3][c]);
+            follows |= legal[c] & is_led[c];
+        }
+        if (pos > 0) {
+            // Must follow the led suit where the hand has it.
+            for (std::size_t c = 0; c < num_cards; c++) {
+                legal[c] &= is_led[c] | ~follows;
+            }
+        }
+
+        PolicyLanes lanes = policy_lanes(lineup, actor);
+        CardWords chosen {};
+        if (lanes.min) {
+            CardWords pick {};
+            pick_extreme<false>(legal, h.trump, is_trump, is_led, pick);
+            for (std::size_t c = 0; c < num_cards; c++) {
+                chosen[c] |= pick[c] & lanes.min;
+            }
+        }
+        if (lanes.max) {
+            CardWords pick {};
+            pick_extreme<true>(legal, h.trump, is_trump, is_led, pick);
+            for (std::size_t c = 0; c < num_cards; c++) {
+                chosen[c] |= pick[c] & lanes.max;
+            }
+        }
+        if (lanes.random) {
+            CardWords mine;
+            for (std::size_t c = 0; c < num_cards; c++) {
+                mine[c] = legal[c] & lanes.random;
+            }
+            pick_random(mine, rng, chosen);
+        }
+
+        for (std::size_t c = 0; c < num_cards; c++) {
+            trick[c] |= chosen[c];
+            for (auto& hand : h.hands) {
+                hand[c] &= ~chosen[c];
+            }
+        }
+        if (pos == 0) {
+            // The effective suit of the lead.
+            for (std::size_t c = 0; c < num_cards; c++) {
+                std::size_t s = c / 6;
+                if (c % 6 != Rank::RJ) {
+                    led[s] |= chosen[c];
+                }
+                else {
+                    std::size_t other = same_color(s);
+                    led[s] |= chosen[c] & ~h.trump[other];
+                    led[other] |= chosen[c] & h.trump[other];
+                }
+            }
+            for (std::size_t c = 0; c < num_cards; c++) {
+                is_led[c] = in_suits(c, led, h.trump);
+            }
+        }
+        actor = {actor[3], actor[0], actor[1], actor[2]};
+    }
+
+    CardWords best {};
+    pick_extreme<true>(trick, h.trump, is_trump, is_led, best);
+    SeatWords winner {};
+    for (std::size_t c = 0; c < num_cards; c++) {
+        for (std::size_t p = 0; p < num_players; p++) {
+            winner[p] |= best[c] & before[p][c];
+        }
+    }
+    Word team_1 = winner[1] | winner[3];
+    Word team_0 = winner[0] | winner[2];
+    increment(h.maker_tricks, (team_1 & h.maker_team_1) | (team_0 & ~h.maker_team_1));
+    h.leader = winner;
+}
+
+/**
+ * @brief A game in flight in one lane, between hands.
+ */
+struct Lane {
+    int game = -1;
+    euchre::rng::Philox4x32 bid_rng;
+    uint32_t hands_dealt = 0;
+    uint8_t dealer = 0;
+    std::array<uint8_t, 2> scores {};
+    int steps = 0;
+};
+
+/**
+ * @brief The outcome of bidding: the hands after the dealer's discard and who made what.
+ */
+struct Contract {
+    std::array<uint32_t, num_players> hands {};
+    Suit trump = Suit::None;
+    uint8_t maker = 0;
+    bool alone = false;
+};
+
+void start_game(Lane& lane, int game) {
+    lane = Lane{};
+    lane.game = game;
+    lane.bid_rng.seed(static_cast<uint32_t>(game), bid_stream);
+}
+
+// Philox blocks behind the 21 draws of one deal.
+constexpr uint32_t deal_blocks = 6;
+
+/**
+ * @brief Env's next deal for every lane in `deal_mask` (bit l for lane l).
+ *
+ * deal_cards() spends most of its time in Philox, one block at a time. Here the blocks of every
+ * lane are computed together by the batched Philox kernel, and only the unranking runs per lane.
+ * The deals are the ones Env{game} deals for the same hand: a lane whose draw would need
+ * bounded()'s rejection branch falls back to deal_cards().
+ */
+void deal_lanes(std::array<Lane, num_lanes>& lanes, Word deal_mask, std::array<Deal, num_lanes>& deals) {
+    constexpr std::size_t max_blocks = num_lanes * deal_blocks;
+    std::array<uint32_t, max_blocks> ctr0, ctr1, key0;
+    std::array<std::array<uint32_t, max_blocks>, 4> out;
+    std::size_t n = 0;
+    for (Word rest = deal_mask; rest; rest &= rest - 1) {
+        const Lane& lane = lanes[static_cast<std::size_t>(std::countr_zero(rest))];
+        for (uint32_t block = 0; block < deal_blocks; block++, n++) {
+            ctr0[n] = block;
+            ctr1[n] = lane.hands_dealt;
+            key0[n] = static_cast<uint32_t>(lane.game);
+        }
+    }
+    euchre::kernels::philox_blocks(std::span(ctr0).first(n), std::span(ctr1).first(n), std::span(key0).first(n), 0,
+                                   {std::span(out[0]).first(n), std::span(out[1]).first(n),
+                                    std::span(out[2]).first(n), std::span(out[3]).first(n)});
+
+    std::size_t first_block = 0;
+    for (Word rest = deal_mask; rest; rest &= rest - 1, first_block += deal_blocks) {
+        auto l = static_cast<std::size_t>(std::countr_zero(rest));
+        Lane& lane = lanes[l];
+        DealRanks ranks;
+        bool exact = true;
+        for (uint32_t i = 0; i < ranks.size(); i++) {
+            uint32_t range = num_cards - i;
+            uint64_t m = uint64_t{out[i % 4][first_block + i / 4]} * range;
+            // bounded() might redraw; let it.
+            exact &= static_cast<uint32_t>(m) >= range;
+            ranks[i] = static_cast<uint8_t>(m >> 32);
+        }
+        if (exact) {
+            deals[l] = unrank_deal(ranks);
+        }
+        else {
+            euchre::rng::Philox4x32 rng(static_cast<uint32_t>(lane.game));
+            rng.seek(lane.hands_dealt);
+            deals[l] = deal_cards(rng);
+        }
+        lane.hands_dealt++;
+    }
+}
+
+enum class Bidding : uint8_t {
+    Made,
+    Redeal,
+};
+
+/**
+ * @brief Bid a dealt hand the way Env does, counting Env::step_game steps.
+ *
+ * @return Redeal if everyone passed twice.
+ */
+Bidding bid(Lane& lane, const SlicedLineup& lineup, const Deal& d, Contract& contract) {
+    contract.hands = d.hands;
+    Suit up_suit = d.face_up.get_suit();
+    lane.steps++;
+
+    // Round 1: order up the face up card.
+    bool made = false;
+    for (uint8_t i = 1; i <= num_players && !made; i++) {
+        auto p = static_cast<uint8_t>((lane.dealer + i) % num_players);
+        if (lineup[p] == SlicedPolicy::Random && euchre::rng::bounded(lane.bid_rng, 2) == 1) {
+            made = true;
+            contract.trump = up_suit;
+            contract.maker = p;
+        }
+    }
+    lane.steps++;
+
+    // Round 2: name another suit. Min and Max call the first one they may.
+    if (!made) {
+        for (uint8_t i = 1; i <= num_players && !made; i++) {
+            auto p = static_cast<uint8_t>((lane.dealer + i) % num_players);
+            uint32_t pick = lineup[p] == SlicedPolicy::Random ? euchre::rng::bounded(lane.bid_rng, 4) : 1;
+            if (pick > 0) {
+                uint8_t suit = 0;
+                for (uint32_t legal = 0;; suit++) {
+                    if (suit != up_suit && ++legal == pick) {
+                        break;
+                    }
+                }
+                made = true;
+                contract.trump = Suit(suit);
+                contract.maker = p;
+            }
+        }
+        lane.steps++;
+        if (!made) {
+            return Bidding::Redeal;
+        }
+    }
+
+    contract.alone = lineup[contract.maker] == SlicedPolicy::Random && euchre::rng::bounded(lane.bid_rng, 2) == 1;
+    lane.steps++;
+
+    // The dealer takes the face up card and discards, whichever round trump was made in.
+    uint32_t& dealer_hand = contract.hands[lane.dealer];
+    dealer_hand |= 1u << d.face_up;
+    Card discard = lineup[lane.dealer] == SlicedPolicy::Random
+                       ? Card{pick_random_bit(dealer_hand, lane.bid_rng)}
+                       : bot_utils::lowest_card(dealer_hand, contract.trump, contract.trump);
+    dealer_hand &= ~(1u << discard);
+    lane.steps++;
+    return Bidding::Made;
+}
+
+}
+
+void play_sliced_games(const SlicedLineup& lineup, int first, int last, int max_steps, BenchResult& result) {
+    RandomWords play_rng(static_cast<uint32_t>(first));
+    std::array<Lane, num_lanes> lanes;
+    std::array<Contract, num_lanes> contracts;
+    int next_game = first;
+
+    for (Lane& lane : lanes) {
+        if (next_game < last) {
+            start_game(lane, next_game++);
+        }
+    }
+
+    for (;;) {
+        // Deal and bid every lane's next hand. Redeals go round again; a game that can no longer
+        // finish within max_steps stalls and its lane takes the next game.
+        std::array<Deal, num_lanes> deals;
+        Word active = 0;
+        for (std::size_t l = 0; l < num_lanes; l++) {
+            active |= lanes[l].game >= 0 ? Word{1} << l : 0;
+        }
+        Word pending = active;
+        while (pending) {
+            for (Word rest = pending; rest; rest &= rest - 1) {
+                auto l = static_cast<std::size_t>(std::countr_zero(rest));
+                while (lanes[l].game >= 0 && lanes[l].steps >= max_steps) {
+                    result.stalled++;
+                    lanes[l].game = -1;
+                    if (next_game < last) {
+                        start_game(lanes[l], next_game++);
+                    }
+                }
+                if (lanes[l].game < 0) {
+                    pending &= ~(Word{1} << l);
+                    active &= ~(Word{1} << l);
+                }
+            }
+            deal_lanes(lanes, pending, deals);
+            for (Word rest = pending; rest; rest &= rest - 1) {
+                auto l = static_cast<std::size_t>(std::countr_zero(rest));
+                Lane& lane = lanes[l];
+                if (bid(lane, lineup, deals[l], contracts[l]) == Bidding::Redeal) {
+                    continue;
+                }
+                pending &= ~(Word{1} << l);
+                if (lane.steps + play_steps > max_steps) {
+                    // Bidding done, but the hand cannot be scored in time.
+                    result.stalled++;
+                    lane.game = -1;
+                    active &= ~(Word{1} << l);
+                    if (next_game < last) {
+                        start_game(lane, next_game++);
+                        pending |= Word{1} << l;
+                        active |= Word{1} << l;
+                    }
+                }
+            }
+        }
+        if (!active) {
+            break;
+        }
+
+        // Transpose the contracts into lanes.
+        SlicedHand h;
+        for (std::size_t l = 0; l < num_lanes; l++) {
+            const Lane& lane = lanes[l];
+            if (lane.game < 0) {
+                continue;
+            }
+            const Contract& contract = contracts[l];
+            Word bit = Word{1} << l;
+            uint8_t out = contract.alone ? euchre::rules::sitting_out_player(contract.maker) : num_players;
+            for (uint8_t p = 0; p < num_players; p++) {
+                if (p == out) {
+                    continue;
+                }
+                for (uint32_t cards = contract.hands[p]; cards; cards &= cards - 1) {
+                    h.hands[p][static_cast<std::size_t>(std::countr_zero(cards))] |= bit;
+                }
+            }
+            h.trump[contract.trump] |= bit;
+            h.leader[euchre::rules::next_player(lane.dealer, contract.alone, contract.maker)] |= bit;
+            h.maker_team_1 |= contract.maker % 2 ? bit : 0;
+        }
+
+        CardWords is_trump;
+        for (std::size_t c = 0; c < num_cards; c++) {
+            is_trump[c] = in_suits(c, h.trump, h.trump);
+        }
+        for (int trick = 0; trick < 5; trick++) {
+            play_trick(h, lineup, is_trump, play_rng);
+        }
+
+        // Score, and move finished games out of their lanes.
+        for (std::size_t l = 0; l < num_lanes; l++) {
+            Lane& lane = lanes[l];
+            if (lane.game < 0) {
+                continue;
+            }
+            const Contract& contract = contracts[l];
+            auto tricks = static_cast<uint8_t>((h.maker_tricks[0] >> l & 1) | (h.maker_tricks[1] >> l & 1) << 1 |
+                                               (h.maker_tricks[2] >> l & 1) << 2);
+            auto score = euchre::rules::score_hand(contract.maker % 2, tricks, contract.alone, rules.lone_march_points);
+            lane.scores[score.team] = static_cast<uint8_t>(lane.scores[score.team] + score.points);
+            lane.dealer = static_cast<uint8_t>((lane.dealer + 1) % num_players);
+            lane.steps += play_steps;
+
+            if (lane.scores[0] >= rules.target_score || lane.scores[1] >= rules.target_score) {
+                if (lane.scores[0] >= rules.target_score) {
+                    result.team0_wins++;
+                }
+                else {
+                    result.team1_wins++;
+                }
+                lane.game = -1;
+                if (next_game < last) {
+                    start_game(lane, next_game++);
+                }
+            }
+        }
+    }
+}
+
+BenchResult run_sliced_benchmark(const SlicedLineup& lineup, int num_games, int max_steps) {
+    BenchResult result{};
+    auto start = std::chrono::high_resolution_clock::now();
+    for (int first = 0; first < num_games; first += sliced_block_games) {
+        play_sliced_games(lineup, first, std::min(first + sliced_block_games, num_games), max_steps, result);
+    }
+    auto end = std::chrono::high_resolution_clock::now();
+    result.seconds = std::chrono::duration<double>(end - start).count();
+    return result;
+}
+
+ParallelBenchResult run_parallel_sliced_benchmark(WorkerPool& pool, const SlicedLineup& lineup, int num_games,
+                                                  int max_steps) {
+    std::vector<BenchResult> partial(pool.size(), BenchResult{});
+    std::vector<ThreadStats> stats(pool.size(), ThreadStats{});
+    auto num_blocks = static_cast<std::size_t>((num_games + sliced_block_games - 1) / sliced_block_games);
+
+    auto start = std::chrono::high_resolution_clock::now();
+    pool.parallel_for(num_blocks, 1, [&](std::size_t worker, std::size_t begin, std::size_t end) {
+        auto chunk_start = std::chrono::high_resolution_clock::now();
+        int games = 0;
+        for (std::size_t b = begin; b < end; b++) {
+            int first = static_cast<int>(b) * sliced_block_games;
+            int last = std::min(first + sliced_block_games, num_games);
+            play_sliced_games(lineup, first, last, max_steps, partial[worker]);
+            games += last - first;
+        }
+        auto chunk_end = std::chrono::high_resolution_clock::now();
+
+        stats[worker].games += games;
+        stats[worker].busy_seconds += std::chrono::duration<double>(chunk_end - chunk_start).count();
+    });
+    auto end = std::chrono::high_resolution_clock::now();
+
+    ParallelBenchResult result{BenchResult{}, std::move(stats)};
+    for (const auto& p : partial) {
+        result.total.team0_wins += p.team0_wins;
+        result.total.team1_wins += p.team1_wins;
+        result.total.stalled += p.stalled;
+    }
+    result.total.seconds = std::chrono::duration<double>(end - start).count();
+    return result;
+}
@@ -0,0 +1,335 @@
+#include "Tablebase.hpp"
+#include "DoubleDummy.hpp"
+#include "Rules.hpp"
+#include "Tables.hpp"
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace {
+
+constexpr std::array<char, 8> file_magic = {'E', 'U', 'C', 'H', 'R', 'E', 'T', 'B'};
+constexpr uint32_t file_version = 1;
+
+// In-play cards per suit are capped by the suit: 7 trumps, 6 in the other suits.
+constexpr std::size_t max_trumps = 7;
+constexpr std::size_t max_plain = 6;
+constexpr std::size_t max_in_play = 12;
+
+/**
+ * @brief Index arithmetic shared by the generator and probes.
+ *
+ * Section (k, z) holds the positions with k cards per hand; z is the sitting out seat relative to
+ * the leader, or 0 with four players. Within a section an entry is split * arrangements + rank,
+ * where split numbers the (trump, plain, plain, plain) suit lengths and rank numbers the owner
+ * sequence in lexicographic order.
+ */
+struct Layout {
+    // split_id[n][trumps][longest][middle], -1 if that is not a split of n cards.
+    std::array<std::array<std::array<std::array<int16_t, max_plain + 1>, max_plain + 1>, max_trumps + 1>,
+               max_in_play + 1> split_id {};
+    std::array<std::vector<std::array<uint8_t, 4>>, max_in_play + 1> splits;
+    std::array<std::array<uint64_t, 4>, Tablebase::max_supported_cards + 1> base {};
+    std::array<std::array<uint64_t, 4>, Tablebase::max_supported_cards + 1> arrangements {};
+    std::array<uint64_t, Tablebase::max_supported_cards + 1> entries {};
+    // Cards of each effective suit from highest to lowest, per trump.
+    std::array<std::array<std::array<Card, max_trumps>, 4>, 4> ranked {};
+    std::array<std::array<uint8_t, 4>, 4> ranked_size {};
+};
+
+uint8_t num_owners(uint8_t z) {
+    return z == 0 ? 4 : 3;
+}
+
+uint64_t factorial(uint64_t n) {
+    return n <= 1 ? 1 : n * factorial(n - 1);
+}
+
+const Layout& layout() {
+    static const Layout table = [] {
+        Layout l;
+        for (auto& a : l.split_id) {
+            for (auto& b : a) {
+                for (auto& c : b) {
+                    c.fill(-1);
+                }
+            }
+        }
+        for (std::size_t n = 0; n <= max_in_play; n++) {
+            for (uint8_t t = 0; t <= max_trumps; t++) {
+                for (uint8_t a = 0; a <= max_plain; a++) {
+                    for (uint8_t b = 0; b <= a; b++) {
+                        int c = static_cast<int>(n) - t - a - b;
+                        // The shortest plain suit goes to the one that lost its jack.
+                        if (c < 0 || c > b || c > static_cast<int>(max_plain) - 1) {
+                            continue;
+                        }
+                        l.split_id[n][t][a][b] = static_cast<int16_t>(l.splits[n].size());
+                        l.splits[n].push_back({t, a, b, static_cast<uint8_t>(c)});
+                    }
+                }
+            }
+        }
+
+        uint64_t offset = 0;
+        for (uint8_t k = Tablebase::min_cards; k <= Tablebase::max_supported_cards; k++) {
+            for (uint8_t z = 0; z < 4; z++) {
+                uint8_t owners = num_owners(z);
+                uint64_t arrangements = factorial(uint64_t{owners} * k);
+                for (uint8_t o = 0; o < owners; o++) {
+                    arrangements /= factorial(k);
+                }
+                l.base[k][z] = offset;
+                l.arrangements[k][z] = arrangements;
+                offset += l.splits[std::size_t{owners} * k].size() * arrangements;
+            }
+            l.entries[k] = offset;
+        }
+
+        auto& t = euchre::tables::tables();
+        for (uint8_t tr = 0; tr < 4; tr++) {
+            for (uint8_t s = 0; s < 4; s++) {
+                auto& cards = l.ranked[tr][s];
+                uint8_t size = 0;
+                for (uint32_t rest = t.suit_mask_tbl[tr][s]; rest; rest &= rest - 1) {
+                    Card c {static_cast<uint8_t>(std::countr_zero(rest))};
+                    // Insertion sort, highest power first.
+                    uint8_t i = size++;
+                    while (i > 0 && t.power[tr][s][cards[i - 1u]] < t.power[tr][s][c]) {
+                        cards[i] = cards[i - 1u];
+                        i--;
+                    }
+                    cards[i] = c;
+                }
+                l.ranked_size[tr][s] = size;
+            }
+        }
+        return l;
+    }();
+    return table;
+}
+
+/**
+ * @brief Lexicographic rank of an owner sequence among all arrangements with k cards per owner.
+ */
+uint64_t arrangement_rank(const std::array<uint8_t, max_in_play>& seq, std::size_t n, uint8_t owners, uint8_t k,
+                          uint64_t arrangements) {
+    std::array<uint8_t, 4> left {};
+    for (uint8_t o = 0; o < owners; o++) {
+        left[o] = k;
+    }
+    uint64_t rank = 0;
+    for (std::size_t i = 0, m = n; i < n; i++, m--) {
+        uint8_t o = seq[i];
+        // Arrangements that put a lower owner here come first.
+        for (uint8_t lower = 0; lower < o; lower++) {
+            rank += arrangements * left[lower] / m;
+        }
+        arrangements = arrangements * left[o] / m;
+        left[o]--;
+    }
+    return rank;
+}
+
+uint8_t read_entry(const uint8_t* packed, uint64_t entry) {
+    unsigned byte = packed[entry >> 2];
+    return static_cast<uint8_t>((byte >> ((entry & 3u) * 2u)) & 3u);
+}
+
+}
+
+Tablebase::Tablebase(const std::string& path) : file(path) {
+    const uint8_t* bytes = file.data();
+    std::size_t size = file.size();
+
+    Header header {};
+    if (size >= sizeof(Header)) {
+        std::memcpy(&header, bytes, sizeof(Header));
+    }
+    bool valid = size >= sizeof(Header) && header.magic == file_magic && header.version == file_version &&
+                 header.max_cards >= min_cards && header.max_cards <= max_supported_cards &&
+                 header.entries == layout().entries[header.max_cards] &&
+                 size == sizeof(Header) + (header.entries + 3) / 4;
+    if (!valid) {
+        throw std::runtime_error("Not a tablebase: " + path);
+    }
+    data = bytes + sizeof(Header);
+    cards = static_cast<uint8_t>(header.max_cards);
+}
+
+Tablebase::Tablebase(const uint8_t* packed, uint8_t max_cards) : data(packed), cards(max_cards) {}
+
+Tablebase::Tablebase(Tablebase&& other) noexcept
+    : data(std::exchange(other.data, nullptr)), cards(std::exchange(other.cards, 0)), file(std::move(other.file)) {}
+
+Tablebase& Tablebase::operator=(Tablebase&& other) noexcept {
+    if (this != &other) {
+        data = std::exchange(other.data, nullptr);
+        cards = std::exchange(other.cards, 0);
+        file = std::move(other.file);
+    }
+    return *this;
+}
+
+int Tablebase::probe(const std::array<uint32_t, 4>& hands, Suit trump, uint8_t lead_player, bool going_alone,
+                     uint8_t maker_player) const {
+    auto k = static_cast<uint8_t>(std::popcount(hands[lead_player]));
+    if (k < min_cards || k > cards) {
+        return -1;
+    }
+
+    const Layout& l = layout();
+    uint8_t z = 0;
+    if (going_alone) {
+        z = static_cast<uint8_t>((euchre::rules::sitting_out_player(maker_player) + 4 - lead_player) % 4);
+    }
+
+    // Label the playing seats 0, 1, ... in turn from the leader.
+    std::array<uint8_t, euchre::constants::num_cards> owner {};
+    uint32_t in_play = 0;
+    uint8_t label = 0;
+    for (uint8_t rel = 0; rel < 4; rel++) {
+        if (going_alone && rel == z) {
+            continue;
+        }
+        uint32_t hand = hands[(lead_player + rel) % 4];
+        for (uint32_t rest = hand; rest; rest &= rest - 1) {
+            owner[static_cast<std::size_t>(std::countr_zero(rest))] = label;
+        }
+        in_play |= hand;
+        label++;
+    }
+
+    // Trump first, then the plain suits longest first.
+    auto& t = euchre::tables::tables();
+    std::array<uint8_t, 4> order {static_cast<uint8_t>(trump), 0, 0, 0};
+    std::array<uint8_t, 4> length {};
+    for (uint8_t s = 0, p = 1; s < 4; s++) {
+        length[s] = static_cast<uint8_t>(std::popcount(in_play & t.suit_mask_tbl[trump][s]));
+        if (s == trump) {
+            continue;
+        }
+        uint8_t i = p++;
+        while (i > 1 && length[order[i - 1u]] < length[s]) {
+            order[i] = order[i - 1u];
+            i--;
+        }
+        order[i] = s;
+    }
+
+    std::array<uint8_t, max_in_play> seq {};
+    std::size_t n = 0;
+    for (uint8_t s : order) {
+        const auto& cards_by_rank = l.ranked[trump][s];
+        for (uint8_t i = 0; i < l.ranked_size[trump][s]; i++) {
+            Card c = cards_by_rank[i];
+            if (in_play & (1u << c)) {
+                seq[n++] = owner[c];
+            }
+        }
+    }
+
+    int16_t split = l.split_id[n][length[order[0]]][length[order[1]]][length[order[2]]];
+    if (split < 0) {
+        return -1;
+    }
+    uint64_t arrangements = l.arrangements[k][z];
+    uint64_t entry = l.base[k][z] + static_cast<uint64_t>(split) * arrangements +
+                     arrangement_rank(seq, n, num_owners(z), k, arrangements);
+    return read_entry(data, entry);
+}
+
+void Tablebase::generate(const std::string& path, uint8_t max_cards, WorkerPool* pool) {
+    if (max_cards < min_cards || max_cards > max_supported_cards) {
+        throw std::invalid_argument("Tablebases cover two or three cards per hand");
+    }
+
+    const Layout& l = layout();
+    std::vector<uint8_t> packed((l.entries[max_cards] + 3) / 4, 0);
+    std::vector<uint8_t> values;
+
+    std::size_t threads = pool ? pool->size() : 1;
+    std::vector<DoubleDummySolver> solvers;
+    solvers.reserve(threads);
+    for (std::size_t w = 0; w < threads; w++) {
+        solvers.emplace_back(16);
+    }
+
+    // Realise abstract positions with hearts as trump: spades and clubs take the two longest plain
+    // suits and diamonds, short its jack, the shortest.
+    constexpr std::array<Suit, 4> suits = {Suit::H, Suit::S, Suit::C, Suit::D};
+
+    for (uint8_t k = min_cards; k <= max_cards; k++) {
+        // Smaller endgames are already packed, so searches stop at them.
+        Tablebase smaller(packed.data(), static_cast<uint8_t>(k - 1));
+        for (auto& solver : solvers) {
+            solver.set_tablebase(k > min_cards ? &smaller : nullptr);
+        }
+
+        uint64_t first = l.base[k][0];
+        values.assign(l.entries[k] - first, 0);
+        for (uint8_t z = 0; z < 4; z++) {
+            uint8_t owners = num_owners(z);
+            std::size_t n = std::size_t{owners} * k;
+            const auto& splits = l.splits[n];
+            uint64_t arrangements = l.arrangements[k][z];
+
+            std::array<uint8_t, 4> seat_of {};
+            for (uint8_t rel = 0, label = 0; rel < 4; rel++) {
+                if (z == 0 || rel != z) {
+                    seat_of[label++] = rel;
+                }
+            }
+
+            auto solve_splits = [&](std::size_t worker, std::size_t begin, std::size_t end) {
+                DoubleDummySolver& solver = solvers[worker];
+                for (std::size_t si = begin; si < end; si++) {
+                    std::array<uint8_t, max_in_play> seq {};
+                    for (std::size_t i = 0; i < n; i++) {
+                        seq[i] = static_cast<uint8_t>(i / k);
+                    }
+                    uint64_t entry = l.base[k][z] - first + si * arrangements;
+                    do {
+                        DDPosition pos;
+                        pos.trump = Suit::H;
+                        pos.going_alone = z != 0;
+                        pos.maker_player = static_cast<uint8_t>((z + 2) % 4);
+                        std::size_t i = 0;
+                        for (std::size_t s = 0; s < suits.size(); s++) {
+                            const auto& cards_by_rank = l.ranked[Suit::H][suits[s]];
+                            for (uint8_t r = 0; r < splits[si][s]; r++, i++) {
+                                pos.hands[seat_of[seq[i]]] |= 1u << cards_by_rank[r];
+                            }
+                        }
+                        values[entry++] = solver.solve(pos)[0];
+                    } while (std::next_permutation(seq.begin(), seq.begin() + static_cast<std::ptrdiff_t>(n)));
+                }
+            };
+
+            if (pool) {
+                pool->parallel_for(splits.size(), 1, solve_splits);
+            }
+            else {
+                solve_splits(0, 0, splits.size());
+            }
+        }
+
+        for (uint64_t e = 0; e < values.size(); e++) {
+            uint64_t entry = first + e;
+            packed[entry >> 2] = static_cast<uint8_t>(packed[entry >> 2] | values[e] << ((entry & 3u) * 2u));
+        }
+    }
+
+    Header header {file_magic, file_version, max_cards, l.entries[max_cards]};
+    std::ofstream out(path, std::ios::binary | std::ios::trunc);
+    out.write(reinterpret_cast<const char*>(&header), sizeof(header));
+    out.write(reinterpret_cast<const char*>(packed.data()), static_cast<std::streamsize>(packed.size()));
+    if (!out) {
+        throw std::runtime_error("Cannot write tablebase " + path);
+    }
+}
@@ -0,0 +1,320 @@
+#include "TrickKernels.hpp"
+#include "Rng.hpp"
+#include "Tables.hpp"
+#include <array>
+#include <cstring>
+#include <stdexcept>
+
+#if defined(EUCHRE_HAS_AVX2_KERNELS)
+#include <immintrin.h>
+#endif
+
+namespace {
+
+static_assert(sizeof(Card) == 1 && sizeof(Suit) == 1, "kernels read cards and suits as bytes");
+
+// An effective suit past the four real ones: nothing has been led.
+constexpr int32_t no_suit = 4;
+
+/**
+ * @brief The tables the kernels gather from, widened to 32 bits and padded to 32 cards.
+ *
+ * Cards are looked up by their low five bits, so an invalid card lands on padding: no power, and
+ * as a lead no suit to follow.
+ */
+struct KernelTables {
+    // [trump][led][card]
+    alignas(32) std::array<int32_t, 4 * 4 * 32> power {};
+    // [trump][card]
+    alignas(32) std::array<int32_t, 4 * 32> eff_suit {};
+    // [trump][effective suit, or no_suit for every card]
+    alignas(32) std::array<int32_t, 4 * 8> follow {};
+};
+
+consteval KernelTables make_kernel_tables() {
+    euchre::tables::Tables t = euchre::tables::make_tables();
+    KernelTables k;
+    for (std::size_t tr = 0; tr < 4; tr++) {
+        for (std::size_t c = 0; c < 32; c++) {
+            k.eff_suit[tr * 32 + c] = c < 24 ? t.eff_suit_tbl[tr][c] : no_suit;
+            for (std::size_t led = 0; led < 4; led++) {
+                k.power[(tr * 4 + led) * 32 + c] = c < 24 ? t.power[tr][led][c] : 0;
+            }
+        }
+        for (std::size_t s = 0; s < 4; s++) {
+            k.follow[tr * 8 + s] = static_cast<int32_t>(t.suit_mask_tbl[tr][s]);
+        }
+        k.follow[tr * 8 + static_cast<std::size_t>(no_suit)] = euchre::constants::deck_reset;
+    }
+    return k;
+}
+
+constexpr KernelTables kernel_tables = make_kernel_tables();
+
+uint8_t trick_winner(const Card* cards, Suit trump, Card lead, uint8_t sitting_out) {
+    const auto& k = kernel_tables;
+    std::size_t tr = trump & 3u;
+    auto led = static_cast<std::size_t>(k.eff_suit[tr * 32 + (lead & 31u)]) & 3u;
+    const int32_t* power = &k.power[(tr * 4 + led) * 32];
+    // Branchless: which seat wins is data dependent and would mispredict a quarter of the time.
+    uint32_t winner = 0;
+    int32_t best = 0;
+    for (uint32_t seat = 0; seat < euchre::constants::num_players; seat++) {
+        int32_t p = power[cards[seat] & 31u] & -static_cast<int32_t>(seat != sitting_out);
+        bool better = p > best;
+        best = better ? p : best;
+        winner = better ? seat : winner;
+    }
+    return static_cast<uint8_t>(winner);
+}
+
+uint32_t follow_mask(uint32_t hand, Suit trump, Card lead) {
+    const auto& k = kernel_tables;
+    std::size_t tr = trump & 3u;
+    auto led = static_cast<std::size_t>(k.eff_suit[tr * 32 + (lead & 31u)]);
+    uint32_t follow = hand & static_cast<uint32_t>(k.follow[tr * 8 + led]);
+    return follow ? follow : hand;
+}
+
+}
+
+namespace euchre::kernels {
+
+    void trick_winners_portable(std::span<const Card> trick_cards, std::span<const Suit> trump,
+                                std::span<const Card> lead_card, std::span<const uint8_t> sitting_out,
+                                std::span<uint8_t> winners) {
+        for (std::size_t g = 0; g < winners.size(); g++) {
+            winners[g] = trick_winner(&trick_cards[g * 4], trump[g], lead_card[g], sitting_out[g]);
+        }
+    }
+
+    void follow_masks_portable(std::span<const uint32_t> hands, std::span<const Suit> trump,
+                               std::span<const Card> lead_card, std::span<uint32_t> masks) {
+        for (std::size_t g = 0; g < masks.size(); g++) {
+            masks[g] = follow_mask(hands[g], trump[g], lead_card[g]);
+        }
+    }
+
+    void philox_blocks_portable(std::span<const uint32_t> ctr0, std::span<const uint32_t> ctr1,
+                                std::span<const uint32_t> key0, uint32_t key1,
+                                const std::array<std::span<uint32_t>, 4>& out) {
+        for (std::size_t i = 0; i < ctr0.size(); i++) {
+            auto block = euchre::rng::philox4x32({ctr0[i], ctr1[i], 0, 0}, {key0[i], key1});
+            for (std::size_t j = 0; j < 4; j++) {
+                out[j][i] = block[j];
+            }
+        }
+    }
+
+#if defined(EUCHRE_HAS_AVX2_KERNELS)
+
+    namespace {
+
+        // Eight bytes, zero extended to one 32 bit lane each.
+        __attribute__((target("avx2")))
+        inline __m256i load_bytes(const void* p) {
+            return _mm256_cvtepu8_epi32(_mm_loadl_epi64(static_cast<const __m128i*>(p)));
+        }
+
+        // The high and low halves of eight 32x32 -> 64 bit products. mul_epu32 only multiplies the
+        // even lanes, so the odd ones go through a 64 bit shift and the halves are blended back.
+        __attribute__((target("avx2")))
+        inline void mul_hi_lo(__m256i x, __m256i m, __m256i& hi, __m256i& lo) {
+            __m256i even = _mm256_mul_epu32(x, m);
+            __m256i odd = _mm256_mul_epu32(_mm256_srli_epi64(x, 32), m);
+            hi = _mm256_blend_epi32(_mm256_srli_epi64(even, 32), odd, 0xAA);
+            lo = _mm256_blend_epi32(even, _mm256_slli_epi64(odd, 32), 0xAA);
+        }
+
+    }
+
+    __attribute__((target("avx2")))
+    void trick_winners_avx2(std::span<const Card> trick_cards, std::span<const Suit> trump,
+                            std::span<const Card> lead_card, std::span<const uint8_t> sitting_out,
+                            std::span<uint8_t> winners) {
+        const auto& k = kernel_tables;
+        const __m256i low5 = _mm256_set1_epi32(31);
+        const __m256i low2 = _mm256_set1_epi32(3);
+        const __m256i byte = _mm256_set1_epi32(0xFF);
+
+        std::size_t n = winners.size();
+        std::size_t g = 0;
+        for (; g + 8 <= n; g += 8) {
+            // One lane per game, its four trick cards packed in the lane's bytes.
+            __m256i cards = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&trick_cards[g * 4]));
+            __m256i tr = _mm256_and_si256(load_bytes(&trump[g]), low2);
+            __m256i lead = _mm256_and_si256(load_bytes(&lead_card[g]), low5);
+            __m256i out = load_bytes(&sitting_out[g]);
+
+            __m256i led = _mm256_i32gather_epi32(k.eff_suit.data(), _mm256_add_epi32(_mm256_slli_epi32(tr, 5), lead), 4);
+            led = _mm256_and_si256(led, low2);
+            __m256i row = _mm256_slli_epi32(_mm256_add_epi32(_mm256_slli_epi32(tr, 2), led), 5);
+
+            __m256i best = _mm256_setzero_si256();
+            __m256i winner = _mm256_setzero_si256();
+            for (int32_t seat = 0; seat < euchre::constants::num_players; seat++) {
+                __m256i card = _mm256_and_si256(_mm256_and_si256(cards, byte), low5);
+                __m256i power = _mm256_i32gather_epi32(k.power.data(), _mm256_add_epi32(row, card), 4);
+                power = _mm256_andnot_si256(_mm256_cmpeq_epi32(out, _mm256_set1_epi32(seat)), power);
+                __m256i better = _mm256_cmpgt_epi32(power, best);
+                best = _mm256_blendv_epi8(best, power, better);
+                winner = _mm256_blendv_epi8(winner, _mm256_set1_epi32(seat), better);
+                cards = _mm256_srli_epi32(cards, 8);
+            }
+
+            // Narrow the eight lanes to bytes: the low byte of each lane, in order.
+            const __m256i pick = _mm256_setr_epi8(0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1,
+                                                  0, 4, 8, 12, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1, -1);
+            __m256i packed = _mm256_shuffle_epi8(winner, pick);
+            uint32_t lo = static_cast<uint32_t>(_mm256_extract_epi32(packed, 0));
+            uint32_t hi = static_cast<uint32_t>(_mm256_extract_epi32(packed, 4));
+            uint64_t bytes = lo | static_cast<uint64_t>(hi) << 32;
+            std::memcpy(&winners[g], &bytes, sizeof(bytes));
+        }
+        trick_winners_portable(trick_cards.subspan(g * 4), trump.subspan(g), lead_card.subspan(g),
+                               sitting_out.subspan(g), winners.subspan(g));
+    }
+
+    __attribute__((target("avx2")))
+    void follow_masks_avx2(std::span<const uint32_t> hands, std::span<const Suit> trump,
+                           std::span<const Card> lead_card, std::span<uint32_t> masks) {
+        const auto& k = kernel_tables;
+        const __m256i low5 = _mm256_set1_epi32(31);
+        const __m256i low2 = _mm256_set1_epi32(3);
+
+        std::size_t n = masks.size();
+        std::size_t g = 0;
+        for (; g + 8 <= n; g += 8) {
+            __m256i hand = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&hands[g]));
+            __m256i tr = _mm256_and_si256(load_bytes(&trump[g]), low2);
+            __m256i lead = _mm256_and_si256(load_bytes(&lead_card[g]), low5);
+
+            __m256i led = _mm256_i32gather_epi32(k.eff_suit.data(), _mm256_add_epi32(_mm256_slli_epi32(tr, 5), lead), 4);
+            __m256i suit = _mm256_i32gather_epi32(k.follow.data(), _mm256_add_epi32(_mm256_slli_epi32(tr, 3), led), 4);
+            __m256i follow = _mm256_and_si256(hand, suit);
+            __m256i cannot = _mm256_cmpeq_epi32(follow, _mm256_setzero_si256());
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&masks[g]), _mm256_blendv_epi8(follow, hand, cannot));
+        }
+        follow_masks_portable(hands.subspan(g), trump.subspan(g), lead_card.subspan(g), masks.subspan(g));
+    }
+
+    __attribute__((target("avx2")))
+    void philox_blocks_avx2(std::span<const uint32_t> ctr0, std::span<const uint32_t> ctr1,
+                            std::span<const uint32_t> key0, uint32_t key1, const std::array<std::span<uint32_t>, 4>& out) {
+        const __m256i mul0 = _mm256_set1_epi32(static_cast<int32_t>(0xD2511F53));
+        const __m256i mul1 = _mm256_set1_epi32(static_cast<int32_t>(0xCD9E8D57));
+        const __m256i bump0 = _mm256_set1_epi32(static_cast<int32_t>(0x9E3779B9));
+
+        std::size_t n = ctr0.size();
+        std::size_t i = 0;
+        for (; i + 8 <= n; i += 8) {
+            __m256i x0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&ctr0[i]));
+            __m256i x1 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&ctr1[i]));
+            __m256i x2 = _mm256_setzero_si256();
+            __m256i x3 = _mm256_setzero_si256();
+            __m256i k0 = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(&key0[i]));
+            uint32_t k1 = key1;
+            for (int round = 0; round < 10; round++) {
+                __m256i hi0, lo0, hi1, lo1;
+                mul_hi_lo(x0, mul0, hi0, lo0);
+                mul_hi_lo(x2, mul1, hi1, lo1);
+                x0 = _mm256_xor_si256(_mm256_xor_si256(hi1, x1), k0);
+                x1 = lo1;
+                x2 = _mm256_xor_si256(_mm256_xor_si256(hi0, x3), _mm256_set1_epi32(static_cast<int32_t>(k1)));
+                x3 = lo0;
+                k0 = _mm256_add_epi32(k0, bump0);
+                k1 += 0xBB67AE85;
+            }
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out[0][i]), x0);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out[1][i]), x1);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out[2][i]), x2);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(&out[3][i]), x3);
+        }
+        philox_blocks_portable(ctr0.subspan(i), ctr1.subspan(i), key0.subspan(i), key1,
+                               {out[0].subspan(i), out[1].subspan(i), out[2].subspan(i), out[3].subspan(i)});
+    }
+
+    bool cpu_has_avx2() {
+        return __builtin_cpu_supports("avx2");
+    }
+
+#else
+
+    bool cpu_has_avx2() {
+        return false;
+    }
+
+#endif
+
+    namespace {
+
+        using WinnersFn = void (*)(std::span<const Card>, std::span<const Suit>, std::span<const Card>,
+                                   std::span<const uint8_t>, std::span<uint8_t>);
+        using MasksFn = void (*)(std::span<const uint32_t>, std::span<const Suit>, std::span<const Card>,
+                                 std::span<uint32_t>);
+        using PhiloxFn = void (*)(std::span<const uint32_t>, std::span<const uint32_t>, std::span<const uint32_t>,
+                                  uint32_t, const std::array<std::span<uint32_t>, 4>&);
+
+        WinnersFn pick_winners() {
+#if defined(EUCHRE_HAS_AVX2_KERNELS)
+            if (cpu_has_avx2()) {
+                return trick_winners_avx2;
+            }
+#endif
+            return trick_winners_portable;
+        }
+
+        MasksFn pick_masks() {
+#if defined(EUCHRE_HAS_AVX2_KERNELS)
+            if (cpu_has_avx2()) {
+                return follow_masks_avx2;
+            }
+#endif
+            return follow_masks_portable;
+        }
+
+        PhiloxFn pick_philox() {
+#if defined(EUCHRE_HAS_AVX2_KERNELS)
+            if (cpu_has_avx2()) {
+                return philox_blocks_avx2;
+            }
+#endif
+            return philox_blocks_portable;
+        }
+
+        const WinnersFn winners_impl = pick_winners();
+        const MasksFn masks_impl = pick_masks();
+        const PhiloxFn philox_impl = pick_philox();
+
+    }
+
+    void trick_winners(std::span<const Card> trick_cards, std::span<const Suit> trump,
+                       std::span<const Card> lead_card, std::span<const uint8_t> sitting_out,
+                       std::span<uint8_t> winners) {
+        std::size_t n = winners.size();
+        if (trick_cards.size() != n * euchre::constants::num_players || trump.size() != n ||
+            lead_card.size() != n || sitting_out.size() != n) {
+            throw std::invalid_argument("trick_winners needs four cards and one trump, lead and seat per game");
+        }
+        winners_impl(trick_cards, trump, lead_card, sitting_out, winners);
+    }
+
+    void follow_masks(std::span<const uint32_t> hands, std::span<const Suit> trump,
+                      std::span<const Card> lead_card, std::span<uint32_t> masks) {
+        std::size_t n = masks.size();
+        if (hands.size() != n || trump.size() != n || lead_card.size() != n) {
+            throw std::invalid_argument("follow_masks needs one hand, trump and lead per game");
+        }
+        masks_impl(hands, trump, lead_card, masks);
+    }
+
+    void philox_blocks(std::span<const uint32_t> ctr0, std::span<const uint32_t> ctr1, std::span<const uint32_t> key0,
+                       uint32_t key1, const std::array<std::span<uint32_t>, 4>& out) {
+        std::size_t n = ctr0.size();
+        if (ctr1.size() != n || key0.size() != n || out[0].size() != n || out[1].size() != n ||
+            out[2].size() != n || out[3].size() != n) {
+            throw std::invalid_argument("philox_blocks needs one counter, key and output word per block");
+        }
+        philox_impl(ctr0, ctr1, key0, key1, out);
+    }
+}
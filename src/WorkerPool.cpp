@@ -0,0 +1,161 @@
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <limits>
+#include <stdexcept>
+#include <utility>
+
+namespace {
+
+// The pool whose worker_loop() this thread runs, if any.
+thread_local const WorkerPool* current_pool = nullptr;
+
+}
+
+WorkerPool::WorkerPool(std::size_t num_threads) : slices(std::make_unique<Slice[]>(std::max<std::size_t>(num_threads, 1))) {
+    num_threads = std::max<std::size_t>(num_threads, 1);
+    threads.reserve(num_threads);
+    for (std::size_t w = 0; w < num_threads; w++) {
+        threads.emplace_back([this, w] { worker_loop(w); });
+    }
+}
+
+WorkerPool::~WorkerPool() {
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    start_cv.notify_all();
+    for (auto& t : threads) {
+        t.join();
+    }
+}
+
+void WorkerPool::parallel_for(std::size_t n, std::size_t grain, const RangeFn& fn) {
+    if (current_pool == this) {
+        throw std::logic_error("parallel_for called from one of the pool's own workers");
+    }
+    if (n == 0) {
+        return;
+    }
+    if (n > std::numeric_limits<uint32_t>::max()) {
+        throw std::invalid_argument("parallel_for range is limited to 32 bit indices");
+    }
+
+    std::lock_guard caller(caller_mutex);
+    // Even contiguous slices up front; stealing evens out whatever imbalance remains.
+    std::size_t workers = threads.size();
+    for (std::size_t w = 0; w < workers; w++) {
+        auto begin = static_cast<uint32_t>(n * w / workers);
+        auto end = static_cast<uint32_t>(n * (w + 1) / workers);
+        slices[w].range.store(pack(begin, end), std::memory_order_relaxed);
+    }
+
+    std::unique_lock lock(mutex);
+    job = &fn;
+    job_grain = std::max<std::size_t>(grain, 1);
+    job_error = nullptr;
+    active = workers;
+    generation++;
+    start_cv.notify_all();
+    done_cv.wait(lock, [this] { return active == 0; });
+    job = nullptr;
+
+    if (job_error) {
+        std::rethrow_exception(std::exchange(job_error, nullptr));
+    }
+}
+
+void WorkerPool::worker_loop(std::size_t worker) {
+    current_pool = this;
+    uint64_t seen = 0;
+    for (;;) {
+        {
+            std::unique_lock lock(mutex);
+            start_cv.wait(lock, [&] { return stopping || generation != seen; });
+            if (stopping) {
+                return;
+            }
+            seen = generation;
+        }
+
+        run_job(worker);
+
+        std::lock_guard lock(mutex);
+        if (--active == 0) {
+            done_cv.notify_one();
+        }
+    }
+}
+
+void WorkerPool::run_job(std::size_t worker) {
+    uint32_t begin = 0;
+    uint32_t end = 0;
+
+    for (;;) {
+        while (take(worker, begin, end)) {
+            try {
+                (*job)(worker, begin, end);
+            }
+            catch (...) {
+                std::lock_guard lock(mutex);
+                if (!job_error) {
+                    job_error = std::current_exception();
+                }
+            }
+        }
+        if (!steal(worker)) {
+            return;
+        }
+    }
+}
+
+bool WorkerPool::take(std::size_t worker, uint32_t& begin, uint32_t& end) {
+    std::atomic<uint64_t>& range = slices[worker].range;
+    uint64_t current = range.load(std::memory_order_acquire);
+    for (;;) {
+        uint32_t b = begin_of(current);
+        uint32_t e = end_of(current);
+        if (b >= e) {
+            return false;
+        }
+        uint32_t next = static_cast<uint32_t>(std::min<std::size_t>(e, b + job_grain));
+        if (range.compare_exchange_weak(current, pack(next, e), std::memory_order_acq_rel)) {
+            begin = b;
+            end = next;
+            return true;
+        }
+    }
+}
+
+bool WorkerPool::steal(std::size_t worker) {
+    for (;;) {
+        // Pick the victim with the most work left.
+        std::size_t victim = worker;
+        uint32_t most = 0;
+        for (std::size_t w = 0; w < threads.size(); w++) {
+            uint64_t r = slices[w].range.load(std::memory_order_acquire);
+            uint32_t left = begin_of(r) < end_of(r) ? end_of(r) - begin_of(r) : 0;
+            if (left > most) {
+                most = left;
+                victim = w;
+            }
+        }
+        if (most == 0) {
+            return false;
+        }
+
+        std::atomic<uint64_t>& range = slices[victim].range;
+        uint64_t current = range.load(std::memory_order_acquire);
+        uint32_t b = begin_of(current);
+        uint32_t e = end_of(current);
+        if (b >= e) {
+            continue;
+        }
+        // Leave the victim at least one piece; if that is all there is, take it whole.
+        uint32_t mid = e - b > 1 ? b + (e - b) / 2 : b;
+        if (range.compare_exchange_strong(current, pack(b, mid), std::memory_order_acq_rel)) {
+            slices[worker].range.store(pack(mid, e), std::memory_order_release);
+            return true;
+        }
+    }
+}
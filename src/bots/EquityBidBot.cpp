@@ -0,0 +1,57 @@
+#include "bots/EquityBidBot.hpp"
+#include <algorithm>
+
+std::optional<EquityTable::Values> EquityBidBot::lookup(const Observation& obs, Suit trump) const {
+    auto seat = static_cast<uint8_t>((obs.player + euchre::constants::num_players - obs.dealer) %
+                                     euchre::constants::num_players);
+    return table.lookup(EquityTable::key(obs.hand, trump, obs.face_up_card, seat));
+}
+
+ActionId EquityBidBot::bid_phase_1_action(const Observation& obs, ActionMask action_mask) {
+    auto values = lookup(obs, obs.face_up_card.get_suit());
+    if (!values) {
+        return HeuristicBot::bid_phase_1_action(obs, action_mask);
+    }
+    const auto& v = *values;
+    return std::max(v[EquityTable::Make], v[EquityTable::Alone]) > v[EquityTable::Pass] ? euchre::action::OrderUp
+                                                                                         : euchre::action::Pass;
+}
+
+ActionId EquityBidBot::bid_phase_2_action(const Observation& obs, ActionMask action_mask) {
+    Suit best_suit = Suit::None;
+    EquityTable::Values best {};
+    for (uint8_t s = 0; s < 4; s++) {
+        Suit suit = Suit(s);
+        if ((euchre::action::a2m(euchre::action::call_trump(suit)) & action_mask) == 0) continue;
+
+        auto values = lookup(obs, suit);
+        if (!values) {
+            return HeuristicBot::bid_phase_2_action(obs, action_mask);
+        }
+        float make = std::max((*values)[EquityTable::Make], (*values)[EquityTable::Alone]);
+        if (best_suit == Suit::None || make > std::max(best[EquityTable::Make], best[EquityTable::Alone])) {
+            best_suit = suit;
+            best = *values;
+        }
+    }
+    if (best_suit == Suit::None) {
+        return HeuristicBot::bid_phase_2_action(obs, action_mask);
+    }
+
+    // Pass and call values of the same key come from the same deals, so compare within it.
+    bool can_pass = (action_mask & euchre::action::a2m(euchre::action::Pass)) != 0;
+    if (can_pass && best[EquityTable::Pass] >= std::max(best[EquityTable::Make], best[EquityTable::Alone])) {
+        return euchre::action::Pass;
+    }
+    return euchre::action::call_trump(best_suit);
+}
+
+ActionId EquityBidBot::go_alone_action(const Observation& obs, ActionMask action_mask) {
+    // The maker decides before the dealer picks up, so this is the key the bid was made on.
+    auto values = lookup(obs, obs.trump);
+    if (!values) {
+        return HeuristicBot::go_alone_action(obs, action_mask);
+    }
+    return (*values)[EquityTable::Alone] > (*values)[EquityTable::Make] ? euchre::action::GoAloneYes
+                                                                        : euchre::action::GoAloneNo;
+}
@@ -78,37 +78,15 @@ ActionId HeuristicBot::go_alone_action(const Observation& obs, [[maybe_unused]]
 }
 
 ActionId HeuristicBot::dealer_pickup_discard_action(const Observation& obs, [[maybe_unused]] ActionMask action_mask) {
-    auto& t = euchre::tables::tables();
-    uint32_t h = obs.hand.value();
-    Suit trump = obs.trump;
-
     // Find the weakest card to discard
     // Use trump as led_suit so trump cards get high power and we discard off-suit trash
-    Card weakest{};
-    uint8_t weakest_power = 255;
-
-    uint32_t remaining = h;
-    while (remaining) {
-        uint32_t bit = remaining & static_cast<uint32_t>(-static_cast<int32_t>(remaining));
-        int idx = std::countr_zero(bit);
-        Card c{static_cast<uint8_t>(idx)};
-
-        // Evaluate with trump as led_suit to get meaningful ordering
-        // Off-suit cards get low power (0-5), led-suit gets 100+, trump gets 194+
-        uint8_t power = t.power[trump][trump][c];
-        if (power < weakest_power) {
-            weakest_power = power;
-            weakest = c;
-        }
-        remaining &= remaining - 1;
-    }
-
-    return euchre::action::discard(weakest);
+    return euchre::action::discard(lowest_card(obs.hand.value(), obs.trump, obs.trump));
 }
 
 ActionId HeuristicBot::play_trick(const Observation& obs, ActionMask action_mask) {
-    auto& t = euchre::tables::tables();
-    uint32_t valid_cards = static_cast<uint32_t>(action_mask & 0xFFFFFF); // play actions are [0-24)
+    // The Joker deck's tables also count a Joker as trump; for standard hands they are the same.
+    auto& t = euchre::tables::tables<euchre::tables::joker_deck>();
+    uint32_t valid_cards = euchre::action::play_cards(action_mask);
     Suit trump = obs.trump;
 
     if (obs.num_played == 0) {
@@ -1,4 +1,5 @@
 #include "bots/IBot.hpp"
+#include <bit>
 
 ActionId IBot::select_action(const Observation& obs, ActionMask action_mask) {
      switch(obs.phase) {
@@ -12,8 +13,27 @@ ActionId IBot::select_action(const Observation& obs, ActionMask action_mask) {
                 return dealer_pickup_discard_action(obs, action_mask);
             case Phase::PlayTrick:
                 return play_trick(obs, action_mask);
+            case Phase::DefendAloneDecision:
+                return defend_alone_action(obs, action_mask);
+            case Phase::FarmerSwap:
+                return farmer_swap_action(obs, action_mask);
+            case Phase::FarmerDiscard:
+                return farmer_discard_action(obs, action_mask);
             default:
                 throw std::logic_error("Error: Invalid phase.");
         }
 }
 
+
+
+ActionId IBot::defend_alone_action([[maybe_unused]] const Observation& obs, [[maybe_unused]] ActionMask action_mask) {
+    return euchre::action::DefendAloneNo;
+}
+
+ActionId IBot::farmer_swap_action([[maybe_unused]] const Observation& obs, [[maybe_unused]] ActionMask action_mask) {
+    return euchre::action::FarmerSwapNo;
+}
+
+ActionId IBot::farmer_discard_action([[maybe_unused]] const Observation& obs, ActionMask action_mask) {
+    return ActionId(static_cast<uint16_t>(std::countr_zero(action_mask)));
+}
@@ -0,0 +1,267 @@
+#include "bots/IsmctsBot.hpp"
+#include "Deck.hpp"
+#include "Rules.hpp"
+#include "Tables.hpp"
+#include <algorithm>
+#include <bit>
+#include <cmath>
+
+namespace {
+
+// Exploration constant for rewards scaled to [-1, 1].
+constexpr float exploration = 0.7f;
+
+// Bidding (8) + go alone + discard + 20 card plays, with room to spare.
+constexpr std::size_t max_depth = 40;
+
+constexpr uint32_t no_node = 0;
+
+/**
+ * @brief The legal actions with equivalent card plays collapsed, judged only on public information.
+ */
+ActionMask distinct_actions(const Observation& obs, ActionMask mask) {
+    if (obs.phase != Phase::PlayTrick) {
+        return mask;
+    }
+    // Cards in the trick under way still separate the cards around them.
+    uint32_t out_of_play = obs.played;
+    uint8_t seat = obs.player;
+    for (uint8_t i = 0; i < obs.num_played; i++) {
+        seat = euchre::rules::previous_player(seat, obs.going_alone, obs.maker_player);
+        out_of_play &= ~(1u << obs.trick_cards[seat]);
+    }
+    auto cards = static_cast<uint32_t>(mask & euchre::constants::deck_reset);
+    return euchre::rules::distinct_moves(cards, obs.trump, out_of_play);
+}
+
+}
+
+void IsmctsBot::Arena::reset() {
+    nodes.clear();
+    nodes.push_back(Node{no_node, no_node, euchre::action::InvalidAction, 0, 0, 0, 0.0f});
+}
+
+uint32_t IsmctsBot::Arena::add(uint32_t parent, ActionId action, uint8_t player) {
+    auto index = static_cast<uint32_t>(nodes.size());
+    nodes.push_back(Node{no_node, nodes[parent].first_child, action, player, 0, 0, 0.0f});
+    nodes[parent].first_child = index;
+    return index;
+}
+
+IsmctsBot::IsmctsBot(std::string name, int iterations, int trees, std::chrono::microseconds budget, WorkerPool* worker_pool)
+    : IBot(std::move(name)), num_iterations(iterations), num_trees(std::max(trees, 1)), time_budget(budget), pool(worker_pool) {
+    std::size_t threads = pool ? pool->size() : 1;
+    workers.resize(threads);
+    for (auto& w : workers) {
+        w.arena.nodes.reserve(static_cast<std::size_t>(num_iterations) + 1);
+    }
+    per_tree.resize(static_cast<std::size_t>(num_trees));
+}
+
+void IsmctsBot::on_new_match(uint32_t match_seed) {
+    seed = match_seed;
+    decisions = 0;
+}
+
+GameState IsmctsBot::determinize(const Observation& obs, ActionMask action_mask, const DealConstraints& constraints,
+                                 const DealSampler& sampler, euchre::rng::Philox4x32& eng) const {
+    GameState gs;
+    HandState& hs = gs.hand_state;
+    uint8_t me = obs.player;
+
+    gs.dealer = obs.dealer;
+    gs.hands_dealt = 1;
+    hs.phase = obs.phase;
+    hs.current_player = me;
+    hs.trump = obs.trump;
+    hs.face_up_card = obs.face_up_card;
+    hs.maker_team = obs.maker_team;
+    hs.maker_player = obs.maker_player;
+    hs.going_alone = obs.going_alone;
+    hs.tricks_won[0] = obs.tricks_won[0];
+    hs.tricks_won[1] = obs.tricks_won[1];
+    hs.lead_card = obs.lead;
+    hs.num_played = obs.num_played;
+    // Only the dealer can see stick the dealer in effect: Pass is missing from its round 2 mask.
+    hs.stick_the_dealer = obs.phase == Phase::BidRound2 && me == obs.dealer &&
+                          (action_mask & euchre::action::a2m(euchre::action::Pass)) == 0;
+
+    if (obs.phase == Phase::PlayTrick) {
+        hs.lead_player = constraints.lead_player;
+        hs.tricks_played = static_cast<uint8_t>(5 - std::popcount(obs.hand.value()));
+        for (uint8_t seat = 0; seat < euchre::constants::num_players; seat++) {
+            if (constraints.trick_seats & (1u << seat)) {
+                hs.trick_cards[seat] = obs.trick_cards[seat];
+                hs.trick_history[hs.tricks_played][seat] = obs.trick_cards[seat];
+            }
+        }
+
+        // The public history, so moves in the tree collapse exactly as they do at the root. Which
+        // finished trick each card fell in is not observed; only the trick under way is recorded.
+        const auto& t = euchre::tables::tables();
+        hs.played = obs.played;
+        hs.played_by = obs.played_by;
+        for (uint8_t seat = 0; seat < euchre::constants::num_players; seat++) {
+            for (uint8_t s = 0; s < 4; s++) {
+                uint32_t suit = t.suit_mask_tbl[obs.trump][s];
+                if (suit != 0 && (obs.voids[seat] & suit) == suit) {
+                    hs.void_suits[seat] = static_cast<uint8_t>(hs.void_suits[seat] | 1u << s);
+                }
+            }
+        }
+    }
+
+    auto hands = sampler.sample(eng);
+    for (uint8_t seat = 0; seat < euchre::constants::num_players; seat++) {
+        hs.hands[seat] = Hand{hands[seat]};
+    }
+    hs.deck = sampler.buried(hands);
+    return gs;
+}
+
+void IsmctsBot::grow_tree(const Observation& obs, ActionMask action_mask, const DealConstraints& constraints,
+                          const DealSampler& sampler, euchre::rng::Philox4x32& eng, Worker& worker, Visits& visits) {
+    Arena& arena = worker.arena;
+    Env& env = worker.env;
+    arena.reset();
+    auto deadline = std::chrono::steady_clock::now() + time_budget;
+
+    for (int it = 0; it < num_iterations; it++) {
+        if (time_budget.count() > 0 && it % 32 == 0 && it > 0 && std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+
+        env.state = determinize(obs, action_mask, constraints, sampler, eng);
+        uint32_t hand = env.state.hands_dealt;
+        std::array<uint32_t, max_depth> path;
+        std::size_t depth = 0;
+        uint32_t node = 0;
+        bool expanded = false;
+
+        while (env.state.hands_dealt == hand) {
+            auto decision = env.next_decision();
+            if (!decision) {
+                break;
+            }
+            if (expanded || depth == max_depth) {
+                env.apply(worker.rollout.select_action(decision->obs, decision->mask));
+                continue;
+            }
+
+            // Subset-armed UCB: only children legal in this deal compete, and each counts how
+            // often it was available rather than how often its parent was visited.
+            ActionMask legal = distinct_actions(decision->obs, decision->mask);
+            ActionMask tried = 0;
+            uint32_t best = no_node;
+            float best_score = -INFINITY;
+            for (uint32_t c = arena.nodes[node].first_child; c != no_node; c = arena.nodes[c].next_sibling) {
+                Node& child = arena.nodes[c];
+                if ((legal & euchre::action::a2m(child.action)) == 0) {
+                    continue;
+                }
+                tried |= euchre::action::a2m(child.action);
+                child.available++;
+                float mean = (child.player % 2 == 0 ? child.total : -child.total) / static_cast<float>(child.visits);
+                float score = mean + exploration * std::sqrt(std::log(static_cast<float>(child.available)) /
+                                                             static_cast<float>(child.visits));
+                if (score > best_score) {
+                    best_score = score;
+                    best = c;
+                }
+            }
+
+            ActionMask untried = legal & ~tried;
+            if (untried) {
+                ActionId action {static_cast<uint16_t>(pick_random_bit(untried, eng))};
+                best = arena.add(node, action, decision->player);
+                arena.nodes[best].available = 1;
+                expanded = true;
+            }
+            path[depth++] = best;
+            node = best;
+            env.apply(arena.nodes[best].action);
+        }
+
+        float reward = static_cast<float>(env.state.scores[0] - env.state.scores[1]) / 4.0f;
+        for (std::size_t i = 0; i < depth; i++) {
+            Node& n = arena.nodes[path[i]];
+            n.visits++;
+            n.total += reward;
+        }
+    }
+
+    for (uint32_t c = arena.nodes[0].first_child; c != no_node; c = arena.nodes[c].next_sibling) {
+        visits[arena.nodes[c].action] += arena.nodes[c].visits;
+    }
+}
+
+ActionId IsmctsBot::search(const Observation& obs, ActionMask action_mask) {
+    DealConstraints constraints;
+    bool feasible = deal_sampler.reset_for(obs, constraints);
+    ActionMask distinct = distinct_actions(obs, action_mask);
+    if (std::popcount(distinct) == 1) {
+        return ActionId{static_cast<uint16_t>(std::countr_zero(distinct))};
+    }
+
+    uint32_t decision = decisions++;
+    if (!feasible) {
+        return ActionId{static_cast<uint16_t>(std::countr_zero(distinct))};
+    }
+
+    std::fill(per_tree.begin(), per_tree.end(), Visits{});
+    auto run_tree = [&](Worker& worker, std::size_t tree) {
+        euchre::rng::Philox4x32 eng(seed, decision);
+        eng.seek(static_cast<uint32_t>(tree));
+        grow_tree(obs, action_mask, constraints, deal_sampler, eng, worker, per_tree[tree]);
+    };
+
+    if (pool) {
+        pool->parallel_for(per_tree.size(), 1, [&](std::size_t worker, std::size_t begin, std::size_t end) {
+            for (std::size_t t = begin; t < end; t++) {
+                run_tree(workers[worker], t);
+            }
+        });
+    }
+    else {
+        for (std::size_t t = 0; t < per_tree.size(); t++) {
+            run_tree(workers[0], t);
+        }
+    }
+
+    last_visits = {};
+    for (const auto& v : per_tree) {
+        for (std::size_t a = 0; a < last_visits.size(); a++) {
+            last_visits[a] += v[a];
+        }
+    }
+
+    // Most visited action; ties go to the lowest action id.
+    ActionId best {static_cast<uint16_t>(std::countr_zero(distinct))};
+    for (ActionMask rest = distinct; rest; rest &= rest - 1) {
+        ActionId action {static_cast<uint16_t>(std::countr_zero(rest))};
+        if (last_visits[action] > last_visits[best]) {
+            best = action;
+        }
+    }
+    return best;
+}
+
+ActionId IsmctsBot::bid_phase_1_action(const Observation& obs, ActionMask action_mask) {
+    return search(obs, action_mask);
+}
+
+ActionId IsmctsBot::bid_phase_2_action(const Observation& obs, ActionMask action_mask) {
+    return search(obs, action_mask);
+}
+
+ActionId IsmctsBot::go_alone_action(const Observation& obs, ActionMask action_mask) {
+    return search(obs, action_mask);
+}
+
+ActionId IsmctsBot::dealer_pickup_discard_action(const Observation& obs, ActionMask action_mask) {
+    return search(obs, action_mask);
+}
+
+ActionId IsmctsBot::play_trick(const Observation& obs, ActionMask action_mask) {
+    return search(obs, action_mask);
+}
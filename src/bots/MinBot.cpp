@@ -28,7 +28,7 @@ ActionId MinBot::dealer_pickup_discard_action(const Observation& obs, [[maybe_un
 }
 
 ActionId MinBot::play_trick(const Observation& obs, ActionMask action_mask) {
-    uint32_t valid_cards = static_cast<uint32_t>(action_mask & 0xFFFFFF);
+    uint32_t valid_cards = euchre::action::play_cards(action_mask);
     Suit led_suit = bot_utils::led_suit_from_obs(obs);
     return euchre::action::play(bot_utils::lowest_card(valid_cards, obs.trump, led_suit));
 }
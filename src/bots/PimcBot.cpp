@@ -0,0 +1,140 @@
+#include "bots/PimcBot.hpp"
+#include "Rules.hpp"
+#include "Tables.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace {
+
+// Each solver keeps its own table; 2^16 entries is 1MB and plenty for one decision.
+constexpr uint32_t solver_tt_bits = 16;
+
+}
+
+PimcBot::PimcBot(std::string name, int samples, std::chrono::microseconds budget, WorkerPool* workers,
+                 const Tablebase* tablebase)
+    : HeuristicBot(std::move(name)), num_samples(samples), time_budget(budget), pool(workers) {
+    std::size_t threads = pool ? pool->size() : 1;
+    solvers.reserve(threads);
+    for (std::size_t w = 0; w < threads; w++) {
+        solvers.emplace_back(solver_tt_bits);
+        solvers.back().set_tablebase(tablebase);
+    }
+    partial.resize(threads);
+}
+
+void PimcBot::on_new_match(uint32_t match_seed) {
+    seed = match_seed;
+    decisions = 0;
+}
+
+void PimcBot::sample_position(const Observation& obs, const DealConstraints& constraints, const DealSampler& sampler,
+                              euchre::rng::Philox4x32& eng, DDPosition& pos) const {
+    pos.hands = sampler.sample(eng);
+    pos.trump = obs.trump;
+    pos.going_alone = obs.going_alone;
+    pos.maker_player = obs.maker_player;
+    pos.lead_player = constraints.lead_player;
+    pos.current_player = obs.player;
+    pos.num_played = obs.num_played;
+    for (uint8_t seat = 0; seat < euchre::constants::num_players; seat++) {
+        if (constraints.trick_seats & (1u << seat)) {
+            pos.trick_cards[seat] = obs.trick_cards[seat];
+        }
+    }
+}
+
+void PimcBot::score_sample(const Observation& obs, const DealConstraints& constraints, const DealSampler& sampler,
+                           uint32_t candidates, uint32_t decision, uint32_t sample, DoubleDummySolver& solver,
+                           Scores& scores) const {
+    euchre::rng::Philox4x32 eng(seed, decision);
+    eng.seek(sample);
+
+    DDPosition pos;
+    sample_position(obs, constraints, sampler, eng, pos);
+
+    uint8_t team = obs.player % 2;
+    if (obs.phase == Phase::DealerPickupDiscard) {
+        uint32_t full = pos.hands[obs.player];
+        pos.lead_player = euchre::rules::next_player(obs.dealer, obs.going_alone, obs.maker_player);
+        pos.current_player = pos.lead_player;
+        for (uint32_t rest = candidates; rest; rest &= rest - 1) {
+            auto c = static_cast<uint8_t>(std::countr_zero(rest));
+            pos.hands[obs.player] = full & ~(1u << c);
+            scores[c] += solver.solve(pos)[team];
+        }
+        return;
+    }
+
+    auto values = solver.solve_moves(pos);
+    for (uint32_t rest = candidates; rest; rest &= rest - 1) {
+        auto c = static_cast<uint8_t>(std::countr_zero(rest));
+        scores[c] += values[c];
+    }
+}
+
+Card PimcBot::search(const Observation& obs, uint32_t candidates) {
+    DealConstraints constraints;
+    bool feasible = deal_sampler.reset_for(obs, constraints);
+    if (std::popcount(candidates) == 1) {
+        return Card{static_cast<uint8_t>(std::countr_zero(candidates))};
+    }
+
+    uint32_t decision = decisions++;
+    if (!feasible) {
+        return Card{static_cast<uint8_t>(std::countr_zero(candidates))};
+    }
+
+    std::fill(partial.begin(), partial.end(), Scores{});
+    auto deadline = std::chrono::steady_clock::now() + time_budget;
+
+    // Without a time budget all samples go out as one batch; with one, check the clock between batches.
+    auto batch = time_budget.count() > 0 ? static_cast<int>(2 * solvers.size()) : num_samples;
+    for (int done = 0; done < num_samples;) {
+        int n = std::min(batch, num_samples - done);
+        auto first = static_cast<uint32_t>(done);
+        if (pool) {
+            pool->parallel_for(static_cast<std::size_t>(n), 1, [&](std::size_t worker, std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; i++) {
+                    score_sample(obs, constraints, deal_sampler, candidates, decision, first + static_cast<uint32_t>(i), solvers[worker], partial[worker]);
+                }
+            });
+        }
+        else {
+            for (int i = 0; i < n; i++) {
+                score_sample(obs, constraints, deal_sampler, candidates, decision, first + static_cast<uint32_t>(i), solvers[0], partial[0]);
+            }
+        }
+        done += n;
+        if (time_budget.count() > 0 && std::chrono::steady_clock::now() >= deadline) {
+            break;
+        }
+    }
+
+    Scores total {};
+    for (const auto& p : partial) {
+        for (std::size_t c = 0; c < total.size(); c++) {
+            total[c] += p[c];
+        }
+    }
+
+    // Ties go to the lowest card so the choice never depends on thread timing.
+    Card best {static_cast<uint8_t>(std::countr_zero(candidates))};
+    for (uint32_t rest = candidates; rest; rest &= rest - 1) {
+        auto c = static_cast<uint8_t>(std::countr_zero(rest));
+        if (total[c] > total[best]) {
+            best = Card{c};
+        }
+    }
+    return best;
+}
+
+ActionId PimcBot::dealer_pickup_discard_action(const Observation& obs, ActionMask action_mask) {
+    auto candidates = static_cast<uint32_t>(action_mask >> euchre::constants::num_cards) & euchre::constants::deck_reset;
+    return euchre::action::discard(search(obs, candidates));
+}
+
+ActionId PimcBot::play_trick(const Observation& obs, ActionMask action_mask) {
+    auto candidates = static_cast<uint32_t>(action_mask & euchre::constants::deck_reset);
+    return euchre::action::play(search(obs, candidates));
+}
@@ -2,50 +2,23 @@
 #include <chrono>
 #include <array>
 #include <cstdint>
+#include <thread>
+#include "Bench.hpp"
 #include "Env.hpp"
+#include "SlicedPlayout.hpp"
 #include "bots/RandomBot.hpp"
 #include "bots/HeuristicBot.hpp"
+#include "bots/IsmctsBot.hpp"
+#include "bots/PimcBot.hpp"
 #include "bots/MinBot.hpp"
 #include "bots/MaxBot.hpp"
 
-struct BenchResult {
-    int team0_wins;
-    int team1_wins;
-    int stalled;
-    double seconds;
-};
-
-BenchResult run_benchmark(std::array<IBot*, 4> players, int num_games, int max_steps) {
-    int team0_wins = 0;
-    int team1_wins = 0;
-    int stalled_games = 0;
-
-    auto start = std::chrono::high_resolution_clock::now();
-
-    for (int g = 0; g < num_games; g++) {
-        Env env{static_cast<unsigned int>(g), players};
-        int steps = 0;
-
-        while (env.state.status != GameState::GameStatus::GameOver && steps < max_steps) {
-            env.step_game();
-            steps++;
-        }
-
-        if (env.state.status != GameState::GameStatus::GameOver) {
-            stalled_games++;
-            continue;
-        }
-
-        if (env.state.scores[0] >= 10) {
-            team0_wins++;
-        } else {
-            team1_wins++;
-        }
-    }
-
-    auto end = std::chrono::high_resolution_clock::now();
-    double elapsed = std::chrono::duration<double>(end - start).count();
-    return {team0_wins, team1_wins, stalled_games, elapsed};
+template <typename T0, typename T1, typename T2, typename T3>
+LineupFactory lineup() {
+    return [] {
+        return Lineup{std::make_unique<T0>("P0"), std::make_unique<T1>("P1"),
+                      std::make_unique<T2>("P2"), std::make_unique<T3>("P3")};
+    };
 }
 
 void print_result(const char* label, BenchResult r, int num_games) {
@@ -65,115 +38,132 @@ void print_result(const char* label, BenchResult r, int num_games) {
     std::cout << '\n';
 }
 
+void print_result(const char* label, const ParallelBenchResult& r, int num_games) {
+    print_result(label, r.total, num_games);
+    for (std::size_t t = 0; t < r.threads.size(); t++) {
+        const ThreadStats& s = r.threads[t];
+        std::cout << "  Thread " << t << ": " << s.games << " games, "
+                  << static_cast<int>(s.busy_seconds > 0 ? s.games / s.busy_seconds : 0) << " games/sec" << '\n';
+    }
+    std::cout << '\n';
+}
+
 int main() {
 
     constexpr int num_games = 100000;
     constexpr int max_steps = 10000;
 
-    std::cout << "=== Euchre Benchmark ===" << '\n' << '\n';
+    WorkerPool pool{std::max(1u, std::thread::hardware_concurrency())};
 
-    // Random vs Random
-    {
-        RandomBot a{"A"}, b{"B"}, c{"C"}, d{"D"};
-        std::array<IBot*, 4> players = {&a, &b, &c, &d};
-        auto r = run_benchmark(players, num_games, max_steps);
-        print_result("Random vs Random", r, num_games);
-    }
+    std::cout << "=== Euchre Benchmark (" << pool.size() << " threads) ===" << '\n' << '\n';
+
+    // Seats are {0, 1, 2, 3}; team 0 is seats 0 and 2.
+    print_result("Random vs Random",
+                 run_parallel_benchmark(pool, lineup<RandomBot, RandomBot, RandomBot, RandomBot>(), num_games, max_steps), num_games);
 
     // Heuristic vs Random (Heuristic = team 0, Random = team 1)
-    {
-        HeuristicBot a{"H0"}, c{"H1"};
-        RandomBot b{"R0"}, d{"R1"};
-        std::array<IBot*, 4> players = {&a, &b, &c, &d};
-        auto r = run_benchmark(players, num_games, max_steps);
-        print_result("Heuristic(T0) vs Random(T1)", r, num_games);
-    }
+    print_result("Heuristic(T0) vs Random(T1)",
+                 run_parallel_benchmark(pool, lineup<HeuristicBot, RandomBot, HeuristicBot, RandomBot>(), num_games, max_steps), num_games);
 
-    // Heuristic vs Heuristic
-    {
-        HeuristicBot a{"H0"}, b{"H1"}, c{"H2"}, d{"H3"};
-        std::array<IBot*, 4> players = {&a, &b, &c, &d};
-        auto r = run_benchmark(players, num_games, max_steps);
-        print_result("Heuristic vs Heuristic", r, num_games);
-    }
+    print_result("Heuristic vs Heuristic",
+                 run_parallel_benchmark(pool, lineup<HeuristicBot, HeuristicBot, HeuristicBot, HeuristicBot>(), num_games, max_steps), num_games);
 
-    // MaxBot vs Random
-    {
-        MaxBot a{"Max0"}, c{"Max1"};
-        RandomBot b{"R0"}, d{"R1"};
-        std::array<IBot*, 4> players = {&a, &b, &c, &d};
-        auto r = run_benchmark(players, num_games, max_steps);
-        print_result("MaxBot(T0) vs Random(T1)", r, num_games);
-    }
+    print_result("MaxBot(T0) vs Random(T1)",
+                 run_parallel_benchmark(pool, lineup<MaxBot, RandomBot, MaxBot, RandomBot>(), num_games, max_steps), num_games);
 
-    // MinBot vs Random
-    {
-        MinBot a{"Min0"}, c{"Min1"};
-        RandomBot b{"R0"}, d{"R1"};
-        std::array<IBot*, 4> players = {&a, &b, &c, &d};
-        auto r = run_benchmark(players, num_games, max_steps);
-        print_result("MinBot(T0) vs Random(T1)", r, num_games);
-    }
+    print_result("MinBot(T0) vs Random(T1)",
+                 run_parallel_benchmark(pool, lineup<MinBot, RandomBot, MinBot, RandomBot>(), num_games, max_steps), num_games);
+
+    print_result("MaxBot(T0) vs Heuristic(T1)",
+                 run_parallel_benchmark(pool, lineup<MaxBot, HeuristicBot, MaxBot, HeuristicBot>(), num_games, max_steps), num_games);
+
+    // --- The same seeds on StaticEnv: bots sealed at their concrete types, no virtual dispatch ---
+
+    std::cout << "=== Devirtualized Env ===" << '\n' << '\n';
+
+    print_result("Static Heuristic vs Heuristic",
+                 run_parallel_static_benchmark<HeuristicBot, HeuristicBot, HeuristicBot, HeuristicBot>(pool, num_games, max_steps), num_games);
+
+    print_result("Static Heuristic(T0) vs Random(T1)",
+                 run_parallel_static_benchmark<HeuristicBot, RandomBot, HeuristicBot, RandomBot>(pool, num_games, max_steps), num_games);
+
+    print_result("Static MaxBot(T0) vs Heuristic(T1)",
+                 run_parallel_static_benchmark<MaxBot, HeuristicBot, MaxBot, HeuristicBot>(pool, num_games, max_steps), num_games);
+
+    // --- Per-decision action checks: the same static lineup at each validation level ---
+
+    std::cout << "=== Validation Levels ===" << '\n' << '\n';
 
-    // MaxBot vs Heuristic
     {
-        MaxBot a{"Max0"}, c{"Max1"};
-        HeuristicBot b{"H0"}, d{"H1"};
-        std::array<IBot*, 4> players = {&a, &b, &c, &d};
-        auto r = run_benchmark(players, num_games, max_steps);
-        print_result("MaxBot(T0) vs Heuristic(T1)", r, num_games);
+        using namespace euchre::validation;
+        using euchre::rules::RuleSet;
+        auto full_run = run_parallel_static_benchmark<MaxBot, MinBot, MaxBot, MinBot, RuleSet{}, full>(pool, num_games, max_steps);
+        print_result("Full: MaxBot(T0) vs MinBot(T1)", full_run, num_games);
+        auto debug_run = run_parallel_static_benchmark<MaxBot, MinBot, MaxBot, MinBot, RuleSet{}, debug>(pool, num_games, max_steps);
+        print_result("Debug: MaxBot(T0) vs MinBot(T1)", debug_run, num_games);
+        auto audited_run = run_parallel_static_benchmark<MaxBot, MinBot, MaxBot, MinBot, RuleSet{}, audited(64)>(pool, num_games, max_steps);
+        print_result("Trusted, auditing 1 in 64: MaxBot(T0) vs MinBot(T1)", audited_run, num_games);
+        auto trusted_run = run_parallel_static_benchmark<MaxBot, MinBot, MaxBot, MinBot, RuleSet{}, trusted>(pool, num_games, max_steps);
+        print_result("Trusted: MaxBot(T0) vs MinBot(T1)", trusted_run, num_games);
+
+        auto overhead = [&](const ParallelBenchResult& r) {
+            return 100.0 * (r.total.seconds / trusted_run.total.seconds - 1.0);
+        };
+        std::cout << "Overhead vs trusted: full " << overhead(full_run) << "%, debug " << overhead(debug_run)
+                  << "%, audited " << overhead(audited_run) << "%" << '\n' << '\n';
     }
 
+    // --- The same lineups on the bit-sliced engine: 64 games per word ---
+
+    std::cout << "=== Bit-Sliced Engine ===" << '\n' << '\n';
+
+    using enum SlicedPolicy;
+    print_result("Sliced Random vs Random",
+                 run_parallel_sliced_benchmark(pool, {Random, Random, Random, Random}, num_games, max_steps), num_games);
+
+    print_result("Sliced MaxBot(T0) vs Random(T1)",
+                 run_parallel_sliced_benchmark(pool, {Max, Random, Max, Random}, num_games, max_steps), num_games);
+
+    print_result("Sliced MinBot(T0) vs Random(T1)",
+                 run_parallel_sliced_benchmark(pool, {Min, Random, Min, Random}, num_games, max_steps), num_games);
+
+    print_result("Sliced MaxBot(T0) vs MinBot(T1)",
+                 run_parallel_sliced_benchmark(pool, {Max, Min, Max, Min}, num_games, max_steps), num_games);
+
     // --- Weak link benchmarks: effect of one Random teammate ---
 
     std::cout << "=== Weak Link: One Random Teammate ===" << '\n' << '\n';
 
     // Baseline: Heuristic vs Heuristic (already above, repeated for grouping)
-    {
-        HeuristicBot a{"H0"}, b{"H1"}, c{"H2"}, d{"H3"};
-        std::array<IBot*, 4> players = {&a, &b, &c, &d};
-        auto r = run_benchmark(players, num_games, max_steps);
-        print_result("Baseline: HH vs HH", r, num_games);
-    }
+    print_result("Baseline: HH vs HH",
+                 run_parallel_benchmark(pool, lineup<HeuristicBot, HeuristicBot, HeuristicBot, HeuristicBot>(), num_games, max_steps), num_games);
 
     // Team 0 has one Random partner: H+R vs H+H
-    {
-        HeuristicBot a{"H0"};
-        RandomBot c{"R0"};       // Team 0's weak link
-        HeuristicBot b{"H1"}, d{"H2"};
-        std::array<IBot*, 4> players = {&a, &b, &c, &d};
-        auto r = run_benchmark(players, num_games, max_steps);
-        print_result("H+Random(T0) vs HH(T1)", r, num_games);
-    }
+    print_result("H+Random(T0) vs HH(T1)",
+                 run_parallel_benchmark(pool, lineup<HeuristicBot, HeuristicBot, RandomBot, HeuristicBot>(), num_games, max_steps), num_games);
 
     // Both teams have one Random partner: H+R vs H+R
-    {
-        HeuristicBot a{"H0"}, b{"H1"};
-        RandomBot c{"R0"}, d{"R1"};  // Both teams' weak links
-        std::array<IBot*, 4> players = {&a, &b, &c, &d};
-        auto r = run_benchmark(players, num_games, max_steps);
-        print_result("H+Random(T0) vs H+Random(T1)", r, num_games);
-    }
+    print_result("H+Random(T0) vs H+Random(T1)",
+                 run_parallel_benchmark(pool, lineup<HeuristicBot, HeuristicBot, RandomBot, RandomBot>(), num_games, max_steps), num_games);
 
     // Team 0 has one MaxBot partner instead: H+Max vs H+H
-    {
-        HeuristicBot a{"H0"};
-        MaxBot c{"Max0"};        // Team 0's weaker partner
-        HeuristicBot b{"H1"}, d{"H2"};
-        std::array<IBot*, 4> players = {&a, &b, &c, &d};
-        auto r = run_benchmark(players, num_games, max_steps);
-        print_result("H+MaxBot(T0) vs HH(T1)", r, num_games);
-    }
+    print_result("H+MaxBot(T0) vs HH(T1)",
+                 run_parallel_benchmark(pool, lineup<HeuristicBot, HeuristicBot, MaxBot, HeuristicBot>(), num_games, max_steps), num_games);
 
     // Team 0 has one MinBot partner: H+Min vs H+H
-    {
-        HeuristicBot a{"H0"};
-        MinBot c{"Min0"};        // Team 0's weaker partner
-        HeuristicBot b{"H1"}, d{"H2"};
-        std::array<IBot*, 4> players = {&a, &b, &c, &d};
-        auto r = run_benchmark(players, num_games, max_steps);
-        print_result("H+MinBot(T0) vs HH(T1)", r, num_games);
-    }
+    print_result("H+MinBot(T0) vs HH(T1)",
+                 run_parallel_benchmark(pool, lineup<HeuristicBot, HeuristicBot, MinBot, HeuristicBot>(), num_games, max_steps), num_games);
+
+    // --- Search bots: far slower per decision, so fewer games ---
+
+    std::cout << "=== Search Bots ===" << '\n' << '\n';
+
+    constexpr int search_games = 1000;
+    print_result("Pimc(T0) vs Heuristic(T1)",
+                 run_parallel_benchmark(pool, lineup<PimcBot, HeuristicBot, PimcBot, HeuristicBot>(), search_games, max_steps), search_games);
+
+    print_result("Ismcts(T0) vs Heuristic(T1)",
+                 run_parallel_benchmark(pool, lineup<IsmctsBot, HeuristicBot, IsmctsBot, HeuristicBot>(), search_games, max_steps), search_games);
 
     return 0;
 }
@@ -0,0 +1,158 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Bench.hpp"
+#include "Env.hpp"
+#include "Tables.hpp"
+#include "WorkerPool.hpp"
+#include "bots/HeuristicBot.hpp"
+#include "bots/IsmctsBot.hpp"
+#include "bots/MaxBot.hpp"
+#include "bots/MinBot.hpp"
+#include "bots/PimcBot.hpp"
+#include "bots/RandomBot.hpp"
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+// Every heap allocation in this binary goes through here, which is why these tests are a target of
+// their own: the replacement would otherwise count Catch2 and every other test. All the plain forms
+// are replaced so that each allocation is freed by its own family; the aligned ones are not used.
+namespace {
+
+std::atomic<uint64_t> allocations {0};
+
+void* counted_alloc(std::size_t size) noexcept {
+    allocations.fetch_add(1, std::memory_order_relaxed);
+    return std::malloc(size == 0 ? 1 : size);
+}
+
+void* checked_alloc(std::size_t size) {
+    if (void* p = counted_alloc(size)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+}
+
+void* operator new(std::size_t size) {
+    return checked_alloc(size);
+}
+
+void* operator new[](std::size_t size) {
+    return checked_alloc(size);
+}
+
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept {
+    return counted_alloc(size);
+}
+
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept {
+    return counted_alloc(size);
+}
+
+void operator delete(void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, std::size_t) noexcept {
+    std::free(p);
+}
+
+void operator delete(void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+void operator delete[](void* p, const std::nothrow_t&) noexcept {
+    std::free(p);
+}
+
+namespace {
+
+using euchre::rules::RuleSet;
+
+constexpr int warm_up_games = 10;
+constexpr int max_steps = 10000;
+
+/**
+ * @brief Allocations made playing games first .. last - 1, after warm-up games on the same bots.
+ *
+ * The warm-up lets one-off storage (a bot's first search, lazily built tables) settle before counting.
+ */
+template <typename EnvType>
+uint64_t steady_state_allocations(const typename EnvType::Players& players, int num_games, BenchResult& result) {
+    BenchResult warm_up {};
+    play_env_games<EnvType>(players, 0, warm_up_games, max_steps, warm_up);
+
+    uint64_t before = allocations.load();
+    play_env_games<EnvType>(players, warm_up_games, warm_up_games + num_games, max_steps, result);
+    return allocations.load() - before;
+}
+
+}
+
+TEST_CASE("Counting allocator sees allocations", "[alloc]") {
+    uint64_t before = allocations.load();
+    auto* p = new int(1);
+    delete p;
+    REQUIRE(allocations.load() - before == 1);
+}
+
+TEST_CASE("Game loop does not allocate", "[alloc]") {
+    constexpr int num_games = 10000;
+
+    HeuristicBot h0{"H0"};
+    MinBot n1{"N1"};
+    RandomBot r2{"R2"};
+    MaxBot x3{"X3"};
+
+    BenchResult result {};
+    REQUIRE(steady_state_allocations<Env>({&h0, &n1, &r2, &x3}, num_games, result) == 0);
+    REQUIRE(result.team0_wins + result.team1_wins == num_games);
+}
+
+TEST_CASE("Sealed and variant game loops do not allocate", "[alloc]") {
+    constexpr int num_games = 1000;
+    constexpr RuleSet all_variants {.deck = euchre::tables::joker_deck, .defend_alone = true, .farmers_hand = true};
+
+    StaticBot<HeuristicBot> sh0{"H0"}, sh2{"H2"};
+    StaticBot<RandomBot> sr1{"R1"}, sr3{"R3"};
+    BenchResult sealed {};
+    REQUIRE(steady_state_allocations<StaticEnv<HeuristicBot, RandomBot, HeuristicBot, RandomBot>>(
+                {&sh0, &sr1, &sh2, &sr3}, num_games, sealed) == 0);
+    REQUIRE(sealed.stalled == 0);
+
+    HeuristicBot h0{"H0"}, h2{"H2"};
+    RandomBot r1{"R1"}, r3{"R3"};
+    BenchResult variant {};
+    REQUIRE(steady_state_allocations<BasicEnv<IBot, IBot, IBot, IBot, all_variants, euchre::validation::trusted>>(
+                {&h0, &r1, &h2, &r3}, num_games, variant) == 0);
+    REQUIRE(variant.stalled == 0);
+}
+
+TEST_CASE("Search bots do not allocate per decision", "[alloc]") {
+    constexpr int num_games = 4;
+
+    RandomBot r1{"R1"}, r3{"R3"};
+    BenchResult result {};
+
+    SECTION("Serial") {
+        PimcBot p0{"P0", 4};
+        IsmctsBot i2{"I2", 64};
+        REQUIRE(steady_state_allocations<Env>({&p0, &r1, &i2, &r3}, num_games, result) == 0);
+    }
+
+    SECTION("Pooled") {
+        WorkerPool workers{2};
+        PimcBot p0{"P0", 4, {}, &workers};
+        IsmctsBot i2{"I2", 64, 2, {}, &workers};
+        REQUIRE(steady_state_allocations<Env>({&p0, &r1, &i2, &r3}, num_games, result) == 0);
+    }
+}
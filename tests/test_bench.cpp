@@ -0,0 +1,171 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Bench.hpp"
+#include "WorkerPool.hpp"
+#include "bots/HeuristicBot.hpp"
+#include "bots/MaxBot.hpp"
+#include "bots/MinBot.hpp"
+#include "bots/RandomBot.hpp"
+#include <atomic>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+namespace {
+    Lineup heuristic_vs_random() {
+        return Lineup{std::make_unique<HeuristicBot>("H0"), std::make_unique<RandomBot>("R0"),
+                      std::make_unique<HeuristicBot>("H1"), std::make_unique<RandomBot>("R1")};
+    }
+}
+
+TEST_CASE("WorkerPool visits every index exactly once", "[parallel]") {
+    WorkerPool pool{4};
+    constexpr std::size_t n = 10007;
+    std::vector<std::atomic<int>> visits(n);
+
+    for (std::size_t grain : {std::size_t{1}, std::size_t{7}, std::size_t{256}}) {
+        for (auto& v : visits) {
+            v = 0;
+        }
+        pool.parallel_for(n, grain, [&](std::size_t, std::size_t begin, std::size_t end) {
+            for (std::size_t i = begin; i < end; i++) {
+                visits[i]++;
+            }
+        });
+        for (auto& v : visits) {
+            REQUIRE(v == 1);
+        }
+    }
+}
+
+TEST_CASE("WorkerPool rethrows worker exceptions", "[parallel]") {
+    WorkerPool pool{3};
+    REQUIRE_THROWS_AS(pool.parallel_for(100, 1, [](std::size_t, std::size_t begin, std::size_t) {
+        if (begin == 42) {
+            throw std::runtime_error("boom");
+        }
+    }), std::runtime_error);
+
+    // The pool is still usable afterwards.
+    std::atomic<int> count = 0;
+    pool.parallel_for(10, 1, [&](std::size_t, std::size_t begin, std::size_t end) {
+        count += static_cast<int>(end - begin);
+    });
+    REQUIRE(count == 10);
+}
+
+TEST_CASE("WorkerPool serializes concurrent callers", "[parallel]") {
+    WorkerPool pool{3};
+    constexpr std::size_t n = 5003;
+    std::vector<std::atomic<int>> visits(2 * n);
+
+    // Two threads share the pool, each running loops over its own half of visits.
+    auto run = [&](std::size_t offset) {
+        for (int rep = 0; rep < 20; rep++) {
+            pool.parallel_for(n, 3, [&](std::size_t, std::size_t begin, std::size_t end) {
+                for (std::size_t i = begin; i < end; i++) {
+                    visits[offset + i]++;
+                }
+            });
+        }
+    };
+    std::thread other(run, n);
+    run(0);
+    other.join();
+
+    for (auto& v : visits) {
+        REQUIRE(v == 20);
+    }
+}
+
+TEST_CASE("WorkerPool rejects calls from its own workers", "[parallel]") {
+    WorkerPool pool{2};
+    WorkerPool other{1};
+    std::atomic<int> inner = 0;
+    REQUIRE_THROWS_AS(pool.parallel_for(4, 1, [&](std::size_t, std::size_t, std::size_t) {
+        // Another pool is fine; this one would deadlock.
+        other.parallel_for(1, 1, [&](std::size_t, std::size_t, std::size_t) { inner++; });
+        pool.parallel_for(1, 1, [](std::size_t, std::size_t, std::size_t) {});
+    }), std::logic_error);
+    REQUIRE(inner == 4);
+}
+
+TEST_CASE("Parallel benchmark is independent of thread count", "[parallel]") {
+    constexpr int num_games = 300;
+    constexpr int max_steps = 10000;
+
+    Lineup serial = heuristic_vs_random();
+    BenchResult expected = run_benchmark({serial[0].get(), serial[1].get(), serial[2].get(), serial[3].get()},
+                                         num_games, max_steps);
+    REQUIRE(expected.team0_wins + expected.team1_wins + expected.stalled == num_games);
+
+    for (std::size_t threads : {std::size_t{1}, std::size_t{2}, std::size_t{5}}) {
+        WorkerPool pool{threads};
+        ParallelBenchResult r = run_parallel_benchmark(pool, heuristic_vs_random, num_games, max_steps);
+
+        REQUIRE(r.total.team0_wins == expected.team0_wins);
+        REQUIRE(r.total.team1_wins == expected.team1_wins);
+        REQUIRE(r.total.stalled == expected.stalled);
+        REQUIRE(r.threads.size() == threads);
+
+        int games = 0;
+        for (const auto& t : r.threads) {
+            games += t.games;
+        }
+        REQUIRE(games == num_games);
+    }
+}
+
+TEST_CASE("StaticEnv plays the same games as Env", "[parallel]") {
+    static_assert(SeatType<IBot> && SeatType<StaticBot<HeuristicBot>>);
+    static_assert(!SeatType<HeuristicBot>, "an open bot type could hide an override");
+
+    constexpr int num_games = 200;
+    constexpr int max_steps = 10000;
+
+    HeuristicBot h0{"H0"}, h2{"H2"};
+    RandomBot r1{"R1"}, r3{"R3"};
+    StaticBot<HeuristicBot> sh0{"H0"}, sh2{"H2"};
+    StaticBot<RandomBot> sr1{"R1"}, sr3{"R3"};
+
+    // Step for step: every snapshot matches, RandomBot's own select_action included.
+    for (unsigned int seed : {3u, 11u}) {
+        for (uint8_t seat = 0; seat < euchre::constants::num_players; seat++) {
+            std::array<IBot*, 4>{&h0, &r1, &h2, &r3}[seat]->on_new_match(seed * 4 + seat);
+            std::array<IBot*, 4>{&sh0, &sr1, &sh2, &sr3}[seat]->on_new_match(seed * 4 + seat);
+        }
+        Env dynamic{seed, {&h0, &r1, &h2, &r3}};
+        StaticEnv<HeuristicBot, RandomBot, HeuristicBot, RandomBot> sealed{seed, {&sh0, &sr1, &sh2, &sr3}};
+        while (dynamic.state.status != GameState::GameStatus::GameOver) {
+            dynamic.step_game();
+            sealed.step_game();
+            REQUIRE(sealed.snapshot() == dynamic.snapshot());
+        }
+        REQUIRE(sealed.state.status == GameState::GameStatus::GameOver);
+    }
+
+    BenchResult expected = run_benchmark({&h0, &r1, &h2, &r3}, num_games, max_steps);
+    BenchResult sealed = run_env_benchmark<StaticEnv<HeuristicBot, RandomBot, HeuristicBot, RandomBot>>(
+        {&sh0, &sr1, &sh2, &sr3}, num_games, max_steps);
+    REQUIRE(sealed.team0_wins == expected.team0_wins);
+    REQUIRE(sealed.team1_wins == expected.team1_wins);
+    REQUIRE(sealed.stalled == expected.stalled);
+
+    // Seats can mix virtual and sealed bots.
+    MaxBot max0{"M0"};
+    StaticBot<MinBot> min1{"m1"}, min3{"m3"};
+    expected = run_benchmark({&max0, &min1, &h2, &min3}, num_games, 40);
+    BenchResult mixed = run_env_benchmark<BasicEnv<IBot, StaticBot<MinBot>, IBot, StaticBot<MinBot>>>(
+        {&max0, &min1, &h2, &min3}, num_games, 40);
+    REQUIRE(mixed.team0_wins == expected.team0_wins);
+    REQUIRE(mixed.team1_wins == expected.team1_wins);
+    REQUIRE(mixed.stalled == expected.stalled);
+
+    WorkerPool pool{3};
+    ParallelBenchResult dynamic = run_parallel_benchmark(pool, heuristic_vs_random, num_games, max_steps);
+    ParallelBenchResult parallel =
+        run_parallel_static_benchmark<HeuristicBot, RandomBot, HeuristicBot, RandomBot>(pool, num_games, max_steps);
+    REQUIRE(parallel.total.team0_wins == dynamic.total.team0_wins);
+    REQUIRE(parallel.total.team1_wins == dynamic.total.team1_wins);
+    REQUIRE(parallel.total.stalled == dynamic.total.stalled);
+    REQUIRE(parallel.threads.size() == 3);
+}
@@ -0,0 +1,93 @@
+#include <catch2/catch_test_macros.hpp>
+#include "CoEnv.hpp"
+#include "Env.hpp"
+#include "bots/HeuristicBot.hpp"
+#include "bots/MinBot.hpp"
+
+namespace {
+    std::array<uint8_t, 2> play_env(unsigned int seed, std::array<IBot*, 4> players) {
+        Env env{seed, players};
+        while (env.state.status != GameState::GameStatus::GameOver) {
+            env.step_game();
+        }
+        return {env.state.scores[0], env.state.scores[1]};
+    }
+}
+
+TEST_CASE("CoEnv suspends at the first decision", "[coroutine]") {
+    CoEnv env{7};
+    REQUIRE_FALSE(env.done());
+    REQUIRE(env.state.hand_state.phase == Phase::BidRound1);
+    REQUIRE(env.pending_player == 1);
+    REQUIRE(env.pending_mask == euchre::action::make_mask(euchre::action::Pass, euchre::action::OrderUp));
+    REQUIRE_THROWS_AS(env.resume(euchre::action::GoAloneYes), std::invalid_argument);
+    // Id 113 would wrap onto OrderUp's bit without the range check.
+    REQUIRE_THROWS_AS(env.resume(ActionId{113}), std::invalid_argument);
+    REQUIRE(env.state.hand_state.phase == Phase::BidRound1);
+    REQUIRE(env.pending_player == 1);
+}
+
+TEST_CASE("CoEnv matches Env game for game", "[coroutine]") {
+    HeuristicBot h0{"H0"}, h2{"H2"};
+    MinBot m1{"M1"}, m3{"M3"};
+    std::array<IBot*, 4> players = {&h0, &m1, &h2, &m3};
+
+    for (unsigned int seed = 0; seed < 50; seed++) {
+        CoEnv env{seed};
+        while (!env.done()) {
+            Observation obs = env.observation();
+            env.resume(players[env.pending_player]->select_action(obs, env.pending_mask));
+        }
+        auto expected = play_env(seed, players);
+        REQUIRE(env.state.scores[0] == expected[0]);
+        REQUIRE(env.state.scores[1] == expected[1]);
+    }
+}
+
+TEST_CASE("CoScheduler answers interleaved games in batches", "[coroutine]") {
+    HeuristicBot h0{"H0"}, h1{"H1"}, h2{"H2"}, h3{"H3"};
+    std::array<IBot*, 4> players = {&h0, &h1, &h2, &h3};
+    auto policy = [&](std::span<const Observation> obs, std::span<const ActionMask> masks, std::span<ActionId> out) {
+        for (std::size_t i = 0; i < obs.size(); i++) {
+            out[i] = players[obs[i].player]->select_action(obs[i], masks[i]);
+        }
+    };
+
+    constexpr std::size_t num_games = 40;
+    CoScheduler scheduler{num_games, 100};
+    std::size_t calls = scheduler.run(policy);
+    REQUIRE(calls > 0);
+
+    for (std::size_t g = 0; g < num_games; g++) {
+        REQUIRE(scheduler.games[g]->done());
+        auto expected = play_env(static_cast<unsigned int>(100 + g), players);
+        REQUIRE(scheduler.games[g]->state.scores[0] == expected[0]);
+        REQUIRE(scheduler.games[g]->state.scores[1] == expected[1]);
+    }
+}
+
+TEST_CASE("CoEnv frames are recycled by the pool", "[coroutine]") {
+    MinBot m0{"M0"}, m1{"M1"}, m2{"M2"}, m3{"M3"};
+    std::array<IBot*, 4> players = {&m0, &m1, &m2, &m3};
+    auto policy = [&](std::span<const Observation> obs, std::span<const ActionMask> masks, std::span<ActionId> out) {
+        for (std::size_t i = 0; i < obs.size(); i++) {
+            out[i] = players[obs[i].player]->select_action(obs[i], masks[i]);
+        }
+    };
+
+    FramePool& pool = FramePool::local();
+    std::size_t frames_before = pool.frames_in_use();
+    {
+        CoScheduler warm_up{64, 0};
+        warm_up.run(policy);
+    }
+    REQUIRE(pool.frames_in_use() == frames_before);
+
+    std::size_t chunks = pool.chunks_allocated();
+    {
+        CoScheduler scheduler{64, 1000};
+        scheduler.run(policy);
+    }
+    REQUIRE(pool.chunks_allocated() == chunks);
+    REQUIRE(pool.frames_in_use() == frames_before);
+}
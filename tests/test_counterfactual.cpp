@@ -0,0 +1,80 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Counterfactual.hpp"
+#include "Env.hpp"
+#include "bots/HeuristicBot.hpp"
+#include "bots/RandomBot.hpp"
+#include <bit>
+
+struct CounterfactualFixture {
+    HeuristicBot h0{"H0"}, h1{"H1"}, h2{"H2"}, h3{"H3"};
+    std::array<IBot*, 4> players = {&h0, &h1, &h2, &h3};
+    Env env{0x1234, players};
+};
+
+TEST_CASE_METHOD(CounterfactualFixture, "Fork is independent of its parent", "[counterfactual]") {
+    GameSnapshot before = env.snapshot();
+    Env branch = env.fork(players);
+    while (auto decision = branch.next_decision()) {
+        branch.apply(players[decision->player]->select_action(decision->obs, decision->mask));
+    }
+    REQUIRE(branch.state.status == GameState::GameStatus::GameOver);
+    REQUIRE(env.snapshot() == before);
+}
+
+TEST_CASE_METHOD(CounterfactualFixture, "Restore rewinds to a decision", "[counterfactual]") {
+    auto first = env.next_decision();
+    GameSnapshot snap = env.snapshot();
+    env.apply(euchre::action::OrderUp);
+    env.restore(snap);
+    auto again = env.next_decision();
+    REQUIRE(again->player == first->player);
+    REQUIRE(again->mask == first->mask);
+    REQUIRE(again->obs.hand.value() == first->obs.hand.value());
+}
+
+TEST_CASE_METHOD(CounterfactualFixture, "Counterfactual values match manual rollouts", "[counterfactual]") {
+    // Move into trick play so the branches differ by the card played.
+    for (int i = 0; i < 12; i++) {
+        auto decision = env.next_decision();
+        env.apply(players[decision->player]->select_action(decision->obs, decision->mask));
+    }
+    GameSnapshot before = env.snapshot();
+
+    CounterfactualValues cf = counterfactual_values(env, players, 1);
+    REQUIRE(env.snapshot() == before);
+    REQUIRE(cf.mask != 0);
+
+    uint8_t team = cf.player % 2;
+    for (ActionMask rest = cf.mask; rest; rest &= rest - 1) {
+        ActionId action{static_cast<uint16_t>(std::countr_zero(rest))};
+        Env branch = env.fork(players);
+        uint32_t hand = branch.next_decision() ? branch.state.hands_dealt : 0;
+        uint8_t start[2] = {branch.state.scores[0], branch.state.scores[1]};
+        branch.apply(action);
+        while (branch.state.hands_dealt == hand) {
+            auto decision = branch.next_decision();
+            if (!decision) {
+                break;
+            }
+            branch.apply(players[decision->player]->select_action(decision->obs, decision->mask));
+        }
+        int margin = (branch.state.scores[team] - start[team]) - (branch.state.scores[team ^ 1] - start[team ^ 1]);
+        REQUIRE(cf.value[action] == static_cast<double>(margin));
+    }
+}
+
+TEST_CASE("Counterfactual values are reproducible with a random policy", "[counterfactual]") {
+    RandomBot r0{"R0"}, r1{"R1"}, r2{"R2"}, r3{"R3"};
+    std::array<IBot*, 4> policy = {&r0, &r1, &r2, &r3};
+    Env env{99, policy};
+
+    CounterfactualValues a = counterfactual_values(env, policy, 16, RolloutHorizon::Game);
+    CounterfactualValues b = counterfactual_values(env, policy, 16, RolloutHorizon::Game);
+    REQUIRE(a.mask == euchre::action::make_mask(euchre::action::Pass, euchre::action::OrderUp));
+    REQUIRE(a.value == b.value);
+    for (uint16_t action = 0; action < euchre::action::num_actions; action++) {
+        if ((a.mask & euchre::action::a2m(ActionId{action})) == 0) {
+            REQUIRE(a.value[action] == 0.0);
+        }
+    }
+}
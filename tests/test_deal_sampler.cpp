@@ -0,0 +1,243 @@
+#include <catch2/catch_test_macros.hpp>
+#include "DealSampler.hpp"
+#include "Env.hpp"
+#include "bots/HeuristicBot.hpp"
+#include <bit>
+#include <map>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Seat 0 holds five known cards; seats 1-3 need two each of seven unseen cards, one is buried.
+ */
+DealConstraints small_constraints() {
+    DealConstraints c;
+    c.me = 0;
+    c.fixed[0] = 0b11111;
+    c.unseen = 0b1111111u << 5;
+    c.need = {0, 2, 2, 2};
+    c.allowed.fill(euchre::constants::deck_reset);
+    // Seat 1 is void in two of the cards, seat 3 in another.
+    c.allowed[1] &= ~(0b11u << 5);
+    c.allowed[3] &= ~(1u << 11);
+    return c;
+}
+
+/**
+ * @brief Every deal allowed by c, by brute force over where each unseen card goes.
+ */
+std::vector<std::array<uint32_t, 4>> enumerate(const DealConstraints& c) {
+    std::vector<uint8_t> cards;
+    for (uint32_t rest = c.unseen; rest; rest &= rest - 1) {
+        cards.push_back(static_cast<uint8_t>(std::countr_zero(rest)));
+    }
+
+    std::vector<std::array<uint32_t, 4>> deals;
+    std::size_t total = 1;
+    for (std::size_t i = 0; i < cards.size(); i++) {
+        total *= 4;
+    }
+    for (std::size_t code = 0; code < total; code++) {
+        std::array<uint32_t, 4> hands = c.fixed;
+        bool ok = true;
+        std::size_t rest = code;
+        for (uint8_t card : cards) {
+            // Place 0 is buried; otherwise the seat after me.
+            std::size_t place = rest % 4;
+            rest /= 4;
+            if (place == 0) {
+                continue;
+            }
+            auto seat = static_cast<uint8_t>((c.me + place) % 4);
+            if ((c.allowed[seat] & (1u << card)) == 0) {
+                ok = false;
+                break;
+            }
+            hands[seat] |= 1u << card;
+        }
+        for (uint8_t seat = 0; ok && seat < 4; seat++) {
+            if (seat != c.me && std::popcount(hands[seat] & c.unseen) != c.need[seat]) {
+                ok = false;
+            }
+        }
+        if (ok) {
+            deals.push_back(hands);
+        }
+    }
+    return deals;
+}
+
+/**
+ * @brief Whether the deal in play is one of those c allows.
+ */
+bool allows_real_deal(const DealConstraints& c, const HandState& hs) {
+    for (uint8_t seat = 0; seat < 4; seat++) {
+        if (seat == c.me || c.need[seat] + c.fixed[seat] == 0) {
+            continue;
+        }
+        uint32_t held = hs.hands[seat].value();
+        if ((held & ~(c.unseen | c.fixed[seat])) != 0 || (held & c.unseen & ~c.allowed[seat]) != 0 ||
+            std::popcount(held) != c.need[seat] + std::popcount(c.fixed[seat])) {
+            return false;
+        }
+    }
+    return true;
+}
+
+}
+
+TEST_CASE("DealSampler - count matches enumeration", "[deal_sampler]") {
+    DealConstraints c = small_constraints();
+    REQUIRE(DealSampler(c).count() == enumerate(c).size());
+    REQUIRE(DealSampler(c.without_voids()).count() == enumerate(c.without_voids()).size());
+    // Seven cards, two each to three seats and one buried.
+    REQUIRE(DealSampler(c.without_voids()).count() == 630);
+}
+
+TEST_CASE("DealSampler - samples are uniform over consistent deals", "[deal_sampler]") {
+    DealConstraints c = small_constraints();
+    DealSampler sampler(c);
+    auto deals = enumerate(c);
+    std::map<std::array<uint32_t, 4>, int> counts;
+    for (const auto& d : deals) {
+        counts[d] = 0;
+    }
+
+    constexpr int per_deal = 400;
+    int n = static_cast<int>(deals.size()) * per_deal;
+    euchre::rng::Philox4x32 eng(7, 0);
+    for (int i = 0; i < n; i++) {
+        auto hands = sampler.sample(eng);
+        auto it = counts.find(hands);
+        REQUIRE(it != counts.end());
+        it->second++;
+    }
+
+    // Chi-square with hundreds of degrees of freedom sits near its mean; allow a wide margin.
+    double chi2 = 0;
+    for (const auto& [deal, seen] : counts) {
+        double diff = seen - per_deal;
+        chi2 += diff * diff / per_deal;
+    }
+    REQUIRE(chi2 < 1.5 * static_cast<double>(deals.size()));
+}
+
+TEST_CASE("DealSampler - contradictory constraints have no deals", "[deal_sampler]") {
+    DealConstraints c = small_constraints();
+    // Nobody but seat 1 may hold the seven unseen cards, and it only takes two.
+    c.allowed[2] &= ~c.unseen;
+    c.allowed[3] &= ~c.unseen;
+    DealSampler sampler(c);
+    REQUIRE_FALSE(sampler.feasible());
+    euchre::rng::Philox4x32 eng(1, 0);
+    REQUIRE(sampler.sample(eng) == c.fixed);
+}
+
+TEST_CASE("DealSampler - batch matches repeated samples", "[deal_sampler]") {
+    DealSampler sampler(small_constraints());
+    std::vector<std::array<uint32_t, 4>> batch(1000);
+    euchre::rng::Philox4x32 a(3, 9), b(3, 9);
+    sampler.sample_batch(a, batch);
+    for (const auto& hands : batch) {
+        REQUIRE(hands == sampler.sample(b));
+    }
+}
+
+TEST_CASE("DealSampler - observations from real games", "[deal_sampler]") {
+    HeuristicBot bots[4] = {HeuristicBot{"H0"}, HeuristicBot{"H1"}, HeuristicBot{"H2"}, HeuristicBot{"H3"}};
+    Env env{11, {&bots[0], &bots[1], &bots[2], &bots[3]}};
+    euchre::rng::Philox4x32 eng(5, 0);
+    int checked = 0;
+
+    while (auto decision = env.next_decision()) {
+        const Observation& obs = decision->obs;
+        auto c = DealConstraints::from_observation(obs);
+        DealSampler sampler(c);
+        REQUIRE(sampler.feasible());
+
+        // The real deal is one of the consistent ones.
+        REQUIRE(allows_real_deal(c, env.state.hand_state));
+
+        for (int i = 0; i < 8; i++) {
+            auto hands = sampler.sample(eng);
+            uint32_t all = 0;
+            for (uint8_t seat = 0; seat < 4; seat++) {
+                REQUIRE((all & hands[seat]) == 0);
+                all |= hands[seat];
+                REQUIRE((hands[seat] & c.fixed[seat]) == c.fixed[seat]);
+                REQUIRE((hands[seat] & ~c.fixed[seat] & ~c.allowed[seat]) == 0);
+                REQUIRE(std::popcount(hands[seat] & ~c.fixed[seat]) == c.need[seat]);
+            }
+            REQUIRE(hands[c.me] == obs.hand.value());
+            REQUIRE((all & obs.played & ~obs.hand.value()) == 0);
+        }
+        checked++;
+        env.apply(bots[decision->player].select_action(obs, decision->mask));
+    }
+    REQUIRE(checked > 100);
+}
+
+TEST_CASE("DealSampler - dealer may keep the card picked up after a round 2 call", "[deal_sampler]") {
+    HeuristicBot bots[4] = {HeuristicBot{"H0"}, HeuristicBot{"H1"}, HeuristicBot{"H2"}, HeuristicBot{"H3"}};
+    euchre::rng::Philox4x32 eng(7, 0);
+    int kept = 0;
+
+    for (unsigned int seed = 0; seed < 20; seed++) {
+        Env env{seed, {&bots[0], &bots[1], &bots[2], &bots[3]}};
+        while (auto decision = env.next_decision()) {
+            const Observation& obs = decision->obs;
+            const HandState& hs = env.state.hand_state;
+            if (obs.phase == Phase::PlayTrick && obs.face_up_card.get_suit() != obs.trump) {
+                auto c = DealConstraints::from_observation(obs);
+                REQUIRE(DealSampler(c).feasible());
+                REQUIRE(allows_real_deal(c, hs));
+
+                // Dropping the voids still leaves the picked up card to the dealer alone.
+                auto relaxed = c.without_voids();
+                DealSampler loose(relaxed);
+                REQUIRE(loose.feasible());
+                REQUIRE(allows_real_deal(relaxed, hs));
+                uint32_t face_up = 1u << obs.face_up_card;
+                for (int i = 0; i < 8; i++) {
+                    auto hands = loose.sample(eng);
+                    for (uint8_t seat = 0; seat < 4; seat++) {
+                        if (seat != obs.dealer) {
+                            REQUIRE((hands[seat] & face_up) == 0);
+                        }
+                    }
+                }
+                if (obs.dealer != obs.player && hs.hands[obs.dealer].hand_has(obs.face_up_card)) {
+                    kept++;
+                }
+            }
+            env.apply(bots[decision->player].select_action(obs, decision->mask));
+        }
+    }
+    // The games above include round 2 hands where the dealer kept the card.
+    REQUIRE(kept > 0);
+}
+
+TEST_CASE("DealSampler - reset_for drops voids only when it must", "[deal_sampler]") {
+    HeuristicBot bots[4] = {HeuristicBot{"H0"}, HeuristicBot{"H1"}, HeuristicBot{"H2"}, HeuristicBot{"H3"}};
+    Env env{11, {&bots[0], &bots[1], &bots[2], &bots[3]}};
+    DealSampler sampler;
+    DealConstraints c;
+    while (auto decision = env.next_decision()) {
+        const Observation& obs = decision->obs;
+        REQUIRE(sampler.reset_for(obs, c));
+        REQUIRE(c.allowed == DealConstraints::from_observation(obs).allowed);
+        env.apply(bots[decision->player].select_action(obs, decision->mask));
+    }
+
+    // Every other card already played leaves too few for three full hands, voids or not.
+    Observation obs;
+    obs.phase = Phase::PlayTrick;
+    obs.hand = Hand{0b11111u};
+    obs.played = euchre::constants::deck_reset & ~0b1111111u;
+    REQUIRE_FALSE(sampler.reset_for(obs, c));
+    REQUIRE(c.allowed[1] == DealConstraints::from_observation(obs).without_voids().allowed[1]);
+
+    obs.defending_alone = true;
+    REQUIRE_THROWS_AS(sampler.reset_for(obs, c), std::logic_error);
+}
@@ -53,4 +53,61 @@ TEST_CASE("Deal No Duplicates", "[deck]") {
 
     uint32_t match = gs.hand_state.hands[0].value() | gs.hand_state.hands[1].value() | gs.hand_state.hands[2].value() | gs.hand_state.hands[3].value();
     REQUIRE(match == sum);
-}
\ No newline at end of file
+}
+TEST_CASE("Deal kernel matches sequential draws", "[deck]") {
+    for (uint32_t seed = 0; seed < 200; seed++) {
+        euchre::rng::Philox4x32 a(seed), b(seed);
+        Deal d = deal_cards(a);
+
+        uint32_t deck = euchre::constants::deck_reset;
+        for (std::size_t p = 0; p < euchre::constants::num_players; p++) {
+            uint32_t hand = 0;
+            for (int j = 0; j < 5; j++) {
+                hand |= 1u << draw_card(deck, b);
+            }
+            REQUIRE(d.hands[p] == hand);
+        }
+        REQUIRE(d.face_up == draw_card(deck, b));
+        REQUIRE(d.kitty == deck);
+        REQUIRE(std::popcount(d.kitty) == 3);
+    }
+}
+
+TEST_CASE("Deal kernel paths agree", "[deck]") {
+    euchre::rng::Philox4x32 eng(7);
+    for (int n = 0; n < 2000; n++) {
+        DealRanks ranks = draw_deal_ranks(eng);
+        // Push the edges too: always the lowest, always the highest remaining card.
+        if (n == 0) {
+            ranks.fill(0);
+        }
+        if (n == 1) {
+            for (std::size_t i = 0; i < ranks.size(); i++) {
+                ranks[i] = static_cast<uint8_t>(euchre::constants::num_cards - 1 - i);
+            }
+        }
+
+        Deal portable = unrank_deal_portable(ranks);
+        Deal dispatched = unrank_deal(ranks);
+        REQUIRE(portable.hands == dispatched.hands);
+        REQUIRE(portable.face_up == dispatched.face_up);
+        REQUIRE(portable.kitty == dispatched.kitty);
+
+#if defined(EUCHRE_HAS_BMI2_DEAL)
+        if (cpu_has_bmi2()) {
+            Deal bmi2 = unrank_deal_bmi2(ranks);
+            REQUIRE(portable.hands == bmi2.hands);
+            REQUIRE(portable.face_up == bmi2.face_up);
+            REQUIRE(portable.kitty == bmi2.kitty);
+        }
+#endif
+
+        uint32_t all = portable.kitty | (1u << portable.face_up);
+        for (uint32_t h : portable.hands) {
+            REQUIRE(std::popcount(h) == 5);
+            REQUIRE((all & h) == 0);
+            all |= h;
+        }
+        REQUIRE(all == static_cast<uint32_t>(euchre::constants::deck_reset));
+    }
+}
@@ -0,0 +1,222 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Deck.hpp"
+#include "DoubleDummy.hpp"
+#include "Rules.hpp"
+#include <algorithm>
+#include <bit>
+
+namespace {
+
+/**
+ * Plain minimax with no pruning or table, straight from the rule primitives.
+ */
+int brute_force(DDPosition pos) {
+    bool alone = pos.going_alone;
+    uint8_t trick_size = alone ? 3 : 4;
+    uint8_t p = pos.current_player;
+    if (pos.num_played == 0 && pos.hands[p] == 0) {
+        return 0;
+    }
+
+    uint32_t legal = pos.hands[p];
+    if (pos.num_played > 0) {
+        const auto& t = euchre::tables::tables();
+        Card lead = pos.trick_cards[pos.lead_player];
+        uint32_t follow = legal & t.suit_mask_tbl[pos.trump][t.eff_suit_tbl[pos.trump][lead]];
+        legal = follow ? follow : legal;
+    }
+
+    int best = p % 2 == 0 ? -1 : 99;
+    for (uint32_t rest = legal; rest; rest &= rest - 1) {
+        Card c {static_cast<uint8_t>(std::countr_zero(rest))};
+        DDPosition next = pos;
+        next.hands[p] ^= 1u << c;
+        next.trick_cards[p] = c;
+        next.num_played++;
+        int value = 0;
+        if (next.num_played == trick_size) {
+            uint8_t winner = euchre::rules::trick_winner(next.trick_cards, pos.trump, next.trick_cards[pos.lead_player],
+                                                         alone, pos.maker_player);
+            next.lead_player = winner;
+            next.current_player = winner;
+            next.num_played = 0;
+            value = (winner % 2 == 0 ? 1 : 0) + brute_force(next);
+        }
+        else {
+            next.current_player = euchre::rules::next_player(p, alone, pos.maker_player);
+            value = brute_force(next);
+        }
+        best = p % 2 == 0 ? std::max(best, value) : std::min(best, value);
+    }
+    return best;
+}
+
+/**
+ * A random position with `cards` cards per hand and a random trick in progress.
+ */
+DDPosition random_position(euchre::rng::Philox4x32& eng, int cards, bool alone) {
+    Deal deal = deal_cards(eng);
+    DDPosition pos;
+    pos.trump = static_cast<Suit>(euchre::rng::bounded(eng, 4));
+    pos.going_alone = alone;
+    pos.maker_player = static_cast<uint8_t>(euchre::rng::bounded(eng, 4));
+    pos.lead_player = static_cast<uint8_t>(euchre::rng::bounded(eng, 4));
+    if (alone && pos.lead_player == euchre::rules::sitting_out_player(pos.maker_player)) {
+        pos.lead_player = pos.maker_player;
+    }
+    for (std::size_t p = 0; p < 4; p++) {
+        uint32_t h = deal.hands[p];
+        for (int drop = 5 - cards; drop > 0; drop--) {
+            h &= h - 1;
+        }
+        pos.hands[p] = alone && p == euchre::rules::sitting_out_player(pos.maker_player) ? 0 : h;
+    }
+    pos.tricks_won = {static_cast<uint8_t>(5 - cards), 0};
+    pos.current_player = pos.lead_player;
+
+    // Play a few legal cards into the first trick.
+    auto played = euchre::rng::bounded(eng, alone ? 3 : 4);
+    const auto& t = euchre::tables::tables();
+    for (uint32_t i = 0; i < played; i++) {
+        uint8_t p = pos.current_player;
+        uint32_t legal = pos.hands[p];
+        if (i > 0) {
+            Card lead = pos.trick_cards[pos.lead_player];
+            uint32_t follow = legal & t.suit_mask_tbl[pos.trump][t.eff_suit_tbl[pos.trump][lead]];
+            legal = follow ? follow : legal;
+        }
+        Card c {static_cast<uint8_t>(std::countr_zero(legal))};
+        pos.hands[p] ^= 1u << c;
+        pos.trick_cards[p] = c;
+        pos.num_played++;
+        pos.current_player = euchre::rules::next_player(p, alone, pos.maker_player);
+    }
+    return pos;
+}
+
+}
+
+TEST_CASE("Double dummy matches brute force", "[double_dummy]") {
+    DoubleDummySolver solver{12};
+    euchre::rng::Philox4x32 eng(5);
+    for (int n = 0; n < 300; n++) {
+        int cards = n < 250 ? 3 : 4;
+        bool alone = n % 3 == 0;
+        DDPosition pos = random_position(eng, cards, alone);
+        int expected = brute_force(pos);
+
+        auto tricks = solver.solve(pos);
+        REQUIRE(tricks[0] == pos.tricks_won[0] + expected);
+        REQUIRE(tricks[0] + tricks[1] == 5);
+    }
+}
+
+TEST_CASE("Equivalent cards collapse to one move", "[double_dummy]") {
+    auto bit = [](Suit s, Rank r) { return 1u << Card{s, r}; };
+    uint32_t aq = bit(Suit::S, Rank::RA) | bit(Suit::S, Rank::RQ);
+    // The king still in play keeps the ace and queen apart; once it is gone only the ace is kept.
+    REQUIRE(euchre::rules::distinct_moves(aq, Suit::H, 0) == aq);
+    REQUIRE(euchre::rules::distinct_moves(aq, Suit::H, bit(Suit::S, Rank::RK)) == bit(Suit::S, Rank::RA));
+
+    // Touching cards are always equivalent, across suits nothing is.
+    uint32_t kq = bit(Suit::S, Rank::RK) | bit(Suit::S, Rank::RQ);
+    REQUIRE(euchre::rules::distinct_moves(kq, Suit::H, 0) == bit(Suit::S, Rank::RK));
+    uint32_t mixed = bit(Suit::S, Rank::RK) | bit(Suit::C, Rank::RQ);
+    REQUIRE(euchre::rules::distinct_moves(mixed, Suit::H, 0) == mixed);
+
+    // The left bower sits between the right bower and the ace of trump.
+    uint32_t bowers = bit(Suit::H, Rank::RJ) | bit(Suit::H, Rank::RA);
+    REQUIRE(euchre::rules::distinct_moves(bowers, Suit::H, 0) == bowers);
+    REQUIRE(euchre::rules::distinct_moves(bowers, Suit::H, bit(Suit::D, Rank::RJ)) == bit(Suit::H, Rank::RJ));
+    // The jack of spades is a plain spade when hearts are trump.
+    uint32_t spades = bit(Suit::S, Rank::RQ) | bit(Suit::S, Rank::RT);
+    REQUIRE(euchre::rules::distinct_moves(spades, Suit::H, 0) == spades);
+    REQUIRE(euchre::rules::distinct_moves(spades, Suit::H, bit(Suit::S, Rank::RJ)) == bit(Suit::S, Rank::RQ));
+}
+
+TEST_CASE("Double dummy move values match unreduced brute force", "[double_dummy]") {
+    DoubleDummySolver solver{12};
+    euchre::rng::Philox4x32 eng(23);
+    for (int n = 0; n < 200; n++) {
+        DDPosition pos = random_position(eng, 3, n % 3 == 0);
+        auto values = solver.solve_moves(pos);
+        uint8_t p = pos.current_player;
+        uint8_t team = p % 2;
+        bool alone = pos.going_alone;
+
+        uint32_t legal = pos.hands[p];
+        if (pos.num_played > 0) {
+            const auto& t = euchre::tables::tables();
+            Card lead = pos.trick_cards[pos.lead_player];
+            uint32_t follow = legal & t.suit_mask_tbl[pos.trump][t.eff_suit_tbl[pos.trump][lead]];
+            legal = follow ? follow : legal;
+        }
+        for (uint32_t rest = legal; rest; rest &= rest - 1) {
+            Card c {static_cast<uint8_t>(std::countr_zero(rest))};
+            DDPosition next = pos;
+            next.hands[p] ^= 1u << c;
+            next.trick_cards[p] = c;
+            next.num_played++;
+            int team0 = 0;
+            if (next.num_played == (alone ? 3 : 4)) {
+                uint8_t winner = euchre::rules::trick_winner(next.trick_cards, pos.trump, next.trick_cards[pos.lead_player],
+                                                             alone, pos.maker_player);
+                next.lead_player = winner;
+                next.current_player = winner;
+                next.num_played = 0;
+                team0 = (winner % 2 == 0 ? 1 : 0) + brute_force(next);
+            }
+            else {
+                next.current_player = euchre::rules::next_player(p, alone, pos.maker_player);
+                team0 = brute_force(next);
+            }
+            int own = team == 0 ? team0 : 3 - team0;
+            REQUIRE(values[c] == pos.tricks_won[team] + own);
+        }
+    }
+}
+
+TEST_CASE("Double dummy move values agree with solve", "[double_dummy]") {
+    DoubleDummySolver solver;
+    euchre::rng::Philox4x32 eng(11);
+    for (int n = 0; n < 200; n++) {
+        DDPosition pos = random_position(eng, 5, n % 4 == 0);
+        auto tricks = solver.solve(pos);
+        auto values = solver.solve_moves(pos);
+        uint8_t team = pos.current_player % 2;
+
+        int best = *std::max_element(values.begin(), values.end());
+        REQUIRE(best == tricks[team]);
+        for (uint8_t c = 0; c < euchre::constants::num_cards; c++) {
+            bool in_hand = (pos.hands[pos.current_player] >> c) & 1u;
+            if (!in_hand) {
+                REQUIRE(values[c] == -1);
+            }
+        }
+    }
+}
+
+TEST_CASE("Double dummy top trumps take every trick", "[double_dummy]") {
+    DDPosition pos;
+    pos.trump = Suit::H;
+    // Player 0 holds both bowers, ace, king and queen of hearts and leads.
+    for (Card c : {Card{Suit::H, Rank::RJ}, Card{Suit::D, Rank::RJ}, Card{Suit::H, Rank::RA},
+                   Card{Suit::H, Rank::RK}, Card{Suit::H, Rank::RQ}}) {
+        pos.hands[0] |= 1u << c;
+    }
+    uint32_t rest = euchre::constants::deck_reset & ~pos.hands[0];
+    for (std::size_t p = 1; p < 4; p++) {
+        for (int j = 0; j < 5; j++) {
+            uint32_t bit = rest & -rest;
+            pos.hands[p] |= bit;
+            rest ^= bit;
+        }
+    }
+
+    DoubleDummySolver solver;
+    REQUIRE(solver.solve(pos) == std::array<uint8_t, 2>{5, 0});
+
+    pos.going_alone = true;
+    pos.maker_player = 0;
+    REQUIRE(solver.solve(pos) == std::array<uint8_t, 2>{5, 0});
+}
@@ -1,9 +1,11 @@
 #include <catch2/catch_test_macros.hpp>
 #include "Defns.hpp"
+#include "Bench.hpp"
 #include "Env.hpp"
 #include <bots/RandomBot.hpp>
 #include <bots/ScriptedBot.hpp>
 #include "bots.hpp"
+#include "bots/HeuristicBot.hpp"
 
 struct EuchreFixture {
     ScriptedBot bot_a{"Bot_A"}, bot_b{"Bot_B"}, bot_c{"Bot_C"}, bot_d{"Bot_D"};
@@ -361,6 +363,65 @@ TEST_CASE_METHOD(EuchreFixture, "Engine rejects illegal action", "[env]") {
     REQUIRE_THROWS_AS(env.step_hand(), std::invalid_argument);
 }
 
+TEST_CASE_METHOD(EuchreFixture, "Validation levels", "[env]") {
+    using namespace euchre::validation;
+    // Calling a suit in round 1 is illegal, but harmless: the engine reads it as a pass.
+    int asked = 0;
+    for (auto* bot : {&bot_a, &bot_b, &bot_c, &bot_d}) {
+        bot->fn = [&asked](const Observation&, ActionMask) {
+            asked++;
+            return euchre::action::call_trump(Suit::C);
+        };
+    }
+
+    BasicEnv<IBot, IBot, IBot, IBot, euchre::rules::RuleSet{}, full> checked{0x1234, players};
+    checked.step_hand(); // Deal
+    REQUIRE_THROWS_AS(checked.step_hand(), std::invalid_argument);
+    REQUIRE(asked == 1);
+
+    // Full checks reject an id past the mask's width, which would otherwise wrap onto OrderUp.
+    for (auto* bot : {&bot_a, &bot_b, &bot_c, &bot_d}) {
+        bot->fn = [](const Observation&, ActionMask) { return ActionId{113}; };
+    }
+    BasicEnv<IBot, IBot, IBot, IBot, euchre::rules::RuleSet{}, full> wide{0x1234, players};
+    wide.step_hand(); // Deal
+    REQUIRE_THROWS_AS(wide.step_hand(), std::invalid_argument);
+    for (auto* bot : {&bot_a, &bot_b, &bot_c, &bot_d}) {
+        bot->fn = [&asked](const Observation&, ActionMask) {
+            asked++;
+            return euchre::action::call_trump(Suit::C);
+        };
+    }
+
+    asked = 0;
+    BasicEnv<IBot, IBot, IBot, IBot, euchre::rules::RuleSet{}, trusted> vetted{0x1234, players};
+    vetted.step_hand();
+    vetted.step_hand(); // BidRound1 - four "passes"
+    REQUIRE(asked == 4);
+    REQUIRE(vetted.state.hand_state.phase == Phase::BidRound2);
+
+    BasicEnv<IBot, IBot, IBot, IBot, euchre::rules::RuleSet{}, trusted> driven{0x1234, players};
+    driven.apply(euchre::action::GoAloneNo); // Unchecked: a pass in round 1
+    REQUIRE(driven.state.hand_state.current_player == (driven.state.dealer + 2) % euchre::constants::num_players);
+
+    // An audited env checks every third decision only.
+    asked = 0;
+    BasicEnv<IBot, IBot, IBot, IBot, euchre::rules::RuleSet{}, audited(3)> sampled{0x1234, players};
+    sampled.step_hand();
+    REQUIRE_THROWS_AS(sampled.step_hand(), std::invalid_argument);
+    REQUIRE(asked == 3);
+
+    // Every level plays legal games the same way.
+    RandomBot r0{"R0"}, r1{"R1"}, r2{"R2"}, r3{"R3"};
+    std::array<IBot*, 4> random_players = {&r0, &r1, &r2, &r3};
+    BenchResult full_result{}, trusted_result{};
+    play_env_games<Env>(random_players, 0, 50, 10000, full_result);
+    play_env_games<BasicEnv<IBot, IBot, IBot, IBot, euchre::rules::RuleSet{}, trusted>>(random_players, 0, 50, 10000,
+                                                                                           trusted_result);
+    REQUIRE(full_result.team0_wins == trusted_result.team0_wins);
+    REQUIRE(full_result.team1_wins == trusted_result.team1_wins);
+}
+
 TEST_CASE_METHOD(EuchreFixture, "BidRound2 through full hand", "[env]") {
     for (auto* bot : {&bot_a, &bot_b, &bot_c, &bot_d}) {
         bot->fn = [](const Observation& obs, ActionMask mask) -> ActionId {
@@ -393,3 +454,112 @@ TEST_CASE_METHOD(EuchreFixture, "BidRound2 through full hand", "[env]") {
     }
 }
 
+
+TEST_CASE_METHOD(EuchreFixture, "Resumable - bid round 1 pauses between players", "[resumable]") {
+    auto decision = env.next_decision();
+    REQUIRE(decision.has_value());
+    REQUIRE(env.state.hand_state.phase == Phase::BidRound1);
+
+    // Every seat gets its own decision, starting left of the dealer.
+    for (uint8_t i = 1; i <= euchre::constants::num_players; i++) {
+        decision = env.next_decision();
+        REQUIRE(decision->player == (env.state.dealer + i) % euchre::constants::num_players);
+        REQUIRE(decision->obs.phase == Phase::BidRound1);
+        REQUIRE(decision->mask == euchre::action::make_mask(euchre::action::Pass, euchre::action::OrderUp));
+        env.apply(euchre::action::Pass);
+    }
+
+    decision = env.next_decision();
+    REQUIRE(decision->obs.phase == Phase::BidRound2);
+    REQUIRE(decision->player == (env.state.dealer + 1) % euchre::constants::num_players);
+}
+
+TEST_CASE_METHOD(EuchreFixture, "Resumable - trick pauses between players", "[resumable]") {
+    // Order up, stay home, then play one card at a time.
+    env.apply(euchre::action::OrderUp);
+    env.apply(euchre::action::GoAloneNo);
+    auto decision = env.next_decision();
+    REQUIRE(decision->obs.phase == Phase::DealerPickupDiscard);
+    REQUIRE(decision->obs.hand.num_cards() == 6);
+    env.apply(ActionId{static_cast<uint16_t>(std::countr_zero(decision->mask))});
+
+    uint8_t leader = env.state.hand_state.lead_player;
+    for (uint8_t i = 0; i < euchre::constants::num_players; i++) {
+        decision = env.next_decision();
+        REQUIRE(decision->obs.phase == Phase::PlayTrick);
+        REQUIRE(decision->player == (leader + i) % euchre::constants::num_players);
+        REQUIRE(decision->obs.num_played == i);
+        env.apply(ActionId{static_cast<uint16_t>(std::countr_zero(decision->mask))});
+    }
+    REQUIRE(env.state.hand_state.tricks_played == 1);
+}
+
+TEST_CASE_METHOD(EuchreFixture, "Resumable - illegal action throws", "[resumable]") {
+    REQUIRE_THROWS_AS(env.apply(euchre::action::GoAloneYes), std::invalid_argument);
+}
+
+TEST_CASE("Resumable - matches bot driven games", "[resumable]") {
+    HeuristicBot h0{"H0"}, h2{"H2"};
+    RandomBot r1{"R1"}, r3{"R3"};
+    std::array<IBot*, 4> players = {&h0, &r1, &h2, &r3};
+
+    for (unsigned int seed = 0; seed < 50; seed++) {
+        r1.on_new_match(seed);
+        r3.on_new_match(seed + 1);
+        Env driven{seed, players};
+        while (driven.state.status != GameState::GameStatus::GameOver) {
+            driven.step_game();
+        }
+
+        r1.on_new_match(seed);
+        r3.on_new_match(seed + 1);
+        Env resumable{seed, players};
+        while (auto decision = resumable.next_decision()) {
+            resumable.apply(players[decision->player]->select_action(decision->obs, decision->mask));
+        }
+
+        REQUIRE(resumable.state.status == GameState::GameStatus::GameOver);
+        REQUIRE(resumable.state.scores[0] == driven.state.scores[0]);
+        REQUIRE(resumable.state.scores[1] == driven.state.scores[1]);
+        REQUIRE_FALSE(resumable.next_decision().has_value());
+    }
+}
+
+TEST_CASE("History - played cards and voids track the hand", "[history]") {
+    RandomBot r0{"R0"}, r1{"R1"}, r2{"R2"}, r3{"R3"};
+    std::array<IBot*, 4> players = {&r0, &r1, &r2, &r3};
+
+    for (unsigned int seed = 0; seed < 30; seed++) {
+        for (uint8_t seat = 0; seat < euchre::constants::num_players; seat++) {
+            players[seat]->on_new_match(seed * 4 + seat);
+        }
+        Env env{seed, players};
+        while (auto decision = env.next_decision()) {
+            const Observation& obs = decision->obs;
+            const HandState& hs = env.state.hand_state;
+            uint32_t all = 0;
+            for (uint8_t p = 0; p < euchre::constants::num_players; p++) {
+                REQUIRE((obs.played_by[p] & hs.hands[p].value()) == 0);
+                // A seat never holds a card of a suit it has shown out of.
+                REQUIRE((obs.voids[p] & hs.hands[p].value()) == 0);
+                all |= obs.played_by[p];
+            }
+            REQUIRE(obs.played == all);
+
+            uint32_t history = 0;
+            for (uint8_t t = 0; t <= hs.tricks_played && t < 5; t++) {
+                for (uint8_t p = 0; p < euchre::constants::num_players; p++) {
+                    Card c = hs.trick_history[t][p];
+                    if (c.v != euchre::constants::invalid_card) {
+                        REQUIRE((obs.played_by[p] >> c) & 1u);
+                        history |= 1u << c;
+                    }
+                }
+            }
+            REQUIRE(history == obs.played);
+            REQUIRE(std::popcount(obs.played) == 4 * hs.tricks_played - (hs.going_alone ? hs.tricks_played : 0) + hs.num_played);
+
+            env.apply(players[decision->player]->select_action(obs, decision->mask));
+        }
+    }
+}
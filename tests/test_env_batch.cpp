@@ -0,0 +1,137 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Env.hpp"
+#include "EnvBatch.hpp"
+#include "bots/HeuristicBot.hpp"
+#include "bots/MaxBot.hpp"
+#include <bit>
+#include <vector>
+
+TEST_CASE("EnvBatch parks every game at a decision", "[batch]") {
+    EnvBatch batch{64, 0};
+
+    for (std::size_t g = 0; g < batch.size(); g++) {
+        REQUIRE(batch.masks[g] != 0);
+        REQUIRE(batch.phase[g] == Phase::BidRound1);
+        REQUIRE(batch.current_player[g] == (batch.dealer[g] + 1) % euchre::constants::num_players);
+        for (int p = 0; p < euchre::constants::num_players; p++) {
+            REQUIRE(batch.hands[g * 4 + static_cast<std::size_t>(p)].num_cards() == 5);
+        }
+    }
+}
+
+TEST_CASE("EnvBatch rejects illegal actions", "[batch]") {
+    EnvBatch batch{4, 0};
+    std::vector<ActionId> actions(batch.size(), euchre::action::GoAloneYes);
+    REQUIRE_THROWS_AS(batch.step_batch(actions), std::invalid_argument);
+
+    // A bad action in the last game rejects the batch before any earlier game moves.
+    std::vector<ActionId> legal(batch.size());
+    for (std::size_t g = 0; g < batch.size(); g++) {
+        legal[g] = ActionId{static_cast<uint16_t>(std::countr_zero(batch.masks[g]))};
+    }
+    batch.step_batch(legal);
+    for (std::size_t g = 0; g < batch.size(); g++) {
+        legal[g] = ActionId{static_cast<uint16_t>(std::countr_zero(batch.masks[g]))};
+    }
+    legal.back() = euchre::action::GoAloneYes;
+
+    auto hands = batch.hands;
+    auto phase = batch.phase;
+    auto scores = batch.scores;
+    auto rewards = batch.rewards;
+    auto dones = batch.dones;
+    auto masks = batch.masks;
+    auto current_player = batch.current_player;
+    REQUIRE_THROWS_AS(batch.step_batch(legal), std::invalid_argument);
+    for (std::size_t i = 0; i < hands.size(); i++) {
+        REQUIRE(batch.hands[i].value() == hands[i].value());
+    }
+    REQUIRE(batch.phase == phase);
+    REQUIRE(batch.scores == scores);
+    REQUIRE(batch.rewards == rewards);
+    REQUIRE(batch.dones == dones);
+    REQUIRE(batch.masks == masks);
+    REQUIRE(batch.current_player == current_player);
+
+    // An id past the mask's width is rejected rather than wrapped onto a legal bit.
+    legal.back() = ActionId{64};
+    REQUIRE_THROWS_AS(batch.step_batch(legal), std::invalid_argument);
+    REQUIRE(batch.phase == phase);
+    REQUIRE(batch.scores == scores);
+    REQUIRE(batch.dones == dones);
+    REQUIRE(batch.masks == masks);
+    REQUIRE(batch.current_player == current_player);
+}
+
+TEST_CASE("EnvBatch matches Env game for game", "[batch]") {
+    constexpr std::size_t num_games = 50;
+    HeuristicBot h0{"H0"}, h2{"H2"};
+    MaxBot m1{"M1"}, m3{"M3"};
+    std::array<IBot*, 4> players = {&h0, &m1, &h2, &m3};
+
+    // Final scores from the single game engine.
+    std::vector<std::array<uint8_t, 2>> expected(num_games);
+    for (std::size_t g = 0; g < num_games; g++) {
+        Env env{static_cast<unsigned int>(g), players};
+        while (env.state.status != GameState::GameStatus::GameOver) {
+            env.step_game();
+        }
+        expected[g] = {env.state.scores[0], env.state.scores[1]};
+    }
+
+    EnvBatch batch{num_games, 0};
+    std::vector<std::array<int, 2>> totals(num_games);
+    std::vector<bool> finished(num_games, false);
+    std::vector<ActionId> actions(num_games);
+    std::size_t remaining = num_games;
+
+    while (remaining > 0) {
+        for (std::size_t g = 0; g < num_games; g++) {
+            Observation obs = batch.observation(g);
+            actions[g] = players[obs.player]->select_action(obs, batch.masks[g]);
+        }
+        batch.step_batch(actions);
+
+        for (std::size_t g = 0; g < num_games; g++) {
+            if (finished[g]) {
+                continue;
+            }
+            totals[g][0] += batch.rewards[g * 2];
+            totals[g][1] += batch.rewards[g * 2 + 1];
+            if (batch.dones[g]) {
+                finished[g] = true;
+                remaining--;
+            }
+        }
+    }
+
+    for (std::size_t g = 0; g < num_games; g++) {
+        REQUIRE(totals[g][0] == expected[g][0]);
+        REQUIRE(totals[g][1] == expected[g][1]);
+    }
+
+    // Finished slots keep playing with fresh seeds.
+    for (std::size_t g = 0; g < num_games; g++) {
+        REQUIRE(batch.game_seed[g] >= num_games);
+    }
+}
+
+TEST_CASE("EnvBatch observations carry the same history as Env", "[batch]") {
+    HeuristicBot h0{"H0"}, h1{"H1"}, h2{"H2"}, h3{"H3"};
+    std::array<IBot*, 4> players = {&h0, &h1, &h2, &h3};
+    EnvBatch batch{1, 7};
+    Env env{7, players};
+
+    for (int step = 0; step < 200; step++) {
+        auto decision = env.next_decision();
+        Observation obs = batch.observation(0);
+        REQUIRE(obs.played == decision->obs.played);
+        REQUIRE(obs.played_by == decision->obs.played_by);
+        REQUIRE(obs.voids == decision->obs.voids);
+
+        ActionId action = players[obs.player]->select_action(obs, batch.masks[0]);
+        env.apply(action);
+        std::vector<ActionId> actions{action};
+        batch.step_batch(actions);
+    }
+}
@@ -0,0 +1,169 @@
+#include <catch2/catch_test_macros.hpp>
+#include "EquityTable.hpp"
+#include "Env.hpp"
+#include "WorkerPool.hpp"
+#include "bots/EquityBidBot.hpp"
+#include "bots/HeuristicBot.hpp"
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <stdexcept>
+
+namespace {
+
+std::string temp_path(const std::string& name) {
+    auto p = std::filesystem::temp_directory_path() / name;
+    std::filesystem::remove(p);
+    return p.string();
+}
+
+std::string read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    return {std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>()};
+}
+
+Hand make_hand(std::initializer_list<Card> cards) {
+    Hand h;
+    for (Card c : cards) {
+        h.give_card(c);
+    }
+    return h;
+}
+
+/**
+ * @brief A config that fills exactly the chunk holding key.
+ */
+EquityConfig chunk_of(uint32_t key) {
+    return {.rollouts = 2, .seed = 3, .shard = key / EquityTable::chunk_keys, .num_shards = EquityTable::num_chunks};
+}
+
+Observation bid_obs(Hand hand, Card face_up, uint8_t player, Phase phase, Suit trump = Suit::None) {
+    Observation obs {};
+    obs.hand = hand;
+    obs.face_up_card = face_up;
+    obs.player = player;
+    obs.dealer = 0;
+    obs.phase = phase;
+    obs.trump = trump;
+    return obs;
+}
+
+}
+
+TEST_CASE("Equity tables resume and shard without changing values", "[equity]") {
+    EquityConfig config {.rollouts = 2, .seed = 5, .shard = 0, .num_shards = EquityTable::num_chunks};
+    std::string whole = temp_path("euchre_test_equity_whole.bin");
+    std::string first = temp_path("euchre_test_equity_first.bin");
+    std::string second = temp_path("euchre_test_equity_second.bin");
+    std::string merged = temp_path("euchre_test_equity_merged.bin");
+
+    // Shards run one after another into one file; a rerun has nothing left to do.
+    REQUIRE(EquityTable::generate(whole, config) == 1);
+    REQUIRE(EquityTable::generate(whole, config) == 0);
+    config.shard = 1;
+    REQUIRE(EquityTable::generate(whole, config) == 1);
+
+    // The same shards from separate runs, one of them threaded, merge into the same bytes.
+    WorkerPool pool{3};
+    REQUIRE(EquityTable::generate(second, config, &pool) == 1);
+    config.shard = 0;
+    REQUIRE(EquityTable::generate(first, config) == 1);
+    EquityTable::merge({first, second}, merged);
+    REQUIRE(read_file(merged) == read_file(whole));
+
+    EquityTable table{merged};
+    REQUIRE(table.rollouts() == 2);
+    REQUIRE(table.chunks_done() == 2);
+    REQUIRE_FALSE(table.complete());
+    REQUIRE(table.lookup(0).has_value());
+    REQUIRE(table.lookup(2 * EquityTable::chunk_keys - 1).has_value());
+    REQUIRE_FALSE(table.lookup(2 * EquityTable::chunk_keys).has_value());
+    REQUIRE_FALSE(table.lookup(EquityTable::num_keys).has_value());
+
+    // Files only combine with files made with the same settings.
+    config.seed = 6;
+    REQUIRE_THROWS_AS(EquityTable::generate(whole, config), std::invalid_argument);
+    std::string other = temp_path("euchre_test_equity_other.bin");
+    EquityTable::generate(other, config);
+    REQUIRE_THROWS_AS(EquityTable::merge({first, other}, merged), std::invalid_argument);
+
+    for (const auto& path : {whole, first, second, merged, other}) {
+        std::filesystem::remove(path);
+    }
+}
+
+TEST_CASE("EquityBidBot bids from the table and falls back off it", "[equity]") {
+    // Every top trump: a sure march alone whichever suit is trump.
+    Hand hearts = make_hand({Card{Suit::H, Rank::RJ}, Card{Suit::D, Rank::RJ}, Card{Suit::H, Rank::RA},
+                             Card{Suit::H, Rank::RK}, Card{Suit::H, Rank::RQ}});
+    Hand spades = make_hand({Card{Suit::S, Rank::RJ}, Card{Suit::C, Rank::RJ}, Card{Suit::S, Rank::RA},
+                             Card{Suit::S, Rank::RK}, Card{Suit::S, Rank::RQ}});
+    Card nine_of_hearts {Suit::H, Rank::R9};
+
+    uint32_t order_key = EquityTable::key(hearts, Suit::H, nine_of_hearts, 1);
+    uint32_t call_key = EquityTable::key(spades, Suit::S, nine_of_hearts, 2);
+    std::string path = temp_path("euchre_test_equity_bot.bin");
+    EquityTable::generate(path, chunk_of(order_key));
+    if (!EquityTable{path}.lookup(call_key)) {
+        EquityTable::generate(path, chunk_of(call_key));
+    }
+    EquityTable table{path};
+
+    auto order = table.lookup(order_key);
+    REQUIRE(order.has_value());
+    REQUIRE((*order)[EquityTable::Alone] == 4.0f);
+    REQUIRE((*order)[EquityTable::Alone] > (*order)[EquityTable::Make]);
+    REQUIRE((*order)[EquityTable::Make] >= (*order)[EquityTable::Pass]);
+
+    EquityBidBot bot{"equity", table};
+    ActionMask round_1 = euchre::action::make_mask(euchre::action::Pass, euchre::action::OrderUp);
+    ActionMask go_alone = euchre::action::make_mask(euchre::action::GoAloneYes, euchre::action::GoAloneNo);
+    REQUIRE(bot.select_action(bid_obs(hearts, nine_of_hearts, 1, Phase::BidRound1), round_1) ==
+            euchre::action::OrderUp);
+    REQUIRE(bot.select_action(bid_obs(hearts, nine_of_hearts, 1, Phase::GoAloneDecision, Suit::H), go_alone) ==
+            euchre::action::GoAloneYes);
+
+    ActionMask round_2 = euchre::action::a2m(euchre::action::Pass);
+    for (Suit s : {Suit::C, Suit::S, Suit::D}) {
+        round_2 |= euchre::action::a2m(euchre::action::call_trump(s));
+    }
+    REQUIRE(bot.select_action(bid_obs(spades, nine_of_hearts, 2, Phase::BidRound2), round_2) ==
+            euchre::action::call_trump(Suit::S));
+
+    // A weak hand whose chunk was never generated bids like HeuristicBot.
+    Hand weak = make_hand({Card{Suit::H, Rank::R9}, Card{Suit::S, Rank::R9}, Card{Suit::S, Rank::RT},
+                           Card{Suit::C, Rank::R9}, Card{Suit::D, Rank::RT}});
+    Card ace_of_hearts {Suit::H, Rank::RA};
+    REQUIRE_FALSE(table.lookup(EquityTable::key(weak, Suit::H, ace_of_hearts, 3)).has_value());
+    HeuristicBot heuristic{"heuristic"};
+    Observation weak_obs = bid_obs(weak, ace_of_hearts, 3, Phase::BidRound1);
+    REQUIRE(bot.select_action(weak_obs, round_1) == heuristic.select_action(weak_obs, round_1));
+
+    // Whole games mix table lookups with fallbacks and stay legal.
+    HeuristicBot h1{"H1"}, h3{"H3"};
+    EquityBidBot e2{"E2", table};
+    Env env{7, {&bot, &h1, &e2, &h3}};
+    while (auto decision = env.next_decision()) {
+        env.apply(env.players[decision->player]->select_action(decision->obs, decision->mask));
+    }
+    REQUIRE((env.state.scores[0] >= 10 || env.state.scores[1] >= 10));
+
+    std::filesystem::remove(path);
+}
+
+TEST_CASE("Equity tables reject bad files and settings", "[equity]") {
+    REQUIRE_THROWS_AS(EquityTable{"/nonexistent/euchre.eq"}, std::runtime_error);
+
+    std::string bogus = temp_path("euchre_test_not_an_equity_table.bin");
+    {
+        std::ofstream out(bogus, std::ios::binary);
+        out << "definitely not an equity table";
+    }
+    REQUIRE_THROWS_AS(EquityTable{bogus}, std::runtime_error);
+    REQUIRE_THROWS_AS(EquityTable::generate(bogus, {}), std::runtime_error);
+    REQUIRE_THROWS_AS(EquityTable::merge({}, bogus), std::invalid_argument);
+
+    REQUIRE_THROWS_AS(EquityTable::generate(bogus, {.rollouts = 0}), std::invalid_argument);
+    REQUIRE_THROWS_AS(EquityTable::generate(bogus, {.shard = 2, .num_shards = 2}), std::invalid_argument);
+    std::filesystem::remove(bogus);
+}
@@ -342,3 +342,104 @@ TEST_CASE_METHOD(GameFixture, "Full game with different seed", "[game]") {
     REQUIRE(env2.state.status == GameState::GameStatus::GameOver);
     REQUIRE((env2.state.scores[0] >= 10 || env2.state.scores[1] >= 10));
 }
+
+// -- Rule sets: optional rules fixed at compile time --
+
+using euchre::rules::AllPass;
+using euchre::rules::RuleSet;
+using euchre::rules::StickTheDealer;
+
+template <RuleSet Rules>
+using RulesEnv = BasicEnv<IBot, IBot, IBot, IBot, Rules>;
+
+template <typename E>
+int play_out(E& e) {
+    int steps = 0;
+    while (e.state.status != GameState::GameStatus::GameOver && steps < 10000) {
+        e.step_game();
+        steps++;
+    }
+    return steps;
+}
+
+TEST_CASE_METHOD(GameFixture, "Rule sets - stick the dealer", "[rules]") {
+    for (auto* bot : {&bot_a, &bot_b, &bot_c, &bot_d}) {
+        bot->fn = test_bots::always_pass_both_rounds;
+    }
+
+    RulesEnv<RuleSet{.stick_the_dealer = StickTheDealer::On}> stuck{0x1234, players};
+    stuck.step_hand(); // Deal
+    stuck.step_hand(); // BidRound1 - everyone passes
+    stuck.step_hand(); // BidRound2 - dealer is forced to pick
+    REQUIRE(stuck.state.hand_state.phase == Phase::GoAloneDecision);
+    REQUIRE(stuck.state.hand_state.maker_player == stuck.state.dealer);
+
+    // Off ignores the per-hand flag.
+    RulesEnv<RuleSet{.stick_the_dealer = StickTheDealer::Off}> unstuck{0x1234, players};
+    unstuck.state.hand_state.stick_the_dealer = true;
+    unstuck.step_hand();
+    unstuck.step_hand();
+    unstuck.step_hand();
+    REQUIRE(unstuck.state.hand_state.phase == Phase::Deal);
+}
+
+TEST_CASE_METHOD(GameFixture, "Rule sets - passing the deal after four passes", "[rules]") {
+    for (auto* bot : {&bot_a, &bot_b, &bot_c, &bot_d}) {
+        bot->fn = test_bots::always_pass_both_rounds;
+    }
+
+    RulesEnv<RuleSet{.all_pass = AllPass::PassTheDeal}> passing{0x1234, players};
+    uint8_t dealer = passing.state.dealer;
+    for (int i = 0; i < 3; i++) {
+        passing.step_hand();
+        env.step_hand();
+    }
+    REQUIRE(passing.state.hand_state.phase == Phase::Deal);
+    REQUIRE(passing.state.dealer == (dealer + 1) % euchre::constants::num_players);
+    REQUIRE(env.state.hand_state.phase == Phase::Deal);
+    REQUIRE(env.state.dealer == dealer);
+}
+
+TEST_CASE_METHOD(GameFixture, "Rule sets - no loners skips the decision", "[rules]") {
+    int asked = 0;
+    for (auto* bot : {&bot_a, &bot_b, &bot_c, &bot_d}) {
+        bot->fn = [&asked](const Observation& obs, ActionMask action_mask) {
+            if (obs.phase == Phase::GoAloneDecision) {
+                asked++;
+                return euchre::action::GoAloneYes;
+            }
+            return test_bots::order_up_then_default(obs, action_mask);
+        };
+    }
+
+    RulesEnv<RuleSet{.going_alone = false}> partners{0x1234, players};
+    partners.step_hand(); // Deal
+    partners.step_hand(); // BidRound1 - first seat orders up
+    REQUIRE(partners.state.hand_state.phase == Phase::DealerPickupDiscard);
+
+    play_out(partners);
+    REQUIRE(partners.state.status == GameState::GameStatus::GameOver);
+    REQUIRE(asked == 0);
+}
+
+TEST_CASE_METHOD(GameFixture, "Rule sets - loner points and target score", "[rules]") {
+    RulesEnv<RuleSet{.lone_march_points = 3}> three{0x1234, players};
+    three.state.hand_state.maker_team = 1;
+    three.state.hand_state.tricks_won[1] = 5;
+    three.state.hand_state.going_alone = true;
+    three.state.hand_state.phase = Phase::HandOver;
+    three.hand_over();
+    REQUIRE(three.state.scores[1] == 3);
+
+    for (auto* bot : {&bot_a, &bot_b, &bot_c, &bot_d}) {
+        bot->fn = test_bots::order_up_no_alone;
+    }
+    RulesEnv<RuleSet{.target_score = 5}> short_game{0x1234, players};
+    int short_steps = play_out(short_game);
+    REQUIRE(short_game.state.status == GameState::GameStatus::GameOver);
+    REQUIRE(std::max(short_game.state.scores[0], short_game.state.scores[1]) >= 5);
+    REQUIRE(std::min(short_game.state.scores[0], short_game.state.scores[1]) < 5);
+
+    // Same deals as the game to 10, cut short.
+    REQUIRE(play_out(env) > short_steps);
+}
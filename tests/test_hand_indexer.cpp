@@ -0,0 +1,101 @@
+#include <catch2/catch_test_macros.hpp>
+#include "HandIndexer.hpp"
+#include <bit>
+#include <vector>
+
+namespace {
+
+constexpr Hand make_hand(std::initializer_list<Card> cards) {
+    Hand h;
+    for (Card c : cards) {
+        h.give_card(c);
+    }
+    return h;
+}
+
+/**
+ * @brief Move every card to another suit.
+ */
+Hand permute_suits(Hand hand, const std::array<Suit, 4>& to) {
+    Hand out;
+    for (uint32_t rest = hand.value(); rest; rest &= rest - 1) {
+        Card c {static_cast<uint8_t>(std::countr_zero(rest))};
+        out.give_card(Card{to[c.get_suit()], c.get_rank()});
+    }
+    return out;
+}
+
+// Indexing works at compile time.
+constexpr Hand lay_down = make_hand({Card{Suit::H, Rank::RJ}, Card{Suit::D, Rank::RJ}, Card{Suit::H, Rank::RA},
+                                     Card{Suit::H, Rank::RK}, Card{Suit::H, Rank::RQ}});
+static_assert(HandIndexer::index(lay_down, Suit::H) == HandIndexer::index(HandIndexer::unrank(HandIndexer::index(lay_down, Suit::H), Suit::C), Suit::C));
+static_assert(HandIndexer::num_hands == 22398);
+static_assert(HandIndexer::num_upcard_hands == 413490);
+
+}
+
+TEST_CASE("HandIndexer - every hand gets a dense index", "[hand_indexer]") {
+    std::vector<int> hits(HandIndexer::num_hands, 0);
+    for (uint32_t h = 0; h < (1u << euchre::constants::num_cards); h++) {
+        if (std::popcount(h) != 5) {
+            continue;
+        }
+        for (uint8_t t = 0; t < 4; t++) {
+            uint32_t i = HandIndexer::index(Hand{h}, Suit(t));
+            REQUIRE(i < HandIndexer::num_hands);
+            hits[i]++;
+        }
+    }
+    for (int n : hits) {
+        REQUIRE(n > 0);
+    }
+}
+
+TEST_CASE("HandIndexer - unrank inverts index", "[hand_indexer]") {
+    for (uint8_t t = 0; t < 4; t++) {
+        for (uint32_t i = 0; i < HandIndexer::num_hands; i++) {
+            Hand h = HandIndexer::unrank(i, Suit(t));
+            REQUIRE(std::popcount(h.value()) == 5);
+            REQUIRE(HandIndexer::index(h, Suit(t)) == i);
+        }
+    }
+    for (uint32_t i = 0; i < HandIndexer::num_upcard_hands; i++) {
+        auto [hand, upcard] = HandIndexer::unrank_with_upcard(i, Suit::S);
+        REQUIRE(!hand.hand_has(upcard));
+        REQUIRE(HandIndexer::index(hand, Suit::S, upcard) == i);
+    }
+}
+
+TEST_CASE("HandIndexer - isomorphic hands share an index", "[hand_indexer]") {
+    Hand h = make_hand({Card{Suit::H, Rank::RJ}, Card{Suit::D, Rank::RA}, Card{Suit::S, Rank::RK},
+                        Card{Suit::C, Rank::R9}, Card{Suit::C, Rank::RT}});
+
+    // Hearts trump, spades and clubs swapped.
+    Hand swapped = permute_suits(h, {Suit::S, Suit::H, Suit::C, Suit::D});
+    REQUIRE(HandIndexer::index(swapped, Suit::H) == HandIndexer::index(h, Suit::H));
+
+    // The same hand with clubs trump: hearts -> clubs, diamonds -> spades.
+    Hand relabelled = permute_suits(h, {Suit::H, Suit::C, Suit::D, Suit::S});
+    REQUIRE(HandIndexer::index(relabelled, Suit::C) == HandIndexer::index(h, Suit::H));
+
+    // Swapping trump with its same colour suit is not a symmetry: the bowers move.
+    Hand red_swap = permute_suits(h, {Suit::C, Suit::D, Suit::S, Suit::H});
+    REQUIRE(HandIndexer::index(red_swap, Suit::H) != HandIndexer::index(h, Suit::H));
+}
+
+TEST_CASE("HandIndexer - upcards", "[hand_indexer]") {
+    Hand h = make_hand({Card{Suit::H, Rank::RA}, Card{Suit::D, Rank::RK}, Card{Suit::S, Rank::RK},
+                        Card{Suit::C, Rank::R9}, Card{Suit::C, Rank::RT}});
+    Hand swapped = permute_suits(h, {Suit::S, Suit::H, Suit::C, Suit::D});
+
+    // A trump upcard keeps the other suits interchangeable.
+    Card trump_up {Suit::H, Rank::RJ};
+    REQUIRE(HandIndexer::index(swapped, Suit::H, trump_up) == HandIndexer::index(h, Suit::H, trump_up));
+    REQUIRE(HandIndexer::index(h, Suit::H, trump_up) != HandIndexer::index(h, Suit::H, Card{Suit::H, Rank::R9}));
+
+    // An upcard in one of them tells them apart, consistently.
+    Card club_up {Suit::C, Rank::RA};
+    Card spade_up {Suit::S, Rank::RA};
+    REQUIRE(HandIndexer::index(swapped, Suit::H, spade_up) == HandIndexer::index(h, Suit::H, club_up));
+    REQUIRE(HandIndexer::index(h, Suit::H, spade_up) != HandIndexer::index(h, Suit::H, club_up));
+}
@@ -0,0 +1,119 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Env.hpp"
+#include "Rules.hpp"
+#include "Tables.hpp"
+#include "WorkerPool.hpp"
+#include "bots/HeuristicBot.hpp"
+#include "bots/IsmctsBot.hpp"
+#include <bit>
+
+namespace {
+
+std::array<uint8_t, 2> play_game(std::array<IBot*, 4> players, unsigned int seed) {
+    for (uint8_t seat = 0; seat < euchre::constants::num_players; seat++) {
+        players[seat]->on_new_match(seed * euchre::constants::num_players + seat);
+    }
+    Env env{seed, players};
+    while (auto decision = env.next_decision()) {
+        env.apply(players[decision->player]->select_action(decision->obs, decision->mask));
+    }
+    return {env.state.scores[0], env.state.scores[1]};
+}
+
+}
+
+TEST_CASE("Ismcts plays legal games in every seat", "[ismcts]") {
+    IsmctsBot i0{"I0", 64}, i1{"I1", 64}, i2{"I2", 64}, i3{"I3", 64};
+    for (unsigned int seed = 0; seed < 3; seed++) {
+        auto scores = play_game({&i0, &i1, &i2, &i3}, seed);
+        REQUIRE((scores[0] >= 10 || scores[1] >= 10));
+    }
+}
+
+TEST_CASE("Ismcts choices do not depend on the pool", "[ismcts]") {
+    WorkerPool workers{2};
+    IsmctsBot serial0{"S0", 48, 3}, serial2{"S2", 48, 3};
+    IsmctsBot pooled0{"P0", 48, 3, {}, &workers}, pooled2{"P2", 48, 3, {}, &workers};
+    HeuristicBot h1{"H1"}, h3{"H3"};
+
+    for (unsigned int seed = 20; seed < 22; seed++) {
+        REQUIRE(play_game({&serial0, &h1, &serial2, &h3}, seed) == play_game({&pooled0, &h1, &pooled2, &h3}, seed));
+    }
+}
+
+TEST_CASE("Ismcts orders up a lay down hand", "[ismcts]") {
+    IsmctsBot bot{"I", 400};
+    bot.on_new_match(1);
+    Observation obs;
+    obs.phase = Phase::BidRound1;
+    obs.player = 1;
+    obs.dealer = 0;
+    obs.face_up_card = Card{Suit::H, Rank::R9};
+    for (Card c : {Card{Suit::H, Rank::RJ}, Card{Suit::D, Rank::RJ}, Card{Suit::H, Rank::RA},
+                   Card{Suit::H, Rank::RK}, Card{Suit::H, Rank::RQ}}) {
+        obs.hand.give_card(c);
+    }
+    ActionMask mask = euchre::action::make_mask(euchre::action::Pass, euchre::action::OrderUp);
+    REQUIRE(bot.select_action(obs, mask) == euchre::action::OrderUp);
+}
+
+TEST_CASE("Ismcts collapses moves in the tree as at the root", "[ismcts]") {
+    auto bit = [](Suit s, Rank r) { return 1u << Card{s, r}; };
+    const auto& t = euchre::tables::tables();
+
+    // Third trick, hearts trump, we lead holding the K, J and 9 of clubs with the Q of clubs gone.
+    Observation obs;
+    obs.phase = Phase::PlayTrick;
+    obs.player = 0;
+    obs.dealer = 3;
+    obs.trump = Suit::H;
+    obs.face_up_card = Card{Suit::D, Rank::R9};
+    obs.maker_team = 1;
+    obs.maker_player = 1;
+    obs.tricks_won = {1, 1};
+    for (Card c : {Card{Suit::C, Rank::RK}, Card{Suit::C, Rank::RJ}, Card{Suit::C, Rank::R9}}) {
+        obs.hand.give_card(c);
+    }
+    obs.played_by = {bit(Suit::C, Rank::RQ) | bit(Suit::S, Rank::R9), bit(Suit::C, Rank::RA) | bit(Suit::S, Rank::RT),
+                     bit(Suit::D, Rank::RA) | bit(Suit::S, Rank::RK), bit(Suit::H, Rank::R9) | bit(Suit::S, Rank::RA)};
+    obs.played = obs.played_by[0] | obs.played_by[1] | obs.played_by[2] | obs.played_by[3];
+    obs.voids[3] = t.suit_mask_tbl[Suit::H][Suit::C];
+
+    // The ten of clubs is still out, so K and J join but the 9 stays apart. Without the history
+    // all three would be distinct.
+    uint32_t hand = obs.hand.value();
+    uint32_t root = euchre::rules::distinct_moves(hand, obs.trump, obs.played);
+    REQUIRE(root == (bit(Suit::C, Rank::RK) | bit(Suit::C, Rank::R9)));
+    REQUIRE(std::popcount(euchre::rules::distinct_moves(hand, obs.trump, 0)) == 3);
+
+    IsmctsBot bot{"I", 200};
+    bot.on_new_match(5);
+    // Play actions share the card ids.
+    ActionId choice = bot.select_action(obs, ActionMask{hand});
+    REQUIRE((root & (1u << choice)) != 0);
+
+    uint32_t searched = 0;
+    for (std::size_t a = 0; a < euchre::action::num_actions; a++) {
+        if (bot.root_visits()[a] > 0) {
+            REQUIRE((root & (1u << a)) != 0);
+            searched++;
+        }
+    }
+    REQUIRE(searched == 2);
+}
+
+TEST_CASE("Ismcts plays the lowest move when no deal fits", "[ismcts]") {
+    IsmctsBot bot{"I", 50};
+    bot.on_new_match(1);
+    // Every other card but two already played leaves too few for the other hands, so nothing can
+    // be sampled. The two unseen cards keep our clubs apart.
+    Observation obs;
+    obs.phase = Phase::PlayTrick;
+    obs.trump = Suit::H;
+    obs.hand = Hand{0b101010101u};
+    obs.played = euchre::constants::deck_reset & ~0b111111111u;
+    uint32_t distinct = euchre::rules::distinct_moves(obs.hand.value(), obs.trump, obs.played);
+    REQUIRE(std::popcount(distinct) > 1);
+    ActionMask mask = obs.hand.value();
+    REQUIRE(bot.select_action(obs, mask) == ActionId{static_cast<uint16_t>(std::countr_zero(distinct))});
+}
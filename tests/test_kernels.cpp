@@ -0,0 +1,211 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Deck.hpp"
+#include "Env.hpp"
+#include "Rng.hpp"
+#include "Rules.hpp"
+#include "TrickKernels.hpp"
+#include "bots/HeuristicBot.hpp"
+#include "bots/RandomBot.hpp"
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <stdexcept>
+#include <vector>
+
+namespace {
+
+/**
+ * @brief Every kernel variant this machine can run, checked against expected.
+ */
+void check_winners(const std::vector<Card>& cards, const std::vector<Suit>& trump, const std::vector<Card>& lead,
+                   const std::vector<uint8_t>& sitting_out, const std::vector<uint8_t>& expected) {
+    std::vector<uint8_t> winners(expected.size());
+    euchre::kernels::trick_winners(cards, trump, lead, sitting_out, winners);
+    REQUIRE(winners == expected);
+    euchre::kernels::trick_winners_portable(cards, trump, lead, sitting_out, winners);
+    REQUIRE(winners == expected);
+#if defined(EUCHRE_HAS_AVX2_KERNELS)
+    if (euchre::kernels::cpu_has_avx2()) {
+        std::fill(winners.begin(), winners.end(), uint8_t{9});
+        euchre::kernels::trick_winners_avx2(cards, trump, lead, sitting_out, winners);
+        REQUIRE(winners == expected);
+    }
+#endif
+}
+
+void check_masks(const std::vector<uint32_t>& hands, const std::vector<Suit>& trump, const std::vector<Card>& lead,
+                 const std::vector<uint32_t>& expected) {
+    std::vector<uint32_t> masks(expected.size());
+    euchre::kernels::follow_masks(hands, trump, lead, masks);
+    REQUIRE(masks == expected);
+    euchre::kernels::follow_masks_portable(hands, trump, lead, masks);
+    REQUIRE(masks == expected);
+#if defined(EUCHRE_HAS_AVX2_KERNELS)
+    if (euchre::kernels::cpu_has_avx2()) {
+        std::fill(masks.begin(), masks.end(), 0u);
+        euchre::kernels::follow_masks_avx2(hands, trump, lead, masks);
+        REQUIRE(masks == expected);
+    }
+#endif
+}
+
+}
+
+TEST_CASE("Batched trick winners match the scalar rule", "[kernels]") {
+    euchre::rng::Philox4x32 eng(23);
+    // Not a multiple of eight, so the vector loop leaves a tail.
+    const std::size_t n = 1003;
+    std::vector<Card> cards(n * 4);
+    std::vector<Suit> trump(n);
+    std::vector<Card> lead(n);
+    std::vector<uint8_t> sitting_out(n), expected(n);
+    for (std::size_t g = 0; g < n; g++) {
+        Deal deal = deal_cards(eng);
+        std::array<Card, 4> trick {};
+        for (std::size_t p = 0; p < 4; p++) {
+            trick[p] = Card{static_cast<uint8_t>(std::countr_zero(deal.hands[p]))};
+        }
+        trump[g] = Suit(euchre::rng::bounded(eng, 4));
+        uint8_t maker = static_cast<uint8_t>(euchre::rng::bounded(eng, 4));
+        bool alone = g % 3 == 0;
+        sitting_out[g] = alone ? euchre::rules::sitting_out_player(maker) : euchre::constants::num_players;
+        if (alone) {
+            trick[sitting_out[g]] = Card{};
+        }
+        uint8_t leader = static_cast<uint8_t>(euchre::rng::bounded(eng, 4));
+        if (leader == sitting_out[g]) {
+            leader = maker;
+        }
+        lead[g] = trick[leader];
+        std::copy(trick.begin(), trick.end(), cards.begin() + static_cast<std::ptrdiff_t>(g * 4));
+        expected[g] = euchre::rules::trick_winner(trick, trump[g], lead[g], alone, maker);
+    }
+    check_winners(cards, trump, lead, sitting_out, expected);
+}
+
+TEST_CASE("Batched follow masks match Hand", "[kernels]") {
+    euchre::rng::Philox4x32 eng(31);
+    const std::size_t n = 517;
+    std::vector<uint32_t> hands(n), expected(n);
+    std::vector<Suit> trump(n);
+    std::vector<Card> lead(n);
+    for (std::size_t g = 0; g < n; g++) {
+        Deal deal = deal_cards(eng);
+        // Hands of one to five cards, led to by another seat's card or not at all.
+        hands[g] = deal.hands[0];
+        for (std::size_t drop = g % 5; drop > 0; drop--) {
+            hands[g] &= hands[g] - 1;
+        }
+        trump[g] = Suit(euchre::rng::bounded(eng, 4));
+        lead[g] = g % 7 == 0 ? Card{} : Card{pick_random_bit(deal.hands[1] | deal.kitty, eng)};
+        expected[g] = lead[g].v == euchre::constants::invalid_card ? hands[g]
+                                                                   : Hand{hands[g]}.get_valid_hand(lead[g], trump[g]);
+    }
+    check_masks(hands, trump, lead, expected);
+
+    std::vector<uint32_t> masks(n - 1);
+    REQUIRE_THROWS_AS(euchre::kernels::follow_masks(hands, trump, lead, masks), std::invalid_argument);
+}
+
+TEST_CASE("Batched kernels agree with Env over whole games", "[kernels]") {
+    // Every trick and every follow decision of a few games, replayed through the kernels in one batch.
+    std::vector<Card> cards, lead_cards, follow_leads;
+    std::vector<Suit> trumps, follow_trumps;
+    std::vector<uint8_t> sitting_out, winners;
+    std::vector<uint32_t> hands, masks;
+
+    HeuristicBot h0{"H0"}, h2{"H2"};
+    RandomBot r1{"R1"}, r3{"R3"};
+    for (unsigned int seed = 0; seed < 20; seed++) {
+        std::array<IBot*, 4> players {&h0, &r1, &h2, &r3};
+        for (uint8_t seat = 0; seat < 4; seat++) {
+            players[seat]->on_new_match(seed * 4 + seat);
+        }
+        Env env{seed, players};
+        while (auto decision = env.next_decision()) {
+            const HandState& hs = env.state.hand_state;
+            bool playing = hs.phase == Phase::PlayTrick;
+            if (playing && hs.num_played > 0) {
+                hands.push_back(hs.hands[decision->player].value());
+                follow_trumps.push_back(hs.trump);
+                follow_leads.push_back(hs.lead_card);
+                masks.push_back(static_cast<uint32_t>(decision->mask));
+            }
+
+            uint8_t players_in_trick = hs.going_alone ? 3 : 4;
+            bool closes_trick = playing && hs.num_played + 1 == players_in_trick && hs.tricks_played < 4;
+            std::array<Card, 4> trick = hs.trick_cards;
+            Suit trump = hs.trump;
+            Card lead = hs.lead_card;
+            uint8_t out = hs.going_alone ? euchre::rules::sitting_out_player(hs.maker_player)
+                                         : euchre::constants::num_players;
+
+            ActionId action = players[decision->player]->select_action(decision->obs, decision->mask);
+            env.apply(action);
+            if (closes_trick) {
+                // Seats that have not played this trick still show last trick's card; mask them.
+                trick[decision->player] = Card{static_cast<uint8_t>(action.v)};
+                if (out < 4) {
+                    trick[out] = Card{};
+                }
+                cards.insert(cards.end(), trick.begin(), trick.end());
+                trumps.push_back(trump);
+                lead_cards.push_back(lead);
+                sitting_out.push_back(out);
+                winners.push_back(env.state.hand_state.lead_player);
+            }
+        }
+    }
+    REQUIRE(winners.size() > 100);
+    check_winners(cards, trumps, lead_cards, sitting_out, winners);
+    check_masks(hands, follow_trumps, follow_leads, masks);
+}
+
+TEST_CASE("Batched Philox blocks match the engine", "[kernels]") {
+    const std::size_t n = 45;
+    std::vector<uint32_t> ctr0(n), ctr1(n), key0(n);
+    for (std::size_t i = 0; i < n; i++) {
+        ctr0[i] = static_cast<uint32_t>(i % 6);
+        ctr1[i] = static_cast<uint32_t>(i * 7919);
+        key0[i] = static_cast<uint32_t>(i / 6 + 0xFFFFFFF0u);
+    }
+    std::array<std::vector<uint32_t>, 4> expected;
+    for (auto& e : expected) {
+        e.resize(n);
+    }
+    for (std::size_t i = 0; i < n; i++) {
+        auto block = euchre::rng::philox4x32({ctr0[i], ctr1[i], 0, 0}, {key0[i], 3});
+        for (std::size_t j = 0; j < 4; j++) {
+            expected[j][i] = block[j];
+        }
+    }
+
+    std::array<std::vector<uint32_t>, 4> out;
+    for (auto& o : out) {
+        o.assign(n, 0);
+    }
+    std::array<std::span<uint32_t>, 4> spans {out[0], out[1], out[2], out[3]};
+    euchre::kernels::philox_blocks(ctr0, ctr1, key0, 3, spans);
+    REQUIRE(out == expected);
+    euchre::kernels::philox_blocks_portable(ctr0, ctr1, key0, 3, spans);
+    REQUIRE(out == expected);
+#if defined(EUCHRE_HAS_AVX2_KERNELS)
+    if (euchre::kernels::cpu_has_avx2()) {
+        for (auto& o : out) {
+            o.assign(n, 0);
+        }
+        euchre::kernels::philox_blocks_avx2(ctr0, ctr1, key0, 3, spans);
+        REQUIRE(out == expected);
+    }
+#endif
+
+    // The engine's draws are these blocks in order.
+    euchre::rng::Philox4x32 eng(key0[0], 3);
+    eng.seek(ctr1[0]);
+    for (std::size_t j = 0; j < 4; j++) {
+        REQUIRE(eng() == expected[j][0]);
+    }
+
+    REQUIRE_THROWS_AS(euchre::kernels::philox_blocks(ctr0, ctr1, std::span(key0).first(n - 1), 3, spans),
+                      std::invalid_argument);
+}
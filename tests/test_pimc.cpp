@@ -0,0 +1,40 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Env.hpp"
+#include "WorkerPool.hpp"
+#include "bots/HeuristicBot.hpp"
+#include "bots/PimcBot.hpp"
+
+namespace {
+
+std::array<uint8_t, 2> play_game(std::array<IBot*, 4> players, unsigned int seed) {
+    for (uint8_t seat = 0; seat < euchre::constants::num_players; seat++) {
+        players[seat]->on_new_match(seed * euchre::constants::num_players + seat);
+    }
+    Env env{seed, players};
+    while (auto decision = env.next_decision()) {
+        env.apply(players[decision->player]->select_action(decision->obs, decision->mask));
+    }
+    return {env.state.scores[0], env.state.scores[1]};
+}
+
+}
+
+TEST_CASE("Pimc plays legal games", "[pimc]") {
+    PimcBot p0{"P0", 4}, p2{"P2", 4};
+    HeuristicBot h1{"H1"}, h3{"H3"};
+    for (unsigned int seed = 0; seed < 3; seed++) {
+        auto scores = play_game({&p0, &h1, &p2, &h3}, seed);
+        REQUIRE((scores[0] >= 10 || scores[1] >= 10));
+    }
+}
+
+TEST_CASE("Pimc choices do not depend on the pool", "[pimc]") {
+    WorkerPool workers{3};
+    PimcBot serial0{"S0", 6}, serial2{"S2", 6};
+    PimcBot pooled0{"P0", 6, {}, &workers}, pooled2{"P2", 6, {}, &workers};
+    HeuristicBot h1{"H1"}, h3{"H3"};
+
+    for (unsigned int seed = 10; seed < 12; seed++) {
+        REQUIRE(play_game({&serial0, &h1, &serial2, &h3}, seed) == play_game({&pooled0, &h1, &pooled2, &h3}, seed));
+    }
+}
@@ -0,0 +1,88 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Rng.hpp"
+#include "Deck.hpp"
+#include "Env.hpp"
+#include "bots/RandomBot.hpp"
+#include <array>
+
+using euchre::rng::Philox4x32;
+
+TEST_CASE("Philox known answers", "[rng]") {
+    // Reference vectors from the Random123 distribution (philox4x32_10).
+    auto zero = euchre::rng::philox4x32({0, 0, 0, 0}, {0, 0});
+    REQUIRE(zero == std::array<uint32_t, 4>{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8});
+
+    auto ones = euchre::rng::philox4x32({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff}, {0xffffffff, 0xffffffff});
+    REQUIRE(ones == std::array<uint32_t, 4>{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd});
+
+    static_assert(euchre::rng::philox4x32({0, 0, 0, 0}, {0, 0})[0] == 0x6627e8d5);
+}
+
+TEST_CASE("Philox seeking matches sequential draws", "[rng]") {
+    Philox4x32 seq(42, 7);
+    seq.seek(3);
+    std::array<uint32_t, 10> draws;
+    for (auto& d : draws) {
+        d = seq();
+    }
+
+    for (uint32_t k = 0; k < draws.size(); k++) {
+        REQUIRE(Philox4x32::at(42, 7, 3, k) == draws[k]);
+
+        Philox4x32 jumped(42, 7);
+        jumped.seek(3, k);
+        REQUIRE(jumped() == draws[k]);
+    }
+
+    // Different hands and streams give different words.
+    REQUIRE(Philox4x32::at(42, 7, 4, 0) != draws[0]);
+    REQUIRE(Philox4x32::at(42, 8, 3, 0) != draws[0]);
+}
+
+TEST_CASE("Bounded draws stay in range and hit every value", "[rng]") {
+    Philox4x32 eng(1);
+    std::array<int, 7> counts {};
+    for (int i = 0; i < 7000; i++) {
+        uint32_t v = euchre::rng::bounded(eng, 7);
+        REQUIRE(v < 7);
+        counts[v]++;
+    }
+    for (int c : counts) {
+        REQUIRE(c > 800);
+        REQUIRE(c < 1200);
+    }
+}
+
+TEST_CASE("Each deal is a pure function of seed and hand number", "[rng]") {
+    RandomBot b0("r0"), b1("r1"), b2("r2"), b3("r3");
+    b0.on_new_match(1);
+    b1.on_new_match(2);
+    b2.on_new_match(3);
+    b3.on_new_match(4);
+    Env env(99, {&b0, &b1, &b2, &b3});
+
+    // Play a few hands so the deal counter has moved on.
+    while (env.state.hands_dealt < 4 && env.state.status != GameState::GameStatus::GameOver) {
+        env.step_game();
+    }
+    REQUIRE(env.state.hands_dealt == 4);
+
+    // Redealing hand 2 from scratch only needs the seed.
+    HandState fresh;
+    Philox4x32 eng(99);
+    eng.seek(2);
+    for (uint8_t p = 0; p < 4; p++) {
+        for (int j = 0; j < 5; j++) {
+            fresh.give_card_to(draw_card(fresh.deck, eng), p);
+        }
+    }
+    Card up = draw_card(fresh.deck, eng);
+
+    Env replay(99, {&b0, &b1, &b2, &b3});
+    replay.state.hands_dealt = 2;
+    replay.deal();
+    for (uint8_t p = 0; p < 4; p++) {
+        REQUIRE(replay.state.hand_state.hands[p].value() == fresh.hands[p].value());
+    }
+    REQUIRE(replay.state.hand_state.face_up_card == up);
+}
@@ -0,0 +1,93 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Bench.hpp"
+#include "SlicedPlayout.hpp"
+#include "WorkerPool.hpp"
+#include "bots/MaxBot.hpp"
+#include "bots/MinBot.hpp"
+#include "bots/RandomBot.hpp"
+#include <cmath>
+#include <memory>
+
+namespace {
+
+Lineup bots_for(const SlicedLineup& lineup) {
+    Lineup bots;
+    for (std::size_t seat = 0; seat < 4; seat++) {
+        switch (lineup[seat]) {
+            case SlicedPolicy::Random:
+                bots[seat] = std::make_unique<RandomBot>("R");
+                break;
+            case SlicedPolicy::Min:
+                bots[seat] = std::make_unique<MinBot>("Min");
+                break;
+            case SlicedPolicy::Max:
+                bots[seat] = std::make_unique<MaxBot>("Max");
+                break;
+        }
+    }
+    return bots;
+}
+
+BenchResult play_env(const SlicedLineup& lineup, int first, int last, int max_steps) {
+    Lineup bots = bots_for(lineup);
+    BenchResult result {};
+    play_games({bots[0].get(), bots[1].get(), bots[2].get(), bots[3].get()}, first, last, max_steps, result);
+    return result;
+}
+
+}
+
+TEST_CASE("Sliced Min and Max lineups replay Env game for game", "[sliced]") {
+    using enum SlicedPolicy;
+    for (SlicedLineup lineup : {SlicedLineup{Max, Min, Max, Min}, SlicedLineup{Min, Min, Max, Min},
+                                SlicedLineup{Max, Max, Max, Max}}) {
+        // Tight step limits stall games during bidding and during play.
+        for (int max_steps : {10000, 60, 23}) {
+            BenchResult expected = play_env(lineup, 100, 400, max_steps);
+            BenchResult sliced {};
+            play_sliced_games(lineup, 100, 400, max_steps, sliced);
+            REQUIRE(sliced.team0_wins == expected.team0_wins);
+            REQUIRE(sliced.team1_wins == expected.team1_wins);
+            REQUIRE(sliced.stalled == expected.stalled);
+        }
+    }
+}
+
+TEST_CASE("Sliced Random seats play like RandomBot", "[sliced]") {
+    using enum SlicedPolicy;
+    constexpr int num_games = 3000;
+    for (SlicedLineup lineup : {SlicedLineup{Random, Random, Random, Random}, SlicedLineup{Max, Random, Max, Random},
+                                SlicedLineup{Random, Min, Random, Max}}) {
+        BenchResult expected = play_env(lineup, 0, num_games, 10000);
+        BenchResult sliced = run_sliced_benchmark(lineup, num_games, 10000);
+        REQUIRE(sliced.stalled == 0);
+        REQUIRE(sliced.team0_wins + sliced.team1_wins == num_games);
+
+        // Same win rate, to within 4.5 standard errors of the difference.
+        double p = (expected.team0_wins + sliced.team0_wins) / (2.0 * num_games);
+        double tolerance = 4.5 * std::sqrt(2 * p * (1 - p) / num_games);
+        REQUIRE(std::abs(expected.team0_wins - sliced.team0_wins) / double{num_games} < tolerance);
+    }
+}
+
+TEST_CASE("Parallel sliced benchmark is independent of thread count", "[sliced][parallel]") {
+    using enum SlicedPolicy;
+    constexpr int num_games = 2 * sliced_block_games + 100;
+    SlicedLineup lineup {Random, Max, Random, Min};
+    BenchResult expected = run_sliced_benchmark(lineup, num_games, 10000);
+    REQUIRE(expected.team0_wins + expected.team1_wins + expected.stalled == num_games);
+
+    for (std::size_t threads : {std::size_t{1}, std::size_t{2}, std::size_t{4}}) {
+        WorkerPool pool{threads};
+        ParallelBenchResult r = run_parallel_sliced_benchmark(pool, lineup, num_games, 10000);
+        REQUIRE(r.total.team0_wins == expected.team0_wins);
+        REQUIRE(r.total.team1_wins == expected.team1_wins);
+        REQUIRE(r.total.stalled == expected.stalled);
+
+        int games = 0;
+        for (const auto& t : r.threads) {
+            games += t.games;
+        }
+        REQUIRE(games == num_games);
+    }
+}
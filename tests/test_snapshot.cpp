@@ -0,0 +1,59 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Env.hpp"
+#include "GameSnapshot.hpp"
+#include "bots/HeuristicBot.hpp"
+
+namespace {
+
+void play_out(Env& env) {
+    while (auto decision = env.next_decision()) {
+        env.apply(env.players[decision->player]->select_action(decision->obs, decision->mask));
+    }
+}
+
+}
+
+TEST_CASE("Snapshot round trips every decision point", "[snapshot]") {
+    HeuristicBot h0{"H0"}, h1{"H1"}, h2{"H2"}, h3{"H3"};
+    std::array<IBot*, 4> players = {&h0, &h1, &h2, &h3};
+
+    for (unsigned int seed = 0; seed < 20; seed++) {
+        Env env{seed, players};
+        while (auto decision = env.next_decision()) {
+            GameSnapshot snap = GameSnapshot::from_state(env.state);
+            GameState restored = snap.to_state();
+            REQUIRE(GameSnapshot::from_state(restored) == snap);
+            REQUIRE(restored.hand_state.hands[decision->player].value() == decision->obs.hand.value());
+            REQUIRE(restored.hand_state.num_played == decision->obs.num_played);
+            REQUIRE(restored.hand_state.played_by == env.state.hand_state.played_by);
+            REQUIRE(restored.hand_state.void_suits == env.state.hand_state.void_suits);
+            REQUIRE(restored.hand_state.trick_history == env.state.hand_state.trick_history);
+            REQUIRE(restored.hand_state.deck == env.state.hand_state.deck);
+            env.apply(players[decision->player]->select_action(decision->obs, decision->mask));
+        }
+    }
+}
+
+TEST_CASE("Restored snapshot plays out the same game", "[snapshot]") {
+    HeuristicBot h0{"H0"}, h1{"H1"}, h2{"H2"}, h3{"H3"};
+    std::array<IBot*, 4> players = {&h0, &h1, &h2, &h3};
+
+    for (unsigned int seed = 0; seed < 20; seed++) {
+        Env env{seed, players};
+        // Stop a few hands in, so the snapshot has to carry hands_dealt and the scores.
+        for (int i = 0; i < 37 && env.next_decision(); i++) {
+            auto decision = env.next_decision();
+            env.apply(players[decision->player]->select_action(decision->obs, decision->mask));
+        }
+        GameSnapshot snap = GameSnapshot::from_state(env.state);
+
+        Env copy{0, players};
+        snap.restore(copy.state);
+
+        play_out(env);
+        play_out(copy);
+        REQUIRE(copy.state.scores[0] == env.state.scores[0]);
+        REQUIRE(copy.state.scores[1] == env.state.scores[1]);
+        REQUIRE(copy.state.hands_dealt == env.state.hands_dealt);
+    }
+}
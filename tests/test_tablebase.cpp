@@ -0,0 +1,96 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Deck.hpp"
+#include "DoubleDummy.hpp"
+#include "Rules.hpp"
+#include "Tablebase.hpp"
+#include <bit>
+#include <filesystem>
+#include <fstream>
+#include <stdexcept>
+
+namespace {
+
+/**
+ * @brief A fresh two card tablebase, written once per test run.
+ */
+const std::string& two_card_path() {
+    static const std::string path = [] {
+        auto p = std::filesystem::temp_directory_path() / "euchre_test_tablebase_2.bin";
+        Tablebase::generate(p.string(), 2);
+        return p.string();
+    }();
+    return path;
+}
+
+/**
+ * @brief A position at a trick boundary with `cards` cards per playing hand.
+ */
+DDPosition random_endgame(euchre::rng::Philox4x32& eng, int cards, bool alone) {
+    Deal deal = deal_cards(eng);
+    DDPosition pos;
+    pos.trump = static_cast<Suit>(euchre::rng::bounded(eng, 4));
+    pos.going_alone = alone;
+    pos.maker_player = static_cast<uint8_t>(euchre::rng::bounded(eng, 4));
+    uint8_t sitting_out = euchre::rules::sitting_out_player(pos.maker_player);
+    pos.lead_player = static_cast<uint8_t>(euchre::rng::bounded(eng, 4));
+    if (alone && pos.lead_player == sitting_out) {
+        pos.lead_player = pos.maker_player;
+    }
+    pos.current_player = pos.lead_player;
+    for (std::size_t p = 0; p < 4; p++) {
+        uint32_t h = deal.hands[p];
+        for (int drop = 5 - cards; drop > 0; drop--) {
+            h &= h - 1;
+        }
+        pos.hands[p] = alone && p == sitting_out ? 0 : h;
+    }
+    pos.tricks_won = {static_cast<uint8_t>(5 - cards), 0};
+    return pos;
+}
+
+}
+
+TEST_CASE("Tablebase probes match the solver", "[tablebase]") {
+    Tablebase tb{two_card_path()};
+    REQUIRE(tb.max_cards() == 2);
+
+    DoubleDummySolver solver{12};
+    euchre::rng::Philox4x32 eng(17);
+    for (int n = 0; n < 2000; n++) {
+        DDPosition pos = random_endgame(eng, 2, n % 3 == 0);
+        int leader_team = tb.probe(pos.hands, pos.trump, pos.lead_player, pos.going_alone, pos.maker_player);
+        auto tricks = solver.solve(pos);
+        REQUIRE(leader_team == tricks[pos.lead_player % 2] - pos.tricks_won[pos.lead_player % 2]);
+    }
+
+    // Positions outside the table are refused.
+    DDPosition three = random_endgame(eng, 3, false);
+    REQUIRE(tb.probe(three.hands, three.trump, three.lead_player, false, 0) == -1);
+}
+
+TEST_CASE("Tablebase cut offs leave solver results unchanged", "[tablebase]") {
+    Tablebase tb{two_card_path()};
+    DoubleDummySolver plain{14}, probing{14};
+    probing.set_tablebase(&tb);
+
+    euchre::rng::Philox4x32 eng(29);
+    for (int n = 0; n < 300; n++) {
+        DDPosition pos = random_endgame(eng, 3 + n % 3, n % 4 == 0);
+        REQUIRE(plain.solve(pos) == probing.solve(pos));
+        REQUIRE(plain.solve_moves(pos) == probing.solve_moves(pos));
+    }
+    REQUIRE(probing.nodes() < plain.nodes());
+}
+
+TEST_CASE("Tablebase rejects files it did not write", "[tablebase]") {
+    REQUIRE_THROWS_AS(Tablebase{"/nonexistent/euchre.tb"}, std::runtime_error);
+
+    auto bogus = std::filesystem::temp_directory_path() / "euchre_test_not_a_tablebase.bin";
+    {
+        std::ofstream out(bogus, std::ios::binary);
+        out << "definitely not a tablebase";
+    }
+    REQUIRE_THROWS_AS(Tablebase{bogus.string()}, std::runtime_error);
+    REQUIRE_THROWS_AS(Tablebase::generate(bogus.string(), 4), std::invalid_argument);
+    std::filesystem::remove(bogus);
+}
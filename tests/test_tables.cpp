@@ -1,5 +1,8 @@
 #include <catch2/catch_test_macros.hpp>
 #include "Tables.hpp"
+#include "Rng.hpp"
+#include "bots/BotUtils.hpp"
+#include <bit>
 
 TEST_CASE("Effective Suit", "[tables]") {
     euchre::tables::Tables t = euchre::tables::tables();
@@ -103,3 +106,55 @@ TEST_CASE("Trump always beats led suit", "[tables]") {
     Card ace_of_led = make_card(Suit::D, Rank::RA);
     REQUIRE(t.power[trump][led][nine_of_trump] > t.power[trump][led][ace_of_led]);
 }
+
+namespace {
+
+/**
+ * @brief The first card of the set, by index, that `better` prefers to every earlier one.
+ */
+template <typename Better>
+Card scan(uint32_t cards, Better better) {
+    Card best {};
+    for (uint32_t rest = cards; rest; rest &= rest - 1) {
+        Card c {static_cast<uint8_t>(std::countr_zero(rest))};
+        if (best.v == euchre::constants::invalid_card || better(c, best)) {
+            best = c;
+        }
+    }
+    return best;
+}
+
+}
+
+TEST_CASE("Power order queries match a scan of the power table", "[tables]") {
+    const auto& t = euchre::tables::tables();
+    euchre::rng::Philox4x32 eng(11);
+    for (uint8_t tr = 0; tr < 4; tr++) {
+        for (uint8_t ld = 0; ld < 4; ld++) {
+            Suit trump = Suit(tr), led = Suit(ld);
+            const auto& power = t.power[trump][led];
+            for (int n = 0; n < 2000; n++) {
+                // Mostly hand sized sets, plus the empty and full deck.
+                uint32_t cards = n == 0 ? 0u : n == 1 ? uint32_t{euchre::constants::deck_reset} : 0u;
+                for (int k = n < 2 ? 0 : 1 + n % 7; k > 0; k--) {
+                    cards |= 1u << euchre::rng::bounded(eng, 24);
+                }
+
+                // Compare indices: an invalid Card does not print.
+                REQUIRE(bot_utils::lowest_card(cards, trump, led).v ==
+                        scan(cards, [&](Card c, Card b) { return power[c] < power[b]; }).v);
+                REQUIRE(bot_utils::highest_card(cards, trump, led).v ==
+                        scan(cards, [&](Card c, Card b) { return power[c] > power[b]; }).v);
+                for (Card beat : {Card{uint8_t{0}}, Card{static_cast<uint8_t>(n % 24)}, Card{Suit(tr), Rank::RJ}}) {
+                    uint8_t p = power[beat];
+                    uint32_t winners = 0;
+                    for (uint8_t c = 0; c < 24; c++) {
+                        winners |= (cards >> c & 1u) && power[c] > p ? 1u << c : 0u;
+                    }
+                    REQUIRE(bot_utils::cheapest_winner(cards, trump, led, p).v ==
+                            scan(winners, [&](Card c, Card b) { return power[c] < power[b]; }).v);
+                }
+            }
+        }
+    }
+}
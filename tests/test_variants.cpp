@@ -0,0 +1,408 @@
+#include <catch2/catch_test_macros.hpp>
+#include "Deck.hpp"
+#include "Env.hpp"
+#include "Rng.hpp"
+#include "Tables.hpp"
+#include "bots/BotUtils.hpp"
+#include "bots/IsmctsBot.hpp"
+#include "bots/PimcBot.hpp"
+#include "bots/RandomBot.hpp"
+#include "bots/ScriptedBot.hpp"
+#include "bots.hpp"
+#include <bit>
+
+using euchre::constants::joker;
+using euchre::rules::RuleSet;
+using euchre::tables::joker_deck;
+
+namespace {
+
+constexpr RuleSet joker_rules {.deck = joker_deck};
+constexpr RuleSet defend_rules {.defend_alone = true, .lone_defense_points = 3};
+constexpr RuleSet farmer_rules {.farmers_hand = true};
+constexpr RuleSet all_variants {.deck = joker_deck, .defend_alone = true, .farmers_hand = true};
+
+template <RuleSet Rules>
+using VariantEnv = BasicEnv<IBot, IBot, IBot, IBot, Rules>;
+
+struct VariantFixture {
+    ScriptedBot bot_a{"Bot_A"}, bot_b{"Bot_B"}, bot_c{"Bot_C"}, bot_d{"Bot_D"};
+    std::array<IBot*, 4> players = {&bot_a, &bot_b, &bot_c, &bot_d};
+
+    void script(const std::function<ActionId(const Observation, ActionMask)>& fn) {
+        for (auto* bot : {&bot_a, &bot_b, &bot_c, &bot_d}) {
+            bot->fn = fn;
+        }
+    }
+};
+
+/**
+ * @brief Every card of the deck is in exactly one place: a hand, the kitty, the face up card
+ * (until the dealer picks it up) or a finished trick.
+ */
+template <typename E>
+bool cards_partition(const E& e, uint32_t deck) {
+    const HandState& hs = e.state.hand_state;
+    uint32_t seen = hs.deck | hs.played;
+    int count = std::popcount(hs.deck) + std::popcount(hs.played);
+    for (const auto& hand : hs.hands) {
+        seen |= hand.value();
+        count += std::popcount(hand.value());
+    }
+    if (hs.face_up_card.v != euchre::constants::invalid_card && !(seen & (1u << hs.face_up_card))) {
+        seen |= 1u << hs.face_up_card;
+        count++;
+    }
+    // The dealer's discard after picking up leaves play for good.
+    return (seen & ~deck) == 0 && count == std::popcount(seen) && std::popcount(deck & ~seen) <= 1;
+}
+
+}
+
+TEST_CASE("Joker deck tables extend the standard ones", "[variants]") {
+    auto& standard = euchre::tables::tables();
+    auto& jt = euchre::tables::tables<joker_deck>();
+
+    REQUIRE(standard.deck == euchre::constants::deck_reset);
+    REQUIRE(jt.deck == (standard.deck | 1u << joker));
+
+    for (uint8_t tr = 0; tr < 4; tr++) {
+        for (uint8_t c = 0; c < euchre::constants::num_cards; c++) {
+            REQUIRE(jt.eff_suit_tbl[tr][c] == standard.eff_suit_tbl[tr][c]);
+            REQUIRE(jt.higher_tbl[tr][c] == (standard.higher_tbl[tr][c] |
+                                             (standard.eff_suit_tbl[tr][c] == Suit(tr) ? 1u << joker : 0u)));
+            for (uint8_t led = 0; led < 4; led++) {
+                REQUIRE(jt.power[tr][led][c] == standard.power[tr][led][c]);
+                REQUIRE(jt.power[tr][led][joker] > jt.power[tr][led][c]);
+            }
+        }
+        for (uint8_t s = 0; s < 4; s++) {
+            REQUIRE(jt.suit_mask_tbl[tr][s] == (standard.suit_mask_tbl[tr][s] | (s == tr ? 1u << joker : 0u)));
+        }
+        REQUIRE(jt.eff_suit_tbl[tr][joker] == Suit(tr));
+        REQUIRE(jt.higher_tbl[tr][joker] == 0);
+    }
+
+    // The power order keeps the Joker on top, so the bot helpers pick it like any other card.
+    uint32_t cards = (1u << joker) | (1u << Card{Suit::H, Rank::RJ}) | (1u << Card{Suit::C, Rank::R9});
+    REQUIRE(bot_utils::highest_card(cards, Suit::H, Suit::C).v == joker);
+    REQUIRE(bot_utils::lowest_card(cards, Suit::H, Suit::H).v == Card{Suit::C, Rank::R9}.v);
+    REQUIRE(bot_utils::cheapest_winner(cards, Suit::H, Suit::H, 200).v == joker);
+}
+
+TEST_CASE("Joker deck deals partition 25 cards", "[variants]") {
+    euchre::rng::Philox4x32 eng{7};
+    bool joker_face_up = false;
+    for (uint32_t g = 0; g < 500; g++) {
+        eng.seek(g);
+        Deal d = deal_cards(eng, joker_deck);
+        uint32_t all = d.kitty | (1u << d.face_up);
+        for (auto hand : d.hands) {
+            REQUIRE(std::popcount(hand) == 5);
+            REQUIRE((all & hand) == 0);
+            all |= hand;
+        }
+        REQUIRE(std::popcount(d.kitty) == 4);
+        REQUIRE(all == joker_deck.cards());
+        joker_face_up |= d.face_up.is_joker();
+    }
+    REQUIRE(joker_face_up);
+
+    // The standard deck is still the default.
+    eng.seek(3);
+    Deal standard = deal_cards(eng);
+    eng.seek(3);
+    Deal explicit_standard = deal_cards(eng, euchre::tables::standard_deck);
+    REQUIRE(standard.hands == explicit_standard.hands);
+    REQUIRE(standard.kitty == explicit_standard.kitty);
+    REQUIRE(std::popcount(standard.kitty) == 3);
+}
+
+TEST_CASE("Joker and variant actions", "[variants]") {
+    using namespace euchre::action;
+    Card jk{joker};
+
+    REQUIRE(play(jk) == PlayJoker);
+    REQUIRE(discard(jk) == DiscardJoker);
+    REQUIRE(is_play(PlayJoker));
+    REQUIRE(is_discard(DiscardJoker));
+    REQUIRE(!is_play(DiscardJoker));
+    REQUIRE(played_card(PlayJoker).v == joker);
+    REQUIRE(discarded_card(DiscardJoker).v == joker);
+    REQUIRE(decode_action(PlayJoker).kind == ActionKind::PlayCard);
+    REQUIRE(decode_action(DiscardJoker).card.v == joker);
+    REQUIRE(decode_action(DefendAloneYes).kind == ActionKind::DefendAlone);
+    REQUIRE(decode_action(DefendAloneNo).kind == ActionKind::DeclineDefendAlone);
+    REQUIRE(decode_action(FarmerSwapYes).kind == ActionKind::FarmerSwap);
+    REQUIRE(decode_action(FarmerSwapNo).kind == ActionKind::DeclineFarmerSwap);
+    REQUIRE(decode_action(InvalidAction).kind == ActionKind::InvalidAction);
+    REQUIRE(InvalidAction.v == num_actions);
+
+    // Standard cards keep their ids; the masks round trip.
+    uint32_t cards = (1u << joker) | 0x00F00Fu;
+    REQUIRE(play_mask(0x00F00Fu) == 0x00F00Fu);
+    REQUIRE(play_cards(play_mask(cards)) == cards);
+    REQUIRE((play_mask(cards) & a2m(PlayJoker)) != 0);
+    REQUIRE(discard_mask(cards) == ((ActionMask{0x00F00Fu} << DiscardCardBase.v) | a2m(DiscardJoker)));
+}
+
+TEST_CASE("Joker deck games follow suit with the Joker as trump", "[variants]") {
+    auto& jt = euchre::tables::tables<joker_deck>();
+    RandomBot a{"A"}, b{"B"}, c{"C"}, d{"D"};
+    bool joker_played = false;
+    bool joker_face_up_seen = false;
+
+    for (unsigned seed = 0; seed < 40; seed++) {
+        // The test picks uniformly random legal actions itself; the bots are never asked.
+        VariantEnv<joker_rules> env{seed, {&a, &b, &c, &d}};
+        euchre::rng::Philox4x32 eng{seed};
+        int steps = 0;
+        while (auto decision = env.next_decision()) {
+            const HandState& hs = env.state.hand_state;
+            REQUIRE(cards_partition(env, joker_deck.cards()));
+            if (hs.phase == Phase::BidRound2 && hs.face_up_card.is_joker()) {
+                joker_face_up_seen = true;
+                REQUIRE(hs.trump == Suit::None);
+            }
+            if (hs.phase == Phase::PlayTrick) {
+                uint32_t hand = hs.hands[decision->player].value();
+                uint32_t legal = euchre::action::play_cards(decision->mask);
+                REQUIRE((legal & ~hand) == 0);
+                if (hs.num_played > 0) {
+                    REQUIRE(legal == hs.hands[decision->player].get_valid_hand(hs.lead_card, hs.trump, jt));
+                    // Trump led: the Joker must follow.
+                    if (jt.eff_suit_tbl[hs.trump][hs.lead_card] == hs.trump && (hand & (1u << joker))) {
+                        REQUIRE((legal & (1u << joker)) != 0);
+                    }
+                }
+            }
+            uint32_t mask_bits = static_cast<uint32_t>(std::popcount(decision->mask));
+            ActionMask m = decision->mask;
+            for (uint32_t k = euchre::rng::bounded(eng, mask_bits); k > 0; k--) {
+                m &= m - 1;
+            }
+            auto action = ActionId{static_cast<uint16_t>(std::countr_zero(m))};
+            joker_played |= action == euchre::action::PlayJoker;
+            env.apply(action);
+            steps++;
+            REQUIRE(steps < 10000);
+        }
+        REQUIRE(env.state.status == GameState::GameStatus::GameOver);
+    }
+    REQUIRE(joker_played);
+    REQUIRE(joker_face_up_seen);
+
+    // Whoever plays the Joker takes the trick.
+    std::array<Card, 4> trick {Card{Suit::H, Rank::RJ}, Card{joker}, Card{Suit::D, Rank::RJ}, Card{Suit::H, Rank::RA}};
+    REQUIRE(euchre::rules::trick_winner(trick, Suit::H, trick[0], 0, jt) == 1);
+    REQUIRE(euchre::rules::trick_winner(trick, Suit::H, trick[0], false, 0) == 1);
+}
+
+TEST_CASE_METHOD(VariantFixture, "A turned up Joker opens every suit in round 2", "[variants]") {
+    script(test_bots::call_trump_then_default);
+    unsigned seed = 0;
+    for (;; seed++) {
+        VariantEnv<joker_rules> probe{seed, players};
+        probe.step_hand();
+        if (probe.state.hand_state.face_up_card.is_joker()) {
+            break;
+        }
+    }
+
+    VariantEnv<joker_rules> env{seed, players};
+    env.step_hand(); // Deal
+    REQUIRE(env.state.hand_state.phase == Phase::BidRound2);
+    ActionMask calls = env.legal_actions() & ~euchre::action::a2m(euchre::action::Pass);
+    REQUIRE(std::popcount(calls) == 4);
+
+    env.step_hand(); // BidRound2 - the first seat calls clubs
+    REQUIRE(env.state.hand_state.trump == Suit::C);
+    env.step_hand(); // GoAloneDecision
+    REQUIRE(env.state.hand_state.phase == Phase::DealerPickupDiscard);
+    REQUIRE(env.state.hand_state.hands[env.state.dealer].hand_has(Card{joker}));
+    REQUIRE((env.legal_actions() & euchre::action::a2m(euchre::action::DiscardJoker)) != 0);
+}
+
+TEST_CASE_METHOD(VariantFixture, "Defending alone", "[variants]") {
+    bool asked_partner = false;
+    script([&asked_partner](const Observation& obs, ActionMask action_mask) -> ActionId {
+        switch (obs.phase) {
+            case Phase::BidRound1:
+                return euchre::action::OrderUp;
+            case Phase::GoAloneDecision:
+                return euchre::action::GoAloneYes;
+            case Phase::DefendAloneDecision:
+                // The first defender declines, so the second is asked.
+                if (obs.player == (obs.maker_player + 1) % 4) {
+                    return euchre::action::DefendAloneNo;
+                }
+                asked_partner = true;
+                return euchre::action::DefendAloneYes;
+            default:
+                return test_bots::first_legal(obs, action_mask);
+        }
+    });
+
+    VariantEnv<defend_rules> env{0x1234, players};
+    env.step_hand(); // Deal
+    env.step_hand(); // BidRound1 - first seat orders up
+    uint8_t maker = env.state.hand_state.maker_player;
+    env.step_hand(); // GoAloneDecision
+    REQUIRE(env.state.hand_state.phase == Phase::DefendAloneDecision);
+    REQUIRE(env.state.hand_state.current_player == (maker + 1) % 4);
+    env.step_hand(); // DefendAloneDecision
+    REQUIRE(asked_partner);
+    REQUIRE(env.state.hand_state.defending_alone);
+    REQUIRE(env.state.hand_state.defender_player == (maker + 3) % 4);
+    env.step_hand(); // DealerPickupDiscard
+    REQUIRE(env.state.hand_state.phase == Phase::PlayTrick);
+
+    // Only the lone maker and the lone defender play.
+    std::array<int, 4> plays {};
+    while (env.state.hand_state.phase == Phase::PlayTrick) {
+        plays[env.state.hand_state.current_player]++;
+        env.apply_action(env.request_action(env.state.hand_state.current_player, env.legal_actions()));
+    }
+    REQUIRE(plays[maker] == 5);
+    REQUIRE(plays[(maker + 3u) % 4u] == 5);
+    REQUIRE(plays[(maker + 1u) % 4u] == 0);
+    REQUIRE(plays[(maker + 2u) % 4u] == 0);
+
+    // A lone defender's euchre scores lone_defense_points; a plain euchre still scores 2.
+    VariantEnv<defend_rules> scoring{0x1234, players};
+    scoring.state.hand_state.maker_team = 0;
+    scoring.state.hand_state.tricks_won[0] = 2;
+    scoring.state.hand_state.going_alone = true;
+    scoring.state.hand_state.defending_alone = true;
+    scoring.state.hand_state.phase = Phase::HandOver;
+    scoring.hand_over();
+    REQUIRE(scoring.state.scores[1] == 3);
+
+    scoring.state.hand_state.tricks_won[0] = 2;
+    scoring.state.hand_state.going_alone = true;
+    scoring.hand_over();
+    REQUIRE(scoring.state.scores[1] == 5);
+
+    // Without the rule the flag is ignored.
+    Env standard{0x1234, players};
+    standard.state.hand_state.maker_team = 0;
+    standard.state.hand_state.tricks_won[0] = 2;
+    standard.state.hand_state.going_alone = true;
+    standard.state.hand_state.defending_alone = true;
+    standard.hand_over();
+    REQUIRE(standard.state.scores[1] == 2);
+}
+
+TEST_CASE_METHOD(VariantFixture, "Farmer's hand swaps with the kitty", "[variants]") {
+    script(test_bots::order_up_no_alone);
+    unsigned seed = 0;
+    uint8_t farmer = 0;
+    for (;; seed++) {
+        VariantEnv<farmer_rules> probe{seed, players};
+        probe.step_hand();
+        if (probe.state.hand_state.phase == Phase::FarmerSwap) {
+            farmer = probe.state.hand_state.current_player;
+            break;
+        }
+        REQUIRE(seed < 100000);
+    }
+
+    VariantEnv<farmer_rules> env{seed, players};
+    Env standard{seed, players};
+    env.step_hand();
+    standard.step_hand();
+    REQUIRE(euchre::rules::is_farmers_hand(env.state.hand_state.hands[farmer].value()));
+    uint32_t kitty = env.state.hand_state.deck;
+    uint32_t hand = env.state.hand_state.hands[farmer].value();
+
+    // Swap, and discard the first legal cards.
+    env.apply(euchre::action::FarmerSwapYes);
+    REQUIRE(env.state.hand_state.phase == Phase::FarmerDiscard);
+    REQUIRE(env.state.hand_state.hands[farmer].value() == (hand | kitty));
+    while (env.state.hand_state.phase == Phase::FarmerDiscard) {
+        REQUIRE(env.state.hand_state.current_player == farmer);
+        env.apply(test_bots::first_legal(Observation{}, env.legal_actions()));
+    }
+    REQUIRE(env.state.hand_state.phase == Phase::BidRound1);
+    REQUIRE(env.state.hand_state.current_player == (env.state.dealer + 1) % 4);
+    REQUIRE(env.state.hand_state.hands[farmer].num_cards() == 5);
+    REQUIRE(std::popcount(env.state.hand_state.deck) == 3);
+    REQUIRE((env.state.hand_state.hands[farmer].value() | env.state.hand_state.deck) == (hand | kitty));
+    REQUIRE(env.state.hand_state.face_up_card.v == standard.state.hand_state.face_up_card.v);
+
+    // Declining leaves the deal as it was.
+    VariantEnv<farmer_rules> declined{seed, players};
+    declined.step_hand();
+    declined.apply(euchre::action::FarmerSwapNo);
+    REQUIRE(declined.state.hand_state.phase == Phase::BidRound1);
+    for (uint8_t p = 0; p < 4; p++) {
+        REQUIRE(declined.state.hand_state.hands[p].value() == standard.state.hand_state.hands[p].value());
+    }
+}
+
+TEST_CASE_METHOD(VariantFixture, "Variant games finish and snapshot mid game", "[variants]") {
+    script([](const Observation& obs, ActionMask action_mask) -> ActionId {
+        switch (obs.phase) {
+            case Phase::BidRound1:
+                return euchre::action::OrderUp;
+            case Phase::GoAloneDecision:
+                return (obs.player % 2) ? euchre::action::GoAloneYes : euchre::action::GoAloneNo;
+            case Phase::DefendAloneDecision:
+                return euchre::action::DefendAloneYes;
+            case Phase::FarmerSwap:
+                return euchre::action::FarmerSwapYes;
+            default:
+                return test_bots::first_legal(obs, action_mask);
+        }
+    });
+
+    for (unsigned seed = 0; seed < 20; seed++) {
+        VariantEnv<all_variants> env{seed, players};
+        int steps = 0;
+        while (env.state.status != GameState::GameStatus::GameOver && steps < 10000) {
+            env.step_game();
+            steps++;
+            if (steps == 7) {
+                GameSnapshot snap = env.snapshot();
+                VariantEnv<all_variants> copy{0, players};
+                copy.restore(snap);
+                REQUIRE(copy.snapshot() == snap);
+                REQUIRE(copy.state.hand_state.defending_alone == env.state.hand_state.defending_alone);
+                REQUIRE(copy.state.hand_state.defender_player == env.state.hand_state.defender_player);
+                for (uint8_t p = 0; p < 4; p++) {
+                    REQUIRE(copy.state.hand_state.hands[p].value() == env.state.hand_state.hands[p].value());
+                }
+                REQUIRE(copy.state.hand_state.deck == env.state.hand_state.deck);
+            }
+        }
+        REQUIRE(env.state.status == GameState::GameStatus::GameOver);
+    }
+}
+
+TEST_CASE("Search bots refuse variant tables", "[variants]") {
+    IsmctsBot ismcts{"I", 50};
+    PimcBot pimc{"P", 4};
+    ismcts.on_new_match(1);
+    pimc.on_new_match(1);
+
+    // Last trick holding only the Joker: the standard-deck search has no move for it.
+    Observation obs;
+    obs.phase = Phase::PlayTrick;
+    obs.player = 0;
+    obs.dealer = 3;
+    obs.trump = Suit::H;
+    obs.tricks_won = {2, 2};
+    obs.hand.give_card(Card{joker});
+    ActionMask mask = euchre::action::a2m(euchre::action::PlayJoker);
+    REQUIRE_THROWS_AS(ismcts.select_action(obs, mask), std::logic_error);
+    REQUIRE_THROWS_AS(pimc.select_action(obs, mask), std::logic_error);
+
+    // A lone defender is a variant even without the Joker.
+    Observation lone = obs;
+    lone.hand = Hand{};
+    lone.hand.give_card(Card{Suit::H, Rank::R9});
+    lone.defending_alone = true;
+    mask = euchre::action::a2m(euchre::action::play(Card{Suit::H, Rank::R9}));
+    REQUIRE_THROWS_AS(ismcts.select_action(lone, mask), std::logic_error);
+    REQUIRE_THROWS_AS(pimc.select_action(lone, mask), std::logic_error);
+}
@@ -0,0 +1,126 @@
+#include "Deck.hpp"
+#include "Hand.hpp"
+#include "Rules.hpp"
+#include "TrickKernels.hpp"
+#include <array>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace {
+
+struct Batch {
+    std::vector<Card> cards;
+    std::vector<Suit> trump;
+    std::vector<Card> lead;
+    std::vector<uint8_t> sitting_out;
+    std::vector<uint32_t> hands;
+    std::vector<uint8_t> winners;
+    std::vector<uint32_t> masks;
+};
+
+/**
+ * @brief Random finished tricks and the hand of the seat after the leader, a third of them alone.
+ */
+Batch make_batch(std::size_t n) {
+    euchre::rng::Philox4x32 eng(1);
+    Batch b;
+    b.cards.resize(n * 4);
+    b.trump.resize(n);
+    b.lead.resize(n);
+    b.sitting_out.resize(n);
+    b.hands.resize(n);
+    b.winners.resize(n);
+    b.masks.resize(n);
+    for (std::size_t g = 0; g < n; g++) {
+        Deal deal = deal_cards(eng);
+        for (std::size_t p = 0; p < 4; p++) {
+            b.cards[g * 4 + p] = Card{pick_random_bit(deal.hands[p], eng)};
+        }
+        b.trump[g] = Suit(euchre::rng::bounded(eng, 4));
+        b.sitting_out[g] = g % 3 == 0 ? uint8_t{2} : euchre::constants::num_players;
+        b.lead[g] = b.cards[g * 4];
+        b.hands[g] = deal.hands[1];
+    }
+    return b;
+}
+
+template <typename F>
+double games_per_second(std::size_t games, int reps, F&& run) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < reps; r++) {
+        run();
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<double>(games) * reps / elapsed.count();
+}
+
+void report(const std::string& name, double rate) {
+    std::cout << "  " << name << ": " << rate / 1e6 << " M games/s\n";
+}
+
+}
+
+// Usage: bench_kernels [games per batch] [repetitions]
+// Times one trick winner and one follow mask per game: the scalar rules one game at a time, then
+// the batched kernels.
+int main(int argc, char** argv) {
+    std::size_t n = argc > 1 ? std::strtoul(argv[1], nullptr, 10) : 32;
+    int reps = argc > 2 ? std::atoi(argv[2]) : 200000;
+    if (n == 0 || reps <= 0) {
+        std::cerr << "usage: " << argv[0] << " [games per batch] [repetitions]\n";
+        return 1;
+    }
+    Batch b = make_batch(n);
+    std::cout << n << " games per batch, " << reps << " batches"
+              << (euchre::kernels::cpu_has_avx2() ? ", AVX2 available" : ", no AVX2") << "\n";
+
+    uint64_t checksum = 0;
+    auto scalar_winners = [&] {
+        for (std::size_t g = 0; g < n; g++) {
+            std::array<Card, 4> trick {b.cards[g * 4], b.cards[g * 4 + 1], b.cards[g * 4 + 2], b.cards[g * 4 + 3]};
+            bool alone = b.sitting_out[g] < euchre::constants::num_players;
+            b.winners[g] = euchre::rules::trick_winner(trick, b.trump[g], b.lead[g], alone, 0);
+        }
+        checksum += b.winners[0];
+    };
+    auto scalar_masks = [&] {
+        for (std::size_t g = 0; g < n; g++) {
+            b.masks[g] = Hand{b.hands[g]}.get_valid_hand(b.lead[g], b.trump[g]);
+        }
+        checksum += b.masks[0];
+    };
+    auto kernel_winners = [&](auto kernel) {
+        return [&, kernel] {
+            kernel(b.cards, b.trump, b.lead, b.sitting_out, b.winners);
+            checksum += b.winners[0];
+        };
+    };
+    auto kernel_masks = [&](auto kernel) {
+        return [&, kernel] {
+            kernel(b.hands, b.trump, b.lead, b.masks);
+            checksum += b.masks[0];
+        };
+    };
+
+    std::cout << "trick winners\n";
+    report("scalar rules", games_per_second(n, reps, scalar_winners));
+    report("portable", games_per_second(n, reps, kernel_winners(euchre::kernels::trick_winners_portable)));
+#if defined(EUCHRE_HAS_AVX2_KERNELS)
+    if (euchre::kernels::cpu_has_avx2()) {
+        report("avx2", games_per_second(n, reps, kernel_winners(euchre::kernels::trick_winners_avx2)));
+    }
+#endif
+    std::cout << "follow masks\n";
+    report("scalar rules", games_per_second(n, reps, scalar_masks));
+    report("portable", games_per_second(n, reps, kernel_masks(euchre::kernels::follow_masks_portable)));
+#if defined(EUCHRE_HAS_AVX2_KERNELS)
+    if (euchre::kernels::cpu_has_avx2()) {
+        report("avx2", games_per_second(n, reps, kernel_masks(euchre::kernels::follow_masks_avx2)));
+    }
+#endif
+    std::cout << "(checksum " << checksum << ")\n";
+    return 0;
+}
@@ -0,0 +1,73 @@
+#include "EquityTable.hpp"
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <charconv>
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+// A whole decimal argument in [min, UINT32_MAX]; anything else is a usage error.
+bool parse_arg(const char* arg, uint32_t min, uint32_t& out) {
+    std::string text = arg;
+    uint32_t value = 0;
+    auto [end, ec] = std::from_chars(text.data(), text.data() + text.size(), value);
+    if (ec != std::errc{} || end != text.data() + text.size() || value < min) {
+        return false;
+    }
+    out = value;
+    return true;
+}
+
+}
+
+// Usage: make_equity <output path> [rollouts] [shard] [num_shards] [seed]
+//        make_equity --merge <output path> <shard file>...
+// Rerunning with the same arguments resumes an interrupted run.
+int main(int argc, char** argv) {
+    auto usage = [&] {
+        std::cerr << "usage: " << argv[0] << " <output> [rollouts] [shard] [num_shards] [seed]\n"
+                  << "       " << argv[0] << " --merge <output> <shard>...\n";
+        return 1;
+    };
+    if (argc < 2 || (std::string(argv[1]) == "--merge" && argc < 4)) {
+        return usage();
+    }
+
+    auto start = std::chrono::steady_clock::now();
+    try {
+        if (std::string(argv[1]) == "--merge") {
+            std::vector<std::string> inputs(argv + 3, argv + argc);
+            EquityTable::merge(inputs, argv[2]);
+            EquityTable merged{argv[2]};
+            std::cout << "Merged " << inputs.size() << " files into " << argv[2] << " (" << merged.chunks_done()
+                      << "/" << EquityTable::num_chunks << " chunks)\n";
+            return 0;
+        }
+
+        std::string path = argv[1];
+        EquityConfig config;
+        if ((argc > 2 && !parse_arg(argv[2], 1, config.rollouts)) || (argc > 3 && !parse_arg(argv[3], 0, config.shard)) ||
+            (argc > 4 && !parse_arg(argv[4], 1, config.num_shards)) || (argc > 5 && !parse_arg(argv[5], 0, config.seed)) ||
+            config.shard >= config.num_shards) {
+            std::cerr << "rollouts and num_shards must be positive, shard below num_shards and seed a 32 bit number\n";
+            return usage();
+        }
+
+        WorkerPool pool{std::max(1u, std::thread::hardware_concurrency())};
+        std::size_t computed = EquityTable::generate(path, config, &pool);
+        std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+        EquityTable table{path};
+        std::cout << "Computed " << computed << " chunks of shard " << config.shard << "/" << config.num_shards
+                  << " in " << elapsed.count() << "s; " << path << " has " << table.chunks_done() << "/"
+                  << EquityTable::num_chunks << " chunks\n";
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,41 @@
+#include "Tablebase.hpp"
+#include "WorkerPool.hpp"
+#include <algorithm>
+#include <chrono>
+#include <charconv>
+#include <iostream>
+#include <string>
+#include <thread>
+
+// Usage: make_tablebase <output path> [max cards per hand, 2 or 3]
+int main(int argc, char** argv) {
+    if (argc < 2) {
+        std::cerr << "usage: " << argv[0] << " <output> [max_cards]\n";
+        return 1;
+    }
+    std::string path = argv[1];
+    int max_cards = Tablebase::max_supported_cards;
+    if (argc > 2) {
+        std::string arg = argv[2];
+        auto [end, ec] = std::from_chars(arg.data(), arg.data() + arg.size(), max_cards);
+        if (ec != std::errc{} || end != arg.data() + arg.size() || max_cards < Tablebase::min_cards ||
+            max_cards > Tablebase::max_supported_cards) {
+            std::cerr << "max_cards must be between " << int{Tablebase::min_cards} << " and "
+                      << int{Tablebase::max_supported_cards} << ", got " << arg << "\n";
+            return 1;
+        }
+    }
+
+    WorkerPool pool{std::max(1u, std::thread::hardware_concurrency())};
+    auto start = std::chrono::steady_clock::now();
+    try {
+        Tablebase::generate(path, static_cast<uint8_t>(max_cards), &pool);
+    }
+    catch (const std::exception& e) {
+        std::cerr << e.what() << "\n";
+        return 1;
+    }
+    std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - start;
+    std::cout << "Wrote " << path << " (up to " << max_cards << " cards) in " << elapsed.count() << "s\n";
+    return 0;
+}